@@ -5458,6 +5458,10 @@ struct ServerLootItem_Struct {
 	uint16 trivial_max_level;
 	uint16 npc_min_level;
 	uint16 npc_max_level;
+
+	// one per loot table entry on every spawn, pooled in loottables.cpp so repops do not hit malloc per item
+	static void* operator new(size_t size);
+	static void operator delete(void* ptr, size_t size);
 };
 
 //Found in client near a ref to the string:
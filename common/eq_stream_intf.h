@@ -23,10 +23,12 @@ struct EQStreamManagerInterfaceOptions
 {
 	EQStreamManagerInterfaceOptions() {
 		opcode_size = 2;
+		io_thread = false;
 	}
 
 	EQStreamManagerInterfaceOptions(int port, bool encoded, bool compressed) {
 		opcode_size = 2;
+		io_thread = false;
 
 		//World seems to support both compression and xor zone supports one or the others.
 		//Enforce one or the other in the convienence construct
@@ -44,6 +46,8 @@ struct EQStreamManagerInterfaceOptions
 
 	int opcode_size;
 	bool track_opcode_stats;
+	//run the daybreak protocol on a thread of its own instead of the creating thread's loop
+	bool io_thread;
 	EQ::Net::DaybreakConnectionManagerOptions daybreak_options;
 };
 
@@ -4,6 +4,46 @@
 #include "struct_strategy.h"
 #include "eqemu_logsys.h"
 #include "opcodemgr.h"
+#include "event/task_scheduler.h"
+#include <algorithm>
+#include <future>
+
+bool EQStreamProxy::s_defer_encode = false;
+std::vector<EQStreamProxy*> EQStreamProxy::s_deferred_streams;
+
+//stands in for the real stream while the struct strategy runs on a worker, the encoded packets are
+//kept in the order they were written and everything else is answered by the real stream
+class EQStreamProxy::EncodedCollector : public EQStreamInterface {
+public:
+	EncodedCollector(std::shared_ptr<EQStreamInterface> stream) : m_stream(stream) { }
+
+	virtual void QueuePacket(const EQApplicationPacket *p, bool ack_req = true) { packets.push_back(QueuedPacket{ p->Copy(), ack_req }); }
+	virtual void FastQueuePacket(EQApplicationPacket **p, bool ack_req = true) {
+		if (p == nullptr || *p == nullptr)
+			return;
+		packets.push_back(QueuedPacket{ *p, ack_req });
+		*p = nullptr;
+	}
+	virtual EQApplicationPacket *PopPacket() { return nullptr; }
+	virtual void Close() { }
+	virtual void ReleaseFromUse() { }
+	virtual void RemoveData() { }
+	virtual std::string GetRemoteAddr() const { return m_stream->GetRemoteAddr(); }
+	virtual uint32 GetRemoteIP() const { return m_stream->GetRemoteIP(); }
+	virtual uint16 GetRemotePort() const { return m_stream->GetRemotePort(); }
+	virtual bool CheckState(EQStreamState state) { return m_stream->CheckState(state); }
+	virtual std::string Describe() const { return m_stream->Describe(); }
+	virtual EQStreamState GetState() { return m_stream->GetState(); }
+	virtual void SetOpcodeManager(OpcodeManager **opm) { }
+	virtual Stats GetStats() const { return m_stream->GetStats(); }
+	virtual void ResetStats() { }
+	virtual EQStreamManagerInterface* GetManager() const { return m_stream->GetManager(); }
+
+	std::vector<QueuedPacket> packets;
+
+private:
+	std::shared_ptr<EQStreamInterface> m_stream;
+};
 
 
 EQStreamProxy::EQStreamProxy(std::shared_ptr<EQStreamInterface> &stream, const StructStrategy *structs, OpcodeManager **opcodes)
@@ -16,6 +56,8 @@ EQStreamProxy::EQStreamProxy(std::shared_ptr<EQStreamInterface> &stream, const S
 }
 
 EQStreamProxy::~EQStreamProxy() {
+	FlushDeferred();
+	s_deferred_streams.erase(std::remove(s_deferred_streams.begin(), s_deferred_streams.end(), this), s_deferred_streams.end());
 }
 
 std::string EQStreamProxy::Describe() const {
@@ -53,6 +95,19 @@ void EQStreamProxy::QueuePacket(const EQApplicationPacket *p, bool ack_req) {
 void EQStreamProxy::FastQueuePacket(EQApplicationPacket **p, bool ack_req) {
 	if(p == nullptr || *p == nullptr)
 		return;
+
+	//item packets point at the live item instances, which may be gone by the end of the tick
+	if (s_defer_encode && !m_structs->EncodesItems((*p)->GetOpcode())) {
+		if (m_deferred.empty()) {
+			s_deferred_streams.push_back(this);
+		}
+
+		m_deferred.push_back(QueuedPacket{ *p, ack_req });
+		*p = nullptr;
+		return;
+	}
+
+	FlushDeferred();
 	m_structs->Encode(p, m_stream, ack_req);
 }
 
@@ -67,6 +122,7 @@ EQApplicationPacket *EQStreamProxy::PopPacket() {
 }
 
 void EQStreamProxy::Close() {
+	FlushDeferred();
 	m_stream->Close();
 }
 
@@ -112,3 +168,82 @@ bool EQStreamProxy::CheckState(EQStreamState state) {
 	return false;
 }
 
+void EQStreamProxy::EncodeDeferred() {
+	if (!m_collector) {
+		m_collector = std::make_shared<EncodedCollector>(m_stream);
+	}
+
+	for (auto &q : m_deferred) {
+		m_structs->Encode(&q.packet, m_collector, q.ack_req);
+	}
+
+	m_deferred.clear();
+}
+
+void EQStreamProxy::SendEncoded() {
+	if (!m_collector) {
+		return;
+	}
+
+	for (auto &q : m_collector->packets) {
+		m_stream->FastQueuePacket(&q.packet, q.ack_req);
+	}
+
+	m_collector->packets.clear();
+}
+
+void EQStreamProxy::FlushDeferred() {
+	if (m_deferred.empty()) {
+		return;
+	}
+
+	EncodeDeferred();
+	SendEncoded();
+}
+
+void EQStreamProxy::BeginDeferredEncode() {
+	s_defer_encode = true;
+}
+
+void EQStreamProxy::EndDeferredEncode(EQ::Event::TaskScheduler &pool) {
+	s_defer_encode = false;
+
+	//a stream flushed early for an item packet can be listed more than once
+	std::vector<EQStreamProxy*> streams;
+	streams.swap(s_deferred_streams);
+	std::sort(streams.begin(), streams.end());
+	streams.erase(std::unique(streams.begin(), streams.end()), streams.end());
+	streams.erase(std::remove_if(streams.begin(), streams.end(), [](EQStreamProxy *s) { return s->m_deferred.empty(); }), streams.end());
+
+	//encoders log from the workers, LogSys serializes that output and keeps gmsay hooks on this thread
+	if (streams.size() > 1) {
+		size_t tasks = std::min(streams.size(), pool.GetThreadCount() * 2);
+		std::vector<std::future<void>> done;
+		done.reserve(tasks);
+		for (size_t t = 0; t < tasks; ++t) {
+			done.push_back(pool.Enqueue([&streams, t, tasks]() {
+				for (size_t i = t; i < streams.size(); i += tasks) {
+					streams[i]->EncodeDeferred();
+				}
+			}));
+		}
+
+		//every task has to be finished with streams before a failure is rethrown
+		for (auto &d : done) {
+			d.wait();
+		}
+
+		for (auto &d : done) {
+			d.get();
+		}
+	}
+	else {
+		for (auto s : streams) {
+			s->EncodeDeferred();
+		}
+	}
+
+	for (auto s : streams) {
+		s->SendEncoded();
+	}
+}
@@ -5,11 +5,20 @@
 #include "types.h"
 #include "eq_stream_intf.h"
 #include <memory>
+#include <vector>
 
 class StructStrategy;
 class OpcodeManager;
 class EQApplicationPacket;
 
+namespace EQ
+{
+	namespace Event
+	{
+		class TaskScheduler;
+	}
+}
+
 class EQStreamProxy : public EQStreamInterface {
 public:
 	//takes ownership of the stream.
@@ -35,12 +44,36 @@ public:
 	virtual void ResetStats();
 	virtual EQStreamManagerInterface* GetManager() const;
 
+	//between these two calls packets are only copied when queued, EndDeferredEncode then runs the
+	//struct strategy of every stream with packets waiting on the pool, each stream's packets in the
+	//order they were queued, and hands the results to the streams. Both are for the main thread only.
+	static void BeginDeferredEncode();
+	static void EndDeferredEncode(EQ::Event::TaskScheduler &pool);
+
 protected:
 	std::shared_ptr<EQStreamInterface> const m_stream;	//we own this stream object.
 	const StructStrategy *const	m_structs;	//we do not own this object.
 	//this is a pointer to a pointer to make it less likely that a packet will
 	//reference an invalid opcode manager when they are being reloaded.
 	OpcodeManager **const			m_opcodes;	//we do not own this object.
+
+	struct QueuedPacket
+	{
+		EQApplicationPacket *packet;
+		bool ack_req;
+	};
+
+	class EncodedCollector;
+
+	std::vector<QueuedPacket> m_deferred;	//waiting to be encoded
+	std::shared_ptr<EncodedCollector> m_collector;	//what the struct strategy wrote for them
+
+	void EncodeDeferred();
+	void SendEncoded();
+	void FlushDeferred();
+
+	static bool s_defer_encode;
+	static std::vector<EQStreamProxy*> s_deferred_streams;
 };
 
 #endif /*EQSTREAMPROXY_H_*/
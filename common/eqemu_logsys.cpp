@@ -89,6 +89,7 @@ EQEmuLogSys::EQEmuLogSys()
 {
 	on_log_gmsay_hook   = [](uint16 log_type, const std::string &) {};
 	on_log_console_hook = [](uint16 debug_level, uint16 log_type, const std::string &) {};
+	hook_thread_id      = std::this_thread::get_id();
 }
 
 /**
@@ -236,7 +237,7 @@ void EQEmuLogSys::ProcessGMSay(
 	/**
 	 * Check to see if the process that actually ran this is zone
 	 */
-	if (EQEmuLogSys::log_platform == EQEmuExePlatform::ExePlatformZone) {
+	if (EQEmuLogSys::log_platform == EQEmuExePlatform::ExePlatformZone && std::this_thread::get_id() == hook_thread_id) {
 		on_log_gmsay_hook(log_category, message);
 	}
 }
@@ -252,6 +253,8 @@ void EQEmuLogSys::ProcessLogWrite(
 	const std::string &message
 )
 {
+	std::lock_guard<std::mutex> lock(output_lock);
+
 	if (log_category == Logs::Crash) {
 		char time_stamp[80];
 		EQEmuLogSys::SetCurrentTimeStamp(time_stamp);
@@ -366,23 +369,29 @@ uint16 EQEmuLogSys::GetGMSayColorFromCategory(uint16 log_category)
  */
 void EQEmuLogSys::ProcessConsoleMessage(uint16 debug_level, uint16 log_category, const std::string &message)
 {
+	{
+		std::lock_guard<std::mutex> lock(output_lock);
+
 #ifdef _WINDOWS
-	HANDLE  console_handle;
-	console_handle = GetStdHandle(STD_OUTPUT_HANDLE);
-	CONSOLE_FONT_INFOEX info = { 0 };
-	info.cbSize = sizeof(info);
-	info.dwFontSize.Y = 12; // leave X as zero
-	info.FontWeight = FW_NORMAL;
-	wcscpy(info.FaceName, L"Lucida Console");
-	SetCurrentConsoleFontEx(console_handle, NULL, &info);
-	SetConsoleTextAttribute(console_handle, EQEmuLogSys::GetWindowsConsoleColorFromCategory(log_category));
-	std::cout << message << "\n";
-	SetConsoleTextAttribute(console_handle, Console::Color::White);
+		HANDLE  console_handle;
+		console_handle = GetStdHandle(STD_OUTPUT_HANDLE);
+		CONSOLE_FONT_INFOEX info = { 0 };
+		info.cbSize = sizeof(info);
+		info.dwFontSize.Y = 12; // leave X as zero
+		info.FontWeight = FW_NORMAL;
+		wcscpy(info.FaceName, L"Lucida Console");
+		SetCurrentConsoleFontEx(console_handle, NULL, &info);
+		SetConsoleTextAttribute(console_handle, EQEmuLogSys::GetWindowsConsoleColorFromCategory(log_category));
+		std::cout << message << "\n";
+		SetConsoleTextAttribute(console_handle, Console::Color::White);
 #else
-	std::cout << EQEmuLogSys::GetLinuxConsoleColorFromCategory(log_category) << message << LC_RESET << std::endl;
+		std::cout << EQEmuLogSys::GetLinuxConsoleColorFromCategory(log_category) << message << LC_RESET << std::endl;
 #endif
+	}
 
-	on_log_console_hook(debug_level, log_category, message);
+	if (std::this_thread::get_id() == hook_thread_id) {
+		on_log_console_hook(debug_level, log_category, message);
+	}
 }
 
 /**
@@ -25,6 +25,8 @@
 #include <fstream>
 #include <stdio.h>
 #include <functional>
+#include <mutex>
+#include <thread>
 
 #ifdef _WIN32
 #ifdef utf16_to_utf8
@@ -298,12 +300,20 @@ public:
 	/**
 	 * @param f
 	 */
-	void SetGMSayHandler(std::function<void(uint16 log_type, const std::string&)> f) { on_log_gmsay_hook = f; }
+	void SetGMSayHandler(std::function<void(uint16 log_type, const std::string&)> f)
+	{
+		on_log_gmsay_hook = f;
+		hook_thread_id    = std::this_thread::get_id();
+	}
 
 	/**
 	 * @param f
 	 */
-	void SetConsoleHandler(std::function<void(uint16 debug_level, uint16 log_type, const std::string&)> f) { on_log_console_hook = f; }
+	void SetConsoleHandler(std::function<void(uint16 debug_level, uint16 log_type, const std::string&)> f)
+	{
+		on_log_console_hook = f;
+		hook_thread_id      = std::this_thread::get_id();
+	}
 
 	/**
 	 * Silence console logging
@@ -323,6 +333,17 @@ private:
 	std::function<void(uint16 log_category, const std::string&)> on_log_gmsay_hook;
 	std::function<void(uint16 debug_level, uint16 log_category, const std::string&)> on_log_console_hook;
 
+	/**
+	 * Hooks reach into process state (entity list, websocket server) and only run on the thread that set them,
+	 * lines logged from worker threads go to console and file only
+	 */
+	std::thread::id hook_thread_id;
+
+	/**
+	 * Serializes console and file output, zones log from async asset loads and packet encode workers
+	 */
+	std::mutex output_lock;
+
 	/**
 	 * Formats log messages like '[Category] This is a log message'
 	 */
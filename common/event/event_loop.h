@@ -1,24 +1,38 @@
 #pragma once
+#include <atomic>
+#include <deque>
 #include <functional>
+#include <mutex>
 #include <uv.h>
 #include <cstring>
+#include "inbox.h"
+#include "inline_function.h"
 
 namespace EQ
 {
 	class EventLoop
 	{
 	public:
+		static const size_t InboxCapacity = 4096;
+		static const size_t PostCaptureSize = 64;
+
+		typedef Event::InlineFunction<PostCaptureSize> PostedFn;
+
 		static EventLoop &Get() {
 			static thread_local EventLoop inst;
 			return inst;
 		}
 
 		~EventLoop() {
+			uv_close((uv_handle_t*)&m_inbox_async, nullptr);
+			uv_run(&m_loop, UV_RUN_NOWAIT);
 			uv_loop_close(&m_loop);
 		}
 
 		void Process() {
 			uv_run(&m_loop, UV_RUN_NOWAIT);
+			//uv_run returns straight away when nothing but the unref'd inbox handle is alive
+			ProcessInbox();
 		}
 
 		void Run() {
@@ -29,17 +43,79 @@ namespace EQ
 			uv_stop(&m_loop);
 		}
 
+		/**
+		 * Queues fn to run on the thread that owns this loop, safe to call from any thread
+		 *
+		 * Hold on to the loop from EventLoop::Get() on the owning thread and post to it from
+		 * workers to hand their results back. fn is moved into the inbox slot itself, its captures
+		 * have to fit in PostCaptureSize bytes (checked at compile time), so a post only allocates
+		 * if the inbox is full. Never blocks, work that does not fit the inbox goes on an overflow
+		 * list that later posts queue behind until the owning thread catches up.
+		 */
+		template<typename Fn>
+		void Post(Fn &&fn) {
+			PostFn(PostedFn(std::forward<Fn>(fn)));
+		}
+
 		uv_loop_t* Handle() { return &m_loop; }
 
 	private:
+		void PostFn(PostedFn &&fn) {
+			//TryPush leaves fn alone when the inbox is full
+			if (m_overflowed.load(std::memory_order_acquire) || !m_inbox.TryPush(std::move(fn))) {
+				std::lock_guard<std::mutex> lock(m_overflow_lock);
+				m_overflow.push_back(std::move(fn));
+				m_overflowed.store(true, std::memory_order_release);
+			}
+
+			uv_async_send(&m_inbox_async);
+		}
+
 		EventLoop() {
 			memset(&m_loop, 0, sizeof(uv_loop_t));
 			uv_loop_init(&m_loop);
+
+			memset(&m_inbox_async, 0, sizeof(uv_async_t));
+			uv_async_init(&m_loop, &m_inbox_async, [](uv_async_t *handle) {
+				static_cast<EventLoop*>(handle->data)->ProcessInbox();
+			});
+			m_inbox_async.data = this;
+			//posted work should not keep Run() alive on its own
+			uv_unref((uv_handle_t*)&m_inbox_async);
 		}
 		
 		EventLoop(const EventLoop&);
 		EventLoop& operator=(const EventLoop&);
+
+		void ProcessInbox() {
+			PostedFn fn;
+			while (m_inbox.TryPop(fn)) {
+				fn();
+			}
+
+			//overflow was posted after everything in the inbox, a push still finishing there
+			//wakes the loop again once it lands
+			if (!m_overflowed.load(std::memory_order_acquire) || !m_inbox.Empty()) {
+				return;
+			}
+
+			std::deque<PostedFn> overflow;
+			{
+				std::lock_guard<std::mutex> lock(m_overflow_lock);
+				overflow.swap(m_overflow);
+				m_overflowed.store(false, std::memory_order_release);
+			}
+
+			for (auto &f : overflow) {
+				f();
+			}
+		}
 	
 		uv_loop_t m_loop;
+		uv_async_t m_inbox_async;
+		Event::Inbox<PostedFn, InboxCapacity> m_inbox;
+		std::mutex m_overflow_lock;
+		std::deque<PostedFn> m_overflow;
+		std::atomic<bool> m_overflowed{ false };
 	};
 }
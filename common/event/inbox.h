@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace EQ
+{
+	namespace Event
+	{
+		/**
+		 * Bounded lock free queue with any number of producers and a single consumer
+		 *
+		 * Slots are allocated once up front and values are moved in and out of them, pushing and
+		 * popping never allocate. Each slot carries a sequence number that tells producers it is
+		 * free and the consumer that it has been filled, so a producer stalled half way through a
+		 * push only holds up the consumer at its own slot.
+		 */
+		template<typename T, size_t Capacity>
+		class Inbox
+		{
+			static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Inbox capacity must be a power of two");
+		public:
+			Inbox() : m_slots(new Slot[Capacity]), m_tail(0), m_head(0) {
+				for (size_t i = 0; i < Capacity; ++i) {
+					m_slots[i].sequence.store(i, std::memory_order_relaxed);
+				}
+			}
+
+			Inbox(const Inbox&) = delete;
+			Inbox& operator=(const Inbox&) = delete;
+
+			//safe from any thread, false when the inbox is full
+			bool TryPush(T &&value) {
+				size_t pos = m_tail.load(std::memory_order_relaxed);
+				for (;;) {
+					Slot &slot = m_slots[pos & (Capacity - 1)];
+					size_t seq = slot.sequence.load(std::memory_order_acquire);
+					intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+					if (diff == 0) {
+						if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+							slot.value = std::move(value);
+							slot.sequence.store(pos + 1, std::memory_order_release);
+							return true;
+						}
+					}
+					else if (diff < 0) {
+						return false;
+					}
+					else {
+						pos = m_tail.load(std::memory_order_relaxed);
+					}
+				}
+			}
+
+			//consumer thread only, false when there is nothing ready
+			bool TryPop(T &value) {
+				Slot &slot = m_slots[m_head & (Capacity - 1)];
+				size_t seq = slot.sequence.load(std::memory_order_acquire);
+				if (seq != m_head + 1) {
+					return false;
+				}
+
+				value = std::move(slot.value);
+				slot.value = T();
+				slot.sequence.store(m_head + Capacity, std::memory_order_release);
+				++m_head;
+				return true;
+			}
+
+			//consumer thread only, true when no push has claimed a slot past the consumer, finished or not
+			bool Empty() const {
+				return m_tail.load(std::memory_order_acquire) == m_head;
+			}
+
+		private:
+			struct Slot
+			{
+				std::atomic<size_t> sequence;
+				T value;
+			};
+
+			std::unique_ptr<Slot[]> m_slots;
+			alignas(64) std::atomic<size_t> m_tail;
+			alignas(64) size_t m_head;
+		};
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace EQ
+{
+	namespace Event
+	{
+		/**
+		 * Move only void() callable kept inside a fixed size buffer
+		 *
+		 * Where std::function puts anything past its small buffer (16 bytes with libstdc++) on the
+		 * heap, this never allocates: a callable that does not fit fails to compile. What the
+		 * captures own themselves (a string's characters, a packet's data) is theirs to allocate,
+		 * moving them in does not.
+		 */
+		template<size_t Size>
+		class InlineFunction
+		{
+		public:
+			InlineFunction() : m_ops(nullptr) { }
+
+			template<typename Fn, typename = typename std::enable_if<!std::is_same<typename std::decay<Fn>::type, InlineFunction>::value>::type>
+			InlineFunction(Fn &&fn) {
+				typedef typename std::decay<Fn>::type Callable;
+				static_assert(sizeof(Callable) <= Size, "Callable is too large for InlineFunction, capture less or capture a pointer");
+				static_assert(alignof(Callable) <= alignof(std::max_align_t), "Callable is over aligned for InlineFunction");
+
+				new (&m_storage) Callable(std::forward<Fn>(fn));
+				m_ops = &Ops<Callable>::Table;
+			}
+
+			InlineFunction(InlineFunction &&o) : m_ops(o.m_ops) {
+				if (m_ops) {
+					m_ops->move(&m_storage, &o.m_storage);
+					o.m_ops = nullptr;
+				}
+			}
+
+			InlineFunction& operator=(InlineFunction &&o) {
+				if (this != &o) {
+					Reset();
+					m_ops = o.m_ops;
+					if (m_ops) {
+						m_ops->move(&m_storage, &o.m_storage);
+						o.m_ops = nullptr;
+					}
+				}
+
+				return *this;
+			}
+
+			InlineFunction(const InlineFunction&) = delete;
+			InlineFunction& operator=(const InlineFunction&) = delete;
+
+			~InlineFunction() {
+				Reset();
+			}
+
+			void Reset() {
+				if (m_ops) {
+					m_ops->destroy(&m_storage);
+					m_ops = nullptr;
+				}
+			}
+
+			explicit operator bool() const { return m_ops != nullptr; }
+
+			void operator()() {
+				m_ops->invoke(&m_storage);
+			}
+
+		private:
+			struct OpTable
+			{
+				void(*invoke)(void *self);
+				void(*move)(void *to, void *from);
+				void(*destroy)(void *self);
+			};
+
+			template<typename Callable>
+			struct Ops
+			{
+				static void Invoke(void *self) {
+					(*static_cast<Callable*>(self))();
+				}
+
+				//leaves from destroyed
+				static void Move(void *to, void *from) {
+					new (to) Callable(std::move(*static_cast<Callable*>(from)));
+					static_cast<Callable*>(from)->~Callable();
+				}
+
+				static void Destroy(void *self) {
+					static_cast<Callable*>(self)->~Callable();
+				}
+
+				static const OpTable Table;
+			};
+
+			typename std::aligned_storage<Size, alignof(std::max_align_t)>::type m_storage;
+			const OpTable *m_ops;
+		};
+
+		template<size_t Size>
+		template<typename Callable>
+		const typename InlineFunction<Size>::OpTable InlineFunction<Size>::Ops<Callable>::Table = {
+			&InlineFunction<Size>::Ops<Callable>::Invoke,
+			&InlineFunction<Size>::Ops<Callable>::Move,
+			&InlineFunction<Size>::Ops<Callable>::Destroy
+		};
+	}
+}
@@ -1,55 +1,101 @@
 #pragma once
 #include <vector>
+#include <deque>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
-#include <queue>
 #include <future>
+#include <memory>
+#include <stdexcept>
+#include <cstdint>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
 
 namespace EQ
 {
 	namespace Event
 	{
+		/**
+		 * Thread pool where every worker has its own queue
+		 *
+		 * Work queued from a worker goes on that worker's queue and is taken newest first, work
+		 * from any other thread is spread round robin. A worker with nothing left takes the oldest
+		 * task from the other queues before it goes to sleep.
+		 */
 		class TaskScheduler
 		{
 		public:
 			static const int DefaultThreadCount = 4;
-		
+
+			struct Stats
+			{
+				size_t   queued;      // tasks waiting for a worker
+				uint64_t completed;   // tasks run since the scheduler started
+				uint64_t stolen;      // tasks a worker took from another worker's queue
+				double   avg_wait_ms; // mean time from queueing until a worker picked the task up
+				double   max_wait_ms;
+			};
+
 			TaskScheduler() : _running(false)
 			{
 				Start(DefaultThreadCount);
 			}
 
-			TaskScheduler(size_t threads) : _running(false)
+			TaskScheduler(size_t threads, bool pin_threads = false) : _running(false)
 			{
-				Start(threads);
+				Start(threads, pin_threads);
 			}
-			
+
 			~TaskScheduler() {
 				Stop();
 			}
 
-			void Start(size_t threads) {
+			//pin_threads binds worker i to cpu i, where the platform supports it
+			void Start(size_t threads, bool pin_threads = false) {
 				if (true == _running) {
 					return;
 				}
 
+				if (threads == 0) {
+					threads = 1;
+				}
+
 				_running = true;
+				_exiting = false;
+
+				_workers.clear();
+				for (size_t i = 0; i < threads; ++i) {
+					_workers.push_back(std::unique_ptr<Worker>(new Worker()));
+				}
 
 				for (size_t i = 0; i < threads; ++i) {
-					_threads.push_back(std::thread(std::bind(&TaskScheduler::ProcessWork, this)));
+					_threads.push_back(std::thread([this, i]() { ProcessWork(i); }));
+					if (pin_threads) {
+						PinThread(_threads.back(), i);
+					}
 				}
 			}
-			
+
 			void Stop() {
 				if (false == _running) {
 					return;
 				}
 
+				_running = false;
+
+				//a Push that got past the running check before it was cleared still queues its task
+				while (_pushing.load() > 0) {
+					std::this_thread::yield();
+				}
+
 				{
-					std::unique_lock<std::mutex> lock(_lock);
-					_running = false;
+					std::unique_lock<std::mutex> lock(_sleep_lock);
+					_exiting = true;
 				}
 
 				_cv.notify_all();
@@ -57,58 +103,197 @@ namespace EQ
 				for (auto &t : _threads) {
 					t.join();
 				}
+
+				_threads.clear();
 			}
-			
+
 			template<typename Fn, typename... Args>
 			auto Enqueue(Fn&& fn, Args&&... args) -> std::future<typename std::result_of<Fn(Args...)>::type> {
 				using return_type = typename std::result_of<Fn(Args...)>::type;
-			
+
 				auto task = std::make_shared<std::packaged_task<return_type()>>(
 					std::bind(std::forward<Fn>(fn), std::forward<Args>(args)...)
 					);
-			
+
 				std::future<return_type> res = task->get_future();
+				Push([task]() { (*task)(); });
+				return res;
+			}
+
+			//fire and forget, no future or shared state is created for the task
+			template<typename Fn>
+			void Post(Fn&& fn) {
+				Push(std::function<void()>(std::forward<Fn>(fn)));
+			}
+
+			size_t GetThreadCount() const {
+				return _workers.size();
+			}
+
+			Stats GetStats() const {
+				Stats s;
+				s.queued    = _queued.load(std::memory_order_relaxed);
+				s.completed = _completed.load(std::memory_order_relaxed);
+				s.stolen    = _stolen.load(std::memory_order_relaxed);
+
+				uint64_t started = _started.load(std::memory_order_relaxed);
+				s.avg_wait_ms = started > 0 ? (double)_wait_total_us.load(std::memory_order_relaxed) / started / 1000.0 : 0.0;
+				s.max_wait_ms = (double)_wait_max_us.load(std::memory_order_relaxed) / 1000.0;
+				return s;
+			}
+
+		private:
+			typedef std::chrono::steady_clock Clock;
+
+			struct Task
+			{
+				std::function<void()> work;
+				Clock::time_point queued_at;
+			};
+
+			struct Worker
+			{
+				std::mutex lock;
+				std::deque<Task> tasks;
+			};
+
+			struct WorkerContext
+			{
+				const TaskScheduler *owner;
+				size_t index;
+			};
+
+			static WorkerContext &CurrentWorker() {
+				static thread_local WorkerContext ctx = { nullptr, 0 };
+				return ctx;
+			}
+
+			static void PinThread(std::thread &t, size_t index) {
+#ifdef __linux__
+				unsigned int cpus = std::thread::hardware_concurrency();
+				if (cpus == 0) {
+					return;
+				}
+
+				cpu_set_t set;
+				CPU_ZERO(&set);
+				CPU_SET(index % cpus, &set);
+				pthread_setaffinity_np(t.native_handle(), sizeof(cpu_set_t), &set);
+#else
+				(void)t;
+				(void)index;
+#endif
+			}
+
+			void Push(std::function<void()> &&work) {
+				//registering before the running check means Stop either makes us refuse or waits for the task to be queued
+				_pushing.fetch_add(1);
+				if (false == _running) {
+					_pushing.fetch_sub(1);
+					throw std::runtime_error("Enqueue on stopped scheduler.");
+				}
+
+				auto &ctx = CurrentWorker();
+				size_t index = ctx.owner == this ? ctx.index : _next.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+
+				_queued.fetch_add(1);
+
 				{
-					std::unique_lock<std::mutex> lock(_lock);
-			
-					if (false == _running) {
-						throw std::runtime_error("Enqueue on stopped scheduler.");
+					auto &w = *_workers[index];
+					std::unique_lock<std::mutex> lock(w.lock);
+					w.tasks.push_back(Task{ std::move(work), Clock::now() });
+				}
+
+				_pushing.fetch_sub(1);
+
+				//a worker counts itself as sleeping before it checks the queue, so either it sees this task or we
+				//see it and go through the sleep lock to make sure it is waiting before we wake it
+				if (_sleeping.load() > 0) {
+					{
+						std::unique_lock<std::mutex> sleep_lock(_sleep_lock);
 					}
-			
-					_tasks.emplace([task]() { (*task)(); });
+
+					_cv.notify_one();
 				}
-			
-				_cv.notify_one();
-				return res;
 			}
-			
-			private:
-			void ProcessWork() {
-				for (;;) {
-					std::function<void()> work;
 
-					{
-						std::unique_lock<std::mutex> lock(_lock);
-						_cv.wait(lock, [this] { return !_running || !_tasks.empty(); });
+			bool TakeTask(size_t index, Task &task) {
+				{
+					auto &w = *_workers[index];
+					std::unique_lock<std::mutex> lock(w.lock);
+					if (!w.tasks.empty()) {
+						task = std::move(w.tasks.back());
+						w.tasks.pop_back();
+						return true;
+					}
+				}
+
+				for (size_t i = 1; i < _workers.size(); ++i) {
+					auto &w = *_workers[(index + i) % _workers.size()];
+					std::unique_lock<std::mutex> lock(w.lock);
+					if (!w.tasks.empty()) {
+						task = std::move(w.tasks.front());
+						w.tasks.pop_front();
+						_stolen.fetch_add(1, std::memory_order_relaxed);
+						return true;
+					}
+				}
+
+				return false;
+			}
+
+			void RecordWait(Clock::time_point queued_at) {
+				uint64_t waited = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - queued_at).count();
+				_started.fetch_add(1, std::memory_order_relaxed);
+				_wait_total_us.fetch_add(waited, std::memory_order_relaxed);
+
+				uint64_t max = _wait_max_us.load(std::memory_order_relaxed);
+				while (waited > max && !_wait_max_us.compare_exchange_weak(max, waited, std::memory_order_relaxed)) {
+				}
+			}
 
-						if (false == _running) {
-							return;
-						}
+			void ProcessWork(size_t index) {
+				auto &ctx = CurrentWorker();
+				ctx.owner = this;
+				ctx.index = index;
 
-						work = std::move(_tasks.front());
-						_tasks.pop();
+				for (;;) {
+					Task task;
+					if (TakeTask(index, task)) {
+						_queued.fetch_sub(1, std::memory_order_relaxed);
+						RecordWait(task.queued_at);
+						task.work();
+						_completed.fetch_add(1, std::memory_order_relaxed);
+						continue;
 					}
 
-					work();
+					std::unique_lock<std::mutex> lock(_sleep_lock);
+					_sleeping.fetch_add(1);
+					_cv.wait(lock, [this] { return _exiting || _queued.load() > 0; });
+					_sleeping.fetch_sub(1);
+
+					if (_exiting && _queued.load() == 0) {
+						return;
+					}
 				}
-				
 			}
 
-			bool _running = true;
+			std::atomic<bool> _running;
+			bool _exiting = false; //set under the sleep lock once no Push can still queue a task
+			std::vector<std::unique_ptr<Worker>> _workers;
 			std::vector<std::thread> _threads;
-			std::mutex _lock;
+			std::atomic<size_t> _next{ 0 };
+			std::atomic<size_t> _queued{ 0 };
+			std::atomic<size_t> _pushing{ 0 };
+			std::atomic<size_t> _sleeping{ 0 };
+			std::mutex _sleep_lock;
 			std::condition_variable _cv;
-			std::queue<std::function<void()>> _tasks;
+
+			std::atomic<uint64_t> _completed{ 0 };
+			std::atomic<uint64_t> _started{ 0 };
+			std::atomic<uint64_t> _stolen{ 0 };
+			std::atomic<uint64_t> _wait_total_us{ 0 };
+			std::atomic<uint64_t> _wait_max_us{ 0 };
 		};
 	}
 }
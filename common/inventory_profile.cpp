@@ -31,6 +31,8 @@
 
 //#include <limits.h>
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 std::list<EQ::ItemInstance*> dirty_inst;
@@ -93,30 +95,28 @@ EQ::ItemInstance* ItemInstQueue::peek_front() const
 //
 EQ::InventoryProfile::~InventoryProfile()
 {
-	for (auto iter = m_worn.begin(); iter != m_worn.end(); ++iter) {
-		safe_delete(iter->second);
-	}
-	m_worn.clear();
+	for (auto& inst : m_worn)
+		safe_delete(inst);
 
-	for (auto iter = m_inv.begin(); iter != m_inv.end(); ++iter) {
-		safe_delete(iter->second);
-	}
-	m_inv.clear();
+	for (auto& inst : m_tribute)
+		safe_delete(inst);
 
-	for (auto iter = m_bank.begin(); iter != m_bank.end(); ++iter) {
-		safe_delete(iter->second);
-	}
-	m_bank.clear();
+	for (auto& inst : m_inv)
+		safe_delete(inst);
 
-	for (auto iter = m_shbank.begin(); iter != m_shbank.end(); ++iter) {
-		safe_delete(iter->second);
-	}
-	m_shbank.clear();
+	for (auto& inst : m_bank)
+		safe_delete(inst);
 
-	for (auto iter = m_trade.begin(); iter != m_trade.end(); ++iter) {
-		safe_delete(iter->second);
-	}
-	m_trade.clear();
+	for (auto& inst : m_shbank)
+		safe_delete(inst);
+
+	for (auto& inst : m_trade)
+		safe_delete(inst);
+
+	// the cursor queue is torn down after the index, empty it while the index is still around
+	ItemInstance* inst = nullptr;
+	while ((inst = m_cursor.pop()) != nullptr)
+		safe_delete(inst);
 }
 
 void EQ::InventoryProfile::SetInventoryVersion(versions::MobVersion inventory_version) {
@@ -158,44 +158,44 @@ EQ::ItemInstance* EQ::InventoryProfile::GetItem(int16 slot_id) const
 
 	// Non bag slots
 	else if (slot_id >= invslot::TRADE_BEGIN && slot_id <= invslot::TRADE_END) {
-		result = _GetItem(m_trade, slot_id);
+		result = _GetItem(slot_id);
 	}
 	else if (slot_id >= invslot::SHARED_BANK_BEGIN && slot_id <= invslot::SHARED_BANK_END) {
 		// Shared Bank slots
-		result = _GetItem(m_shbank, slot_id);
+		result = _GetItem(slot_id);
 	}
 	else if (slot_id >= invslot::BANK_BEGIN && slot_id <= invslot::BANK_END) {
 		// Bank slots
-		result = _GetItem(m_bank, slot_id);
+		result = _GetItem(slot_id);
 	}
 	else if ((slot_id >= invslot::GENERAL_BEGIN && slot_id <= invslot::GENERAL_END)) {
 		// Personal inventory slots
-		result = _GetItem(m_inv, slot_id);
+		result = _GetItem(slot_id);
 	}
 	else if ((slot_id >= invslot::EQUIPMENT_BEGIN && slot_id <= invslot::EQUIPMENT_END) ||
 		(slot_id >= invslot::TRIBUTE_BEGIN && slot_id <= invslot::TRIBUTE_END)) {
 		// Equippable slots (on body)
-		result = _GetItem(m_worn, slot_id);
+		result = _GetItem(slot_id);
 	}
 
 	// Inner bag slots
 	else if (slot_id >= invbag::TRADE_BAGS_BEGIN && slot_id <= invbag::TRADE_BAGS_END) {
 		// Trade bag slots
-		ItemInstance* inst = _GetItem(m_trade, InventoryProfile::CalcSlotId(slot_id));
+		ItemInstance* inst = _GetItem(InventoryProfile::CalcSlotId(slot_id));
 		if (inst && inst->IsClassBag()) {
 			result = inst->GetItem(InventoryProfile::CalcBagIdx(slot_id));
 		}
 	}
 	else if (slot_id >= invbag::SHARED_BANK_BAGS_BEGIN && slot_id <= invbag::SHARED_BANK_BAGS_END) {
 		// Shared Bank bag slots
-		ItemInstance* inst = _GetItem(m_shbank, InventoryProfile::CalcSlotId(slot_id));
+		ItemInstance* inst = _GetItem(InventoryProfile::CalcSlotId(slot_id));
 		if (inst && inst->IsClassBag()) {
 			result = inst->GetItem(InventoryProfile::CalcBagIdx(slot_id));
 		}
 	}
 	else if (slot_id >= invbag::BANK_BAGS_BEGIN && slot_id <= invbag::BANK_BAGS_END) {
 		// Bank bag slots
-		ItemInstance* inst = _GetItem(m_bank, InventoryProfile::CalcSlotId(slot_id));
+		ItemInstance* inst = _GetItem(InventoryProfile::CalcSlotId(slot_id));
 		if (inst && inst->IsClassBag()) {
 			result = inst->GetItem(InventoryProfile::CalcBagIdx(slot_id));
 		}
@@ -209,7 +209,7 @@ EQ::ItemInstance* EQ::InventoryProfile::GetItem(int16 slot_id) const
 	}
 	else if (slot_id >= invbag::GENERAL_BAGS_BEGIN && slot_id <= invbag::GENERAL_BAGS_END) {
 		// Personal inventory bag slots
-		ItemInstance* inst = _GetItem(m_inv, InventoryProfile::CalcSlotId(slot_id));
+		ItemInstance* inst = _GetItem(InventoryProfile::CalcSlotId(slot_id));
 		if (inst && inst->IsClassBag()) {
 			result = inst->GetItem(InventoryProfile::CalcBagIdx(slot_id));
 		}
@@ -260,7 +260,9 @@ int16 EQ::InventoryProfile::PutItem(int16 slot_id, const ItemInstance& inst)
 }
 
 int16 EQ::InventoryProfile::PushCursor(const ItemInstance &inst) {
-	m_cursor.push(inst.Clone());
+	ItemInstance* cursor_inst = inst.Clone();
+	_AddToIndex(cursor_inst, IndexCursor, true);
+	m_cursor.push(cursor_inst);
 	return invslot::slotCursor;
 }
 
@@ -390,8 +392,15 @@ bool EQ::InventoryProfile::SwapItem(
 		}
 	}
 
-	_PutItem(source_slot, destination_item_instance); // Assign destination -> source
-	_PutItem(destination_slot, source_item_instance); // Assign source -> destination
+	// Vacate a slot before filling the other, so the index never sees an item popped from the slot it just moved into
+	if (source_item_instance == nullptr) {
+		_PutItem(destination_slot, nullptr);
+		_PutItem(source_slot, destination_item_instance);
+	}
+	else {
+		_PutItem(source_slot, destination_item_instance); // Assign destination -> source
+		_PutItem(destination_slot, source_item_instance); // Assign source -> destination
+	}
 
 	fail_state = swapPass;
 
@@ -451,30 +460,12 @@ EQ::ItemInstance* EQ::InventoryProfile::PopItem(int16 slot_id)
 
 	if (slot_id == invslot::slotCursor) {
 		p = m_cursor.pop();
+		_RemoveFromIndex(p);
 	}
-	else if (slot_id >= invslot::EQUIPMENT_BEGIN && slot_id <= invslot::EQUIPMENT_END) {
-		p = m_worn[slot_id];
-		m_worn.erase(slot_id);
-	}
-	else if (slot_id >= invslot::GENERAL_BEGIN && slot_id <= invslot::GENERAL_END) {
-		p = m_inv[slot_id];
-		m_inv.erase(slot_id);
-	}
-	else if (slot_id >= invslot::TRIBUTE_BEGIN && slot_id <= invslot::TRIBUTE_END) {
-		p = m_worn[slot_id];
-		m_worn.erase(slot_id);
-	}
-	else if (slot_id >= invslot::BANK_BEGIN && slot_id <= invslot::BANK_END) {
-		p = m_bank[slot_id];
-		m_bank.erase(slot_id);
-	}
-	else if (slot_id >= invslot::SHARED_BANK_BEGIN && slot_id <= invslot::SHARED_BANK_END) {
-		p = m_shbank[slot_id];
-		m_shbank.erase(slot_id);
-	}
-	else if (slot_id >= invslot::TRADE_BEGIN && slot_id <= invslot::TRADE_END) {
-		p = m_trade[slot_id];
-		m_trade.erase(slot_id);
+	else if (ItemInstance** slot = _GetSlot(slot_id)) {
+		p = *slot;
+		*slot = nullptr;
+		_RemoveFromIndex(p);
 	}
 	else {
 		// Is slot inside bag?
@@ -599,33 +590,47 @@ int16 EQ::InventoryProfile::HasItem(uint32 item_id, uint8 quantity, uint8 where)
 	//Altered by Father Nitwit to support a specification of
 	//where to search, with a default value to maintain compatibility
 
+	uint32 quantity_found = 0;
+
+	// an empty augment socket reads as item id 0, leave those searches to the walk
+	if (item_id != 0)
+		where &= _IndexedWhere(m_item_index, item_id, quantity);
+
 	// Check each inventory bucket
 	if (where & invWhereWorn) {
-		slot_id = _HasItem(m_worn, item_id, quantity);
+		slot_id = _HasItem(m_worn, invslot::EQUIPMENT_BEGIN, invslot::EQUIPMENT_END, item_id, quantity, quantity_found);
+		if (slot_id != INVALID_INDEX)
+			return slot_id;
+
+		slot_id = _HasItem(m_tribute, invslot::TRIBUTE_BEGIN, invslot::TRIBUTE_END, item_id, quantity, quantity_found);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
 
 	if (where & invWherePersonal) {
-		slot_id = _HasItem(m_inv, item_id, quantity);
+		quantity_found = 0;
+		slot_id = _HasItem(m_inv, invslot::GENERAL_BEGIN, invslot::GENERAL_END, item_id, quantity, quantity_found);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
 
 	if (where & invWhereBank) {
-		slot_id = _HasItem(m_bank, item_id, quantity);
+		quantity_found = 0;
+		slot_id = _HasItem(m_bank, invslot::BANK_BEGIN, invslot::BANK_END, item_id, quantity, quantity_found);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
 
 	if (where & invWhereSharedBank) {
-		slot_id = _HasItem(m_shbank, item_id, quantity);
+		quantity_found = 0;
+		slot_id = _HasItem(m_shbank, invslot::SHARED_BANK_BEGIN, invslot::SHARED_BANK_END, item_id, quantity, quantity_found);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
 
 	if (where & invWhereTrading) {
-		slot_id = _HasItem(m_trade, item_id, quantity);
+		quantity_found = 0;
+		slot_id = _HasItem(m_trade, invslot::TRADE_BEGIN, invslot::TRADE_END, item_id, quantity, quantity_found);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
@@ -646,33 +651,45 @@ int16 EQ::InventoryProfile::HasItemByUse(uint8 use, uint8 quantity, uint8 where)
 {
 	int16 slot_id = INVALID_INDEX;
 
+	uint32 quantity_found = 0;
+
+	where &= _IndexedWhere(m_use_index, use, quantity);
+
 	// Check each inventory bucket
 	if (where & invWhereWorn) {
-		slot_id = _HasItemByUse(m_worn, use, quantity);
+		slot_id = _HasItemByUse(m_worn, invslot::EQUIPMENT_BEGIN, invslot::EQUIPMENT_END, use, quantity, quantity_found);
+		if (slot_id != INVALID_INDEX)
+			return slot_id;
+
+		slot_id = _HasItemByUse(m_tribute, invslot::TRIBUTE_BEGIN, invslot::TRIBUTE_END, use, quantity, quantity_found);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
 
 	if (where & invWherePersonal) {
-		slot_id = _HasItemByUse(m_inv, use, quantity);
+		quantity_found = 0;
+		slot_id = _HasItemByUse(m_inv, invslot::GENERAL_BEGIN, invslot::GENERAL_END, use, quantity, quantity_found);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
 
 	if (where & invWhereBank) {
-		slot_id = _HasItemByUse(m_bank, use, quantity);
+		quantity_found = 0;
+		slot_id = _HasItemByUse(m_bank, invslot::BANK_BEGIN, invslot::BANK_END, use, quantity, quantity_found);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
 
 	if (where & invWhereSharedBank) {
-		slot_id = _HasItemByUse(m_shbank, use, quantity);
+		quantity_found = 0;
+		slot_id = _HasItemByUse(m_shbank, invslot::SHARED_BANK_BEGIN, invslot::SHARED_BANK_END, use, quantity, quantity_found);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
 
 	if (where & invWhereTrading) {
-		slot_id = _HasItemByUse(m_trade, use, quantity);
+		quantity_found = 0;
+		slot_id = _HasItemByUse(m_trade, invslot::TRADE_BEGIN, invslot::TRADE_END, use, quantity, quantity_found);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
@@ -692,33 +709,39 @@ int16 EQ::InventoryProfile::HasItemByLoreGroup(uint32 loregroup, uint8 where)
 {
 	int16 slot_id = INVALID_INDEX;
 
+	where &= _IndexedWhere(m_loregroup_index, loregroup, 0);
+
 	// Check each inventory bucket
 	if (where & invWhereWorn) {
-		slot_id = _HasItemByLoreGroup(m_worn, loregroup);
+		slot_id = _HasItemByLoreGroup(m_worn, invslot::EQUIPMENT_BEGIN, invslot::EQUIPMENT_END, loregroup);
+		if (slot_id != INVALID_INDEX)
+			return slot_id;
+
+		slot_id = _HasItemByLoreGroup(m_tribute, invslot::TRIBUTE_BEGIN, invslot::TRIBUTE_END, loregroup);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
 
 	if (where & invWherePersonal) {
-		slot_id = _HasItemByLoreGroup(m_inv, loregroup);
+		slot_id = _HasItemByLoreGroup(m_inv, invslot::GENERAL_BEGIN, invslot::GENERAL_END, loregroup);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
 
 	if (where & invWhereBank) {
-		slot_id = _HasItemByLoreGroup(m_bank, loregroup);
+		slot_id = _HasItemByLoreGroup(m_bank, invslot::BANK_BEGIN, invslot::BANK_END, loregroup);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
 
 	if (where & invWhereSharedBank) {
-		slot_id = _HasItemByLoreGroup(m_shbank, loregroup);
+		slot_id = _HasItemByLoreGroup(m_shbank, invslot::SHARED_BANK_BEGIN, invslot::SHARED_BANK_END, loregroup);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
 
 	if (where & invWhereTrading) {
-		slot_id = _HasItemByLoreGroup(m_trade, loregroup);
+		slot_id = _HasItemByLoreGroup(m_trade, invslot::TRADE_BEGIN, invslot::TRADE_END, loregroup);
 		if (slot_id != INVALID_INDEX)
 			return slot_id;
 	}
@@ -806,7 +829,7 @@ int16 EQ::InventoryProfile::FindFreeSlotForTradeItem(const ItemInstance* inst, i
 			if ((((uint64)1 << free_slot) & m_lookup->PossessionsBitmask) == 0)
 				continue;
 
-			if (!m_inv[free_slot])
+			if (!m_inv[free_slot - invslot::GENERAL_BEGIN])
 				return free_slot;
 		}
 
@@ -819,7 +842,7 @@ int16 EQ::InventoryProfile::FindFreeSlotForTradeItem(const ItemInstance* inst, i
 			if ((((uint64)1 << free_slot) & m_lookup->PossessionsBitmask) == 0)
 				continue;
 
-			const ItemInstance* main_inst = m_inv[free_slot];
+			const ItemInstance* main_inst = m_inv[free_slot - invslot::GENERAL_BEGIN];
 
 			if (!main_inst)
 				continue;
@@ -832,7 +855,7 @@ int16 EQ::InventoryProfile::FindFreeSlotForTradeItem(const ItemInstance* inst, i
 			if ((((uint64)1 << free_slot) & m_lookup->PossessionsBitmask) == 0)
 				continue;
 
-			const ItemInstance* main_inst = m_inv[free_slot];
+			const ItemInstance* main_inst = m_inv[free_slot - invslot::GENERAL_BEGIN];
 
 			if (!main_inst)
 				continue;
@@ -858,7 +881,7 @@ int16 EQ::InventoryProfile::FindFreeSlotForTradeItem(const ItemInstance* inst, i
 			if ((((uint64)1 << free_slot) & m_lookup->PossessionsBitmask) == 0)
 				continue;
 
-			const ItemInstance* main_inst = m_inv[free_slot];
+			const ItemInstance* main_inst = m_inv[free_slot - invslot::GENERAL_BEGIN];
 
 			if (!main_inst || (main_inst->GetItem()->BagType != item::BagTypeQuiver) || !main_inst->IsClassBag())
 				continue;
@@ -877,7 +900,7 @@ int16 EQ::InventoryProfile::FindFreeSlotForTradeItem(const ItemInstance* inst, i
 			if ((((uint64)1 << free_slot) & m_lookup->PossessionsBitmask) == 0)
 				continue;
 
-			const ItemInstance* main_inst = m_inv[free_slot];
+			const ItemInstance* main_inst = m_inv[free_slot - invslot::GENERAL_BEGIN];
 
 			if (!main_inst || (main_inst->GetItem()->BagType != item::BagTypeBandolier) || !main_inst->IsClassBag())
 				continue;
@@ -895,7 +918,7 @@ int16 EQ::InventoryProfile::FindFreeSlotForTradeItem(const ItemInstance* inst, i
 		if ((((uint64)1 << free_slot) & m_lookup->PossessionsBitmask) == 0)
 			continue;
 
-		const ItemInstance* main_inst = m_inv[free_slot];
+		const ItemInstance* main_inst = m_inv[free_slot - invslot::GENERAL_BEGIN];
 
 		if (!main_inst)
 			return free_slot;
@@ -905,7 +928,7 @@ int16 EQ::InventoryProfile::FindFreeSlotForTradeItem(const ItemInstance* inst, i
 		if ((((uint64)1 << free_slot) & m_lookup->PossessionsBitmask) == 0)
 			continue;
 
-		const ItemInstance* main_inst = m_inv[free_slot];
+		const ItemInstance* main_inst = m_inv[free_slot - invslot::GENERAL_BEGIN];
 
 		if (main_inst && main_inst->IsClassBag()) {
 			if ((main_inst->GetItem()->BagSize < inst->GetItem()->Size) || (main_inst->GetItem()->BagType == item::BagTypeBandolier) || (main_inst->GetItem()->BagType == item::BagTypeQuiver))
@@ -1130,27 +1153,32 @@ int EQ::InventoryProfile::GetSlotByItemInst(ItemInstance *inst) {
 	if (!inst)
 		return INVALID_INDEX;
 
-	int i = GetSlotByItemInstCollection(m_worn, inst);
+	int i = GetSlotByItemInstCollection(m_worn, invslot::EQUIPMENT_BEGIN, invslot::EQUIPMENT_END, inst);
+	if (i != INVALID_INDEX) {
+		return i;
+	}
+
+	i = GetSlotByItemInstCollection(m_tribute, invslot::TRIBUTE_BEGIN, invslot::TRIBUTE_END, inst);
 	if (i != INVALID_INDEX) {
 		return i;
 	}
 
-	i = GetSlotByItemInstCollection(m_inv, inst);
+	i = GetSlotByItemInstCollection(m_inv, invslot::GENERAL_BEGIN, invslot::GENERAL_END, inst);
 	if (i != INVALID_INDEX) {
 		return i;
 	}
 
-	i = GetSlotByItemInstCollection(m_bank, inst);
+	i = GetSlotByItemInstCollection(m_bank, invslot::BANK_BEGIN, invslot::BANK_END, inst);
 	if (i != INVALID_INDEX) {
 		return i;
 	}
 
-	i = GetSlotByItemInstCollection(m_shbank, inst);
+	i = GetSlotByItemInstCollection(m_shbank, invslot::SHARED_BANK_BEGIN, invslot::SHARED_BANK_END, inst);
 	if (i != INVALID_INDEX) {
 		return i;
 	}
 
-	i = GetSlotByItemInstCollection(m_trade, inst);
+	i = GetSlotByItemInstCollection(m_trade, invslot::TRADE_BEGIN, invslot::TRADE_END, inst);
 	if (i != INVALID_INDEX) {
 		return i;
 	}
@@ -1166,14 +1194,11 @@ uint8 EQ::InventoryProfile::FindBrightestLightType()
 {
 	uint8 brightest_light_type = 0;
 
-	for (auto iter = m_worn.begin(); iter != m_worn.end(); ++iter) {
-		if ((iter->first < invslot::EQUIPMENT_BEGIN || iter->first > invslot::EQUIPMENT_END))
-			continue;
-		
-		if (iter->first == invslot::slotAmmo)
+	for (int16 slot_id = invslot::EQUIPMENT_BEGIN; slot_id <= invslot::EQUIPMENT_END; ++slot_id) {
+		if (slot_id == invslot::slotAmmo)
 			continue;
 
-		auto inst = iter->second;
+		auto inst = m_worn[slot_id - invslot::EQUIPMENT_BEGIN];
 		if (inst == nullptr)
 			continue;
 
@@ -1186,11 +1211,8 @@ uint8 EQ::InventoryProfile::FindBrightestLightType()
 	}
 
 	uint8 general_light_type = 0;
-	for (auto iter = m_inv.begin(); iter != m_inv.end(); ++iter) {
-		if (iter->first < invslot::GENERAL_BEGIN || iter->first > invslot::GENERAL_END)
-			continue;
-
-		auto inst = iter->second;
+	for (int16 slot_id = invslot::GENERAL_BEGIN; slot_id <= invslot::GENERAL_END; ++slot_id) {
+		auto inst = m_inv[slot_id - invslot::GENERAL_BEGIN];
 		if (inst == nullptr)
 			continue;
 
@@ -1225,37 +1247,42 @@ void EQ::InventoryProfile::dumpEntireInventory() {
 
 void EQ::InventoryProfile::dumpWornItems() {
 	std::cout << "Worn items:" << std::endl;
-	dumpItemCollection(m_worn);
+	dumpItemCollection(m_worn, invslot::EQUIPMENT_BEGIN, invslot::EQUIPMENT_END);
+	dumpItemCollection(m_tribute, invslot::TRIBUTE_BEGIN, invslot::TRIBUTE_END);
 }
 
 void EQ::InventoryProfile::dumpInventory() {
 	std::cout << "Inventory items:" << std::endl;
-	dumpItemCollection(m_inv);
+	dumpItemCollection(m_inv, invslot::GENERAL_BEGIN, invslot::GENERAL_END);
 }
 
 void EQ::InventoryProfile::dumpBankItems() {
 
 	std::cout << "Bank items:" << std::endl;
-	dumpItemCollection(m_bank);
+	dumpItemCollection(m_bank, invslot::BANK_BEGIN, invslot::BANK_END);
 }
 
 void EQ::InventoryProfile::dumpSharedBankItems() {
 
 	std::cout << "Shared Bank items:" << std::endl;
-	dumpItemCollection(m_shbank);
+	dumpItemCollection(m_shbank, invslot::SHARED_BANK_BEGIN, invslot::SHARED_BANK_END);
 }
 
-int EQ::InventoryProfile::GetSlotByItemInstCollection(const std::map<int16, ItemInstance*> &collection, ItemInstance *inst) {
-	for (auto iter = collection.begin(); iter != collection.end(); ++iter) {
-		ItemInstance *t_inst = iter->second;
+int EQ::InventoryProfile::GetSlotByItemInstCollection(ItemInstance* const* bucket, int16 begin, int16 end, ItemInstance *inst) {
+	for (int16 slot_id = begin; slot_id <= end; ++slot_id) {
+		ItemInstance *t_inst = bucket[slot_id - begin];
+		if (t_inst == nullptr) {
+			continue;
+		}
+
 		if (t_inst == inst) {
-			return iter->first;
+			return slot_id;
 		}
 
-		if (t_inst && !t_inst->IsClassBag()) {
+		if (!t_inst->IsClassBag()) {
 			for (auto b_iter = t_inst->_cbegin(); b_iter != t_inst->_cend(); ++b_iter) {
 				if (b_iter->second == inst) {
-					return InventoryProfile::CalcSlotId(iter->first, b_iter->first);
+					return InventoryProfile::CalcSlotId(slot_id, b_iter->first);
 				}
 			}
 		}
@@ -1264,21 +1291,21 @@ int EQ::InventoryProfile::GetSlotByItemInstCollection(const std::map<int16, Item
 	return EQ::invslot::SLOT_INVALID;
 }
 
-void EQ::InventoryProfile::dumpItemCollection(const std::map<int16, ItemInstance*> &collection)
+void EQ::InventoryProfile::dumpItemCollection(ItemInstance* const* bucket, int16 begin, int16 end)
 {
-	for (auto it = collection.cbegin(); it != collection.cend(); ++it) {
-		auto inst = it->second;
+	for (int16 slot_id = begin; slot_id <= end; ++slot_id) {
+		auto inst = bucket[slot_id - begin];
 		if (!inst || !inst->GetItem())
 			continue;
 
-		std::string slot = StringFormat("Slot %d: %s (%d)", it->first, it->second->GetItem()->Name, (inst->GetCharges() <= 0) ? 1 : inst->GetCharges());
+		std::string slot = StringFormat("Slot %d: %s (%d)", slot_id, inst->GetItem()->Name, (inst->GetCharges() <= 0) ? 1 : inst->GetCharges());
 		std::cout << slot << std::endl;
 
-		dumpBagContents(inst, &it);
+		dumpBagContents(inst, slot_id);
 	}
 }
 
-void EQ::InventoryProfile::dumpBagContents(ItemInstance *inst, std::map<int16, ItemInstance*>::const_iterator *it)
+void EQ::InventoryProfile::dumpBagContents(ItemInstance *inst, int16 slot_id)
 {
 	if (!inst || !inst->IsClassBag())
 		return;
@@ -1289,15 +1316,39 @@ void EQ::InventoryProfile::dumpBagContents(ItemInstance *inst, std::map<int16, I
 		if (!baginst || !baginst->GetItem())
 			continue;
 
-		std::string subSlot = StringFormat("	Slot %d: %s (%d)", InventoryProfile::CalcSlotId((*it)->first, itb->first),
+		std::string subSlot = StringFormat("	Slot %d: %s (%d)", InventoryProfile::CalcSlotId(slot_id, itb->first),
 			baginst->GetItem()->Name, (baginst->GetCharges() <= 0) ? 1 : baginst->GetCharges());
 		std::cout << subSlot << std::endl;
 	}
 
 }
 
-// Internal Method: Retrieves item within an inventory bucket
-EQ::ItemInstance* EQ::InventoryProfile::_GetItem(const std::map<int16, ItemInstance*>& bucket, int16 slot_id) const
+// Internal Method: Retrieves the bucket entry holding a top level slot
+EQ::ItemInstance** EQ::InventoryProfile::_GetSlot(int16 slot_id)
+{
+	if (slot_id >= invslot::EQUIPMENT_BEGIN && slot_id <= invslot::EQUIPMENT_END)
+		return &m_worn[slot_id - invslot::EQUIPMENT_BEGIN];
+	if (slot_id >= invslot::GENERAL_BEGIN && slot_id <= invslot::GENERAL_END)
+		return &m_inv[slot_id - invslot::GENERAL_BEGIN];
+	if (slot_id >= invslot::TRIBUTE_BEGIN && slot_id <= invslot::TRIBUTE_END)
+		return &m_tribute[slot_id - invslot::TRIBUTE_BEGIN];
+	if (slot_id >= invslot::BANK_BEGIN && slot_id <= invslot::BANK_END)
+		return &m_bank[slot_id - invslot::BANK_BEGIN];
+	if (slot_id >= invslot::SHARED_BANK_BEGIN && slot_id <= invslot::SHARED_BANK_END)
+		return &m_shbank[slot_id - invslot::SHARED_BANK_BEGIN];
+	if (slot_id >= invslot::TRADE_BEGIN && slot_id <= invslot::TRADE_END)
+		return &m_trade[slot_id - invslot::TRADE_BEGIN];
+
+	return nullptr;
+}
+
+EQ::ItemInstance* const* EQ::InventoryProfile::_GetSlot(int16 slot_id) const
+{
+	return const_cast<InventoryProfile*>(this)->_GetSlot(slot_id);
+}
+
+// Internal Method: Retrieves item at a top level slot
+EQ::ItemInstance* EQ::InventoryProfile::_GetItem(int16 slot_id) const
 {
 	if (slot_id <= EQ::invslot::POSSESSIONS_END && slot_id >= EQ::invslot::POSSESSIONS_BEGIN) {
 		if ((((uint64)1 << slot_id) & m_lookup->PossessionsBitmask) == 0)
@@ -1308,9 +1359,9 @@ EQ::ItemInstance* EQ::InventoryProfile::_GetItem(const std::map<int16, ItemInsta
 			return nullptr;
 	}
 	
-	auto it = bucket.find(slot_id);
-	if (it != bucket.end()) {
-		return it->second;
+	auto slot = _GetSlot(slot_id);
+	if (slot) {
+		return *slot;
 	}
 
 	// Not found!
@@ -1332,42 +1383,35 @@ int16 EQ::InventoryProfile::_PutItem(int16 slot_id, ItemInstance* inst)
 
 	int16 result = INVALID_INDEX;
 	int16 parentSlot = INVALID_INDEX;
+	ItemInstance** slot = nullptr;
 
 	if (slot_id == invslot::slotCursor) {
 		// Replace current item on cursor, if exists
-		m_cursor.pop(); // no memory delete, clients of this function know what they are doing
+		_RemoveFromIndex(m_cursor.pop()); // no memory delete, clients of this function know what they are doing
 		m_cursor.push_front(inst);
+		_AddToIndex(inst, IndexCursor, true);
 		result = slot_id;
 	}
 	else if (slot_id >= invslot::EQUIPMENT_BEGIN && slot_id <= invslot::EQUIPMENT_END) {
-		if ((((uint64)1 << slot_id) & m_lookup->PossessionsBitmask) != 0) {
-			m_worn[slot_id] = inst;
-			result = slot_id;
-		}
+		if ((((uint64)1 << slot_id) & m_lookup->PossessionsBitmask) != 0)
+			slot = _GetSlot(slot_id);
 	}
 	else if ((slot_id >= invslot::GENERAL_BEGIN && slot_id <= invslot::GENERAL_END)) {
-		if ((((uint64)1 << slot_id) & m_lookup->PossessionsBitmask) != 0) {
-			m_inv[slot_id] = inst;
-			result = slot_id;
-		}
+		if ((((uint64)1 << slot_id) & m_lookup->PossessionsBitmask) != 0)
+			slot = _GetSlot(slot_id);
 	}
 	else if (slot_id >= invslot::TRIBUTE_BEGIN && slot_id <= invslot::TRIBUTE_END) {
-		m_worn[slot_id] = inst;
-		result = slot_id;
+		slot = _GetSlot(slot_id);
 	}
 	else if (slot_id >= invslot::BANK_BEGIN && slot_id <= invslot::BANK_END) {
-		if (slot_id - EQ::invslot::BANK_BEGIN < m_lookup->InventoryTypeSize.Bank) {
-			m_bank[slot_id] = inst;
-			result = slot_id;
-		}
+		if (slot_id - EQ::invslot::BANK_BEGIN < m_lookup->InventoryTypeSize.Bank)
+			slot = _GetSlot(slot_id);
 	}
 	else if (slot_id >= invslot::SHARED_BANK_BEGIN && slot_id <= invslot::SHARED_BANK_END) {
-		m_shbank[slot_id] = inst;
-		result = slot_id;
+		slot = _GetSlot(slot_id);
 	}
 	else if (slot_id >= invslot::TRADE_BEGIN && slot_id <= invslot::TRADE_END) {
-		m_trade[slot_id] = inst;
-		result = slot_id;
+		slot = _GetSlot(slot_id);
 	}
 	else {
 		// Slot must be within a bag
@@ -1379,9 +1423,16 @@ int16 EQ::InventoryProfile::_PutItem(int16 slot_id, ItemInstance* inst)
 			result = slot_id;
 		}
 	}
-	
+
+	if (slot) {
+		*slot = inst;
+		_AddToIndex(inst, _IndexBucket(slot_id), true);
+		result = slot_id;
+	}
+
 	if (result == INVALID_INDEX) {
 		LogError("InventoryProfile::_PutItem: Invalid slot_id specified ({}) with parent slot id ({})", slot_id, parentSlot);
+		_RemoveFromIndex(inst);
 		InventoryProfile::MarkDirty(inst); // Slot not found, clean up
 	}
 
@@ -1389,27 +1440,25 @@ int16 EQ::InventoryProfile::_PutItem(int16 slot_id, ItemInstance* inst)
 }
 
 // Internal Method: Checks an inventory bucket for a particular item
-int16 EQ::InventoryProfile::_HasItem(std::map<int16, ItemInstance*>& bucket, uint32 item_id, uint8 quantity)
+int16 EQ::InventoryProfile::_HasItem(ItemInstance** bucket, int16 begin, int16 end, uint32 item_id, uint8 quantity, uint32& quantity_found)
 {
-	uint32 quantity_found = 0;
-
-	for (auto iter = bucket.begin(); iter != bucket.end(); ++iter) {
-		if (iter->first <= EQ::invslot::POSSESSIONS_END && iter->first >= EQ::invslot::POSSESSIONS_BEGIN) {
-			if ((((uint64)1 << iter->first) & m_lookup->PossessionsBitmask) == 0)
+	for (int16 slot_id = begin; slot_id <= end; ++slot_id) {
+		if (slot_id <= EQ::invslot::POSSESSIONS_END && slot_id >= EQ::invslot::POSSESSIONS_BEGIN) {
+			if ((((uint64)1 << slot_id) & m_lookup->PossessionsBitmask) == 0)
 				continue;
 		}
-		else if (iter->first <= EQ::invslot::BANK_END && iter->first >= EQ::invslot::BANK_BEGIN) {
-			if (iter->first - EQ::invslot::BANK_BEGIN >= m_lookup->InventoryTypeSize.Bank)
+		else if (slot_id <= EQ::invslot::BANK_END && slot_id >= EQ::invslot::BANK_BEGIN) {
+			if (slot_id - EQ::invslot::BANK_BEGIN >= m_lookup->InventoryTypeSize.Bank)
 				continue;
 		}
 
-		auto inst = iter->second;
+		auto inst = bucket[slot_id - begin];
 		if (inst == nullptr) { continue; }
 
 		if (inst->GetID() == item_id) {
 			quantity_found += (inst->GetCharges() <= 0) ? 1 : inst->GetCharges();
 			if (quantity_found >= quantity)
-				return iter->first;
+				return slot_id;
 		}
 
 		for (int index = invaug::SOCKET_BEGIN; index <= invaug::SOCKET_END; ++index) {
@@ -1426,7 +1475,7 @@ int16 EQ::InventoryProfile::_HasItem(std::map<int16, ItemInstance*>& bucket, uin
 			if (bag_inst->GetID() == item_id) {
 				quantity_found += (bag_inst->GetCharges() <= 0) ? 1 : bag_inst->GetCharges();
 				if (quantity_found >= quantity)
-					return InventoryProfile::CalcSlotId(iter->first, bag_iter->first);
+					return InventoryProfile::CalcSlotId(slot_id, bag_iter->first);
 			}
 
 			for (int index = invaug::SOCKET_BEGIN; index <= invaug::SOCKET_END; ++index) {
@@ -1491,27 +1540,25 @@ int16 EQ::InventoryProfile::_HasItem(ItemInstQueue& iqueue, uint32 item_id, uint
 }
 
 // Internal Method: Checks an inventory bucket for a particular item
-int16 EQ::InventoryProfile::_HasItemByUse(std::map<int16, ItemInstance*>& bucket, uint8 use, uint8 quantity)
+int16 EQ::InventoryProfile::_HasItemByUse(ItemInstance** bucket, int16 begin, int16 end, uint8 use, uint8 quantity, uint32& quantity_found)
 {
-	uint32 quantity_found = 0;
-
-	for (auto iter = bucket.begin(); iter != bucket.end(); ++iter) {
-		if (iter->first <= EQ::invslot::POSSESSIONS_END && iter->first >= EQ::invslot::POSSESSIONS_BEGIN) {
-			if ((((uint64)1 << iter->first) & m_lookup->PossessionsBitmask) == 0)
+	for (int16 slot_id = begin; slot_id <= end; ++slot_id) {
+		if (slot_id <= EQ::invslot::POSSESSIONS_END && slot_id >= EQ::invslot::POSSESSIONS_BEGIN) {
+			if ((((uint64)1 << slot_id) & m_lookup->PossessionsBitmask) == 0)
 				continue;
 		}
-		else if (iter->first <= EQ::invslot::BANK_END && iter->first >= EQ::invslot::BANK_BEGIN) {
-			if (iter->first - EQ::invslot::BANK_BEGIN >= m_lookup->InventoryTypeSize.Bank)
+		else if (slot_id <= EQ::invslot::BANK_END && slot_id >= EQ::invslot::BANK_BEGIN) {
+			if (slot_id - EQ::invslot::BANK_BEGIN >= m_lookup->InventoryTypeSize.Bank)
 				continue;
 		}
 
-		auto inst = iter->second;
+		auto inst = bucket[slot_id - begin];
 		if (inst == nullptr) { continue; }
 
 		if (inst->IsClassCommon() && inst->GetItem()->ItemType == use) {
 			quantity_found += (inst->GetCharges() <= 0) ? 1 : inst->GetCharges();
 			if (quantity_found >= quantity)
-				return iter->first;
+				return slot_id;
 		}
 
 		if (!inst->IsClassBag()) { continue; }
@@ -1523,7 +1570,7 @@ int16 EQ::InventoryProfile::_HasItemByUse(std::map<int16, ItemInstance*>& bucket
 			if (bag_inst->IsClassCommon() && bag_inst->GetItem()->ItemType == use) {
 				quantity_found += (bag_inst->GetCharges() <= 0) ? 1 : bag_inst->GetCharges();
 				if (quantity_found >= quantity)
-					return InventoryProfile::CalcSlotId(iter->first, bag_iter->first);
+					return InventoryProfile::CalcSlotId(slot_id, bag_iter->first);
 			}
 		}
 	}
@@ -1566,23 +1613,23 @@ int16 EQ::InventoryProfile::_HasItemByUse(ItemInstQueue& iqueue, uint8 use, uint
 	return INVALID_INDEX;
 }
 
-int16 EQ::InventoryProfile::_HasItemByLoreGroup(std::map<int16, ItemInstance*>& bucket, uint32 loregroup)
+int16 EQ::InventoryProfile::_HasItemByLoreGroup(ItemInstance** bucket, int16 begin, int16 end, uint32 loregroup)
 {
-	for (auto iter = bucket.begin(); iter != bucket.end(); ++iter) {
-		if (iter->first <= EQ::invslot::POSSESSIONS_END && iter->first >= EQ::invslot::POSSESSIONS_BEGIN) {
-			if ((((uint64)1 << iter->first) & m_lookup->PossessionsBitmask) == 0)
+	for (int16 slot_id = begin; slot_id <= end; ++slot_id) {
+		if (slot_id <= EQ::invslot::POSSESSIONS_END && slot_id >= EQ::invslot::POSSESSIONS_BEGIN) {
+			if ((((uint64)1 << slot_id) & m_lookup->PossessionsBitmask) == 0)
 				continue;
 		}
-		else if (iter->first <= EQ::invslot::BANK_END && iter->first >= EQ::invslot::BANK_BEGIN) {
-			if (iter->first - EQ::invslot::BANK_BEGIN >= m_lookup->InventoryTypeSize.Bank)
+		else if (slot_id <= EQ::invslot::BANK_END && slot_id >= EQ::invslot::BANK_BEGIN) {
+			if (slot_id - EQ::invslot::BANK_BEGIN >= m_lookup->InventoryTypeSize.Bank)
 				continue;
 		}
 
-		auto inst = iter->second;
+		auto inst = bucket[slot_id - begin];
 		if (inst == nullptr) { continue; }
 
 		if (inst->GetItem()->LoreGroup == loregroup)
-			return iter->first;
+			return slot_id;
 
 		for (int index = invaug::SOCKET_BEGIN; index <= invaug::SOCKET_END; ++index) {
 			auto aug_inst = inst->GetAugment(index);
@@ -1599,7 +1646,7 @@ int16 EQ::InventoryProfile::_HasItemByLoreGroup(std::map<int16, ItemInstance*>&
 			if (bag_inst == nullptr) { continue; }
 
 			if (bag_inst->IsClassCommon() && bag_inst->GetItem()->LoreGroup == loregroup)
-				return InventoryProfile::CalcSlotId(iter->first, bag_iter->first);
+				return InventoryProfile::CalcSlotId(slot_id, bag_iter->first);
 
 			for (int index = invaug::SOCKET_BEGIN; index <= invaug::SOCKET_END; ++index) {
 				auto aug_inst = bag_inst->GetAugment(index);
@@ -1656,3 +1703,143 @@ int16 EQ::InventoryProfile::_HasItemByLoreGroup(ItemInstQueue& iqueue, uint32 lo
 	
 	return EQ::invslot::SLOT_INVALID;
 }
+
+uint32 EQ::InventoryProfile::CountItem(uint32 item_id, uint8 where) const
+{
+	auto iter = m_item_index.find(item_id);
+	if (iter == m_item_index.end())
+		return 0;
+
+	uint32 quantity = 0;
+	for (uint8 bucket = 0; bucket < IndexBucketCount; ++bucket) {
+		if (where & (1 << bucket))
+			quantity += iter->second.quantity[bucket];
+	}
+
+	return quantity;
+}
+
+// Internal Method: Indexes an item and its contents under a bucket, moving it from any bucket it was indexed in
+void EQ::InventoryProfile::_AddToIndex(ItemInstance* inst, uint8 bucket, bool counts_quantity)
+{
+	if (inst == nullptr)
+		return;
+
+	if (inst->m_owner)
+		inst->m_owner->_RemoveFromIndex(inst);
+
+	inst->m_owner = this;
+	inst->m_owner_bucket = bucket;
+	inst->m_owner_quantity = counts_quantity;
+	_IndexItem(inst, true);
+
+	// only bag contents add to quantities, anything else inside an item is an augment
+	bool is_bag = inst->IsClassBag();
+	for (auto iter = inst->_cbegin(); iter != inst->_cend(); ++iter)
+		_AddToIndex(iter->second, bucket, is_bag);
+}
+
+// Internal Method: Drops an item and its contents from the index
+void EQ::InventoryProfile::_RemoveFromIndex(ItemInstance* inst)
+{
+	if (inst == nullptr || inst->m_owner != this)
+		return;
+
+	for (auto iter = inst->_cbegin(); iter != inst->_cend(); ++iter)
+		_RemoveFromIndex(iter->second);
+
+	_IndexItem(inst, false);
+	inst->m_owner = nullptr;
+	inst->m_owner_bucket = 0;
+	inst->m_owner_quantity = false;
+}
+
+// Internal Method: Moves an indexed item's quantity to its new charge count
+void EQ::InventoryProfile::_IndexCharges(ItemInstance* inst, int16 charges)
+{
+	if (!inst->m_owner_quantity || inst->GetItem() == nullptr)
+		return;
+
+	_IndexItem(inst, false);
+	inst->m_charges = charges;
+	_IndexItem(inst, true);
+}
+
+uint8 EQ::InventoryProfile::_IndexBucket(int16 slot_id)
+{
+	if (slot_id == invslot::slotCursor)
+		return IndexCursor;
+	if ((slot_id >= invslot::EQUIPMENT_BEGIN && slot_id <= invslot::EQUIPMENT_END) ||
+		(slot_id >= invslot::TRIBUTE_BEGIN && slot_id <= invslot::TRIBUTE_END))
+		return IndexWorn;
+	if (slot_id >= invslot::GENERAL_BEGIN && slot_id <= invslot::GENERAL_END)
+		return IndexPersonal;
+	if (slot_id >= invslot::BANK_BEGIN && slot_id <= invslot::BANK_END)
+		return IndexBank;
+	if (slot_id >= invslot::SHARED_BANK_BEGIN && slot_id <= invslot::SHARED_BANK_END)
+		return IndexSharedBank;
+
+	return IndexTrading;
+}
+
+void EQ::InventoryProfile::_IndexItem(const ItemInstance* inst, bool add)
+{
+	auto item = inst->GetItem();
+	if (item == nullptr)
+		return;
+
+	uint32 quantity = 0;
+	if (inst->m_owner_quantity)
+		quantity = (inst->GetCharges() <= 0) ? 1 : inst->GetCharges();
+
+	_IndexCount(m_item_index, item->ID, inst->m_owner_bucket, add, quantity);
+	_IndexCount(m_use_index, item->ItemType, inst->m_owner_bucket, add, quantity);
+	_IndexCount(m_loregroup_index, item->LoreGroup, inst->m_owner_bucket, add, 0);
+}
+
+void EQ::InventoryProfile::_IndexCount(ItemIndex& index, uint32 key, uint8 bucket, bool add, uint32 quantity)
+{
+	if (add) {
+		auto& entry = index[key]; // value-initialized on first use
+		++entry.count[bucket];
+		entry.quantity[bucket] += quantity;
+		return;
+	}
+
+	auto iter = index.find(key);
+	if (iter == index.end())
+		return;
+
+	auto& entry = iter->second;
+	if (entry.count[bucket] > 0)
+		--entry.count[bucket];
+	entry.quantity[bucket] -= std::min(entry.quantity[bucket], quantity);
+
+	for (uint8 i = 0; i < IndexBucketCount; ++i) {
+		if (entry.count[i] > 0)
+			return;
+	}
+
+	index.erase(iter);
+}
+
+uint8 EQ::InventoryProfile::_IndexedWhere(const ItemIndex& index, uint32 key, uint8 quantity)
+{
+	auto iter = index.find(key);
+	if (iter == index.end())
+		return 0;
+
+	// quantities only ever overcount what a walk would find (the walks skip hidden slots and
+	// queued cursor items), so a bucket short of the quantity can't match
+	uint8 where = 0;
+	for (uint8 bucket = 0; bucket < IndexBucketCount; ++bucket) {
+		if (iter->second.count[bucket] == 0)
+			continue;
+		if (quantity > 1 && iter->second.quantity[bucket] < quantity)
+			continue;
+
+		where |= (1 << bucket);
+	}
+
+	return where;
+}
@@ -28,6 +28,7 @@
 #include "item_instance.h"
 
 #include <list>
+#include <unordered_map>
 
 
 //FatherNitwit: location bits for searching specific
@@ -85,7 +86,7 @@ namespace EQ
 		// Public Methods
 		///////////////////////////////
 
-		InventoryProfile() {
+		InventoryProfile() : m_worn(), m_tribute(), m_inv(), m_bank(), m_shbank(), m_trade() {
 			m_mob_version = versions::MobVersion::Unknown;
 			m_gm_inventory = false;
 			m_lookup = inventory::StaticLookup(versions::MobVersion::Unknown);
@@ -155,6 +156,11 @@ namespace EQ
 		// where argument specifies OR'd list of invWhere constants to look
 		int16 HasItemByLoreGroup(uint32 loregroup, uint8 where = 0xFF);
 
+		// Count the quantity of an item held in inventory, stacks counting their charges
+		// where argument specifies OR'd list of invWhere constants to look
+		// Includes bag contents and every cursor queue entry, but not augments
+		uint32 CountItem(uint32 item_id, uint8 where = 0xFF) const;
+
 		// Locate an available inventory slot
 		int16 FindFreeSlot(bool for_bag, bool try_cursor, uint8 min_size = 0, bool is_arrow = false);
 		int16 FindFreeSlotForTradeItem(const ItemInstance* inst, int16 general_start = invslot::GENERAL_BEGIN, uint8 bag_start = invbag::SLOT_BEGIN);
@@ -195,38 +201,70 @@ namespace EQ
 		// Protected Methods
 		///////////////////////////////
 
-		int GetSlotByItemInstCollection(const std::map<int16, ItemInstance*> &collection, ItemInstance *inst);
-		void dumpItemCollection(const std::map<int16, ItemInstance*> &collection);
-		void dumpBagContents(ItemInstance *inst, std::map<int16, ItemInstance*>::const_iterator *it);
+		int GetSlotByItemInstCollection(ItemInstance* const* bucket, int16 begin, int16 end, ItemInstance *inst);
+		void dumpItemCollection(ItemInstance* const* bucket, int16 begin, int16 end);
+		void dumpBagContents(ItemInstance *inst, int16 slot_id);
+
+		// Retrieves the bucket entry holding a top level slot, nullptr for bag and unknown slots
+		ItemInstance** _GetSlot(int16 slot_id);
+		ItemInstance* const* _GetSlot(int16 slot_id) const;
 
-		// Retrieves item within an inventory bucket
-		ItemInstance* _GetItem(const std::map<int16, ItemInstance*>& bucket, int16 slot_id) const;
+		// Retrieves item at a top level slot
+		ItemInstance* _GetItem(int16 slot_id) const;
 
 		// Private "put" item into bucket, without regard for what is currently in bucket
 		int16 _PutItem(int16 slot_id, ItemInstance* inst);
 
 		// Checks an inventory bucket for a particular item
-		int16 _HasItem(std::map<int16, ItemInstance*>& bucket, uint32 item_id, uint8 quantity);
+		int16 _HasItem(ItemInstance** bucket, int16 begin, int16 end, uint32 item_id, uint8 quantity, uint32& quantity_found);
 		int16 _HasItem(ItemInstQueue& iqueue, uint32 item_id, uint8 quantity);
-		int16 _HasItemByUse(std::map<int16, ItemInstance*>& bucket, uint8 use, uint8 quantity);
+		int16 _HasItemByUse(ItemInstance** bucket, int16 begin, int16 end, uint8 use, uint8 quantity, uint32& quantity_found);
 		int16 _HasItemByUse(ItemInstQueue& iqueue, uint8 use, uint8 quantity);
-		int16 _HasItemByLoreGroup(std::map<int16, ItemInstance*>& bucket, uint32 loregroup);
+		int16 _HasItemByLoreGroup(ItemInstance** bucket, int16 begin, int16 end, uint32 loregroup);
 		int16 _HasItemByLoreGroup(ItemInstQueue& iqueue, uint32 loregroup);
 
 
-		// Player inventory
-		std::map<int16, ItemInstance*>	m_worn;		// Items worn by character
-		std::map<int16, ItemInstance*>	m_inv;		// Items in character personal inventory
-		std::map<int16, ItemInstance*>	m_bank;		// Items in character bank
-		std::map<int16, ItemInstance*>	m_shbank;	// Items in character shared bank
-		std::map<int16, ItemInstance*>	m_trade;	// Items in a trade session
-		::ItemInstQueue					m_cursor;	// Items on cursor: FIFO
+		// Player inventory, indexed by slot_id - <bucket>_BEGIN
+		ItemInstance*	m_worn[invslot::EQUIPMENT_COUNT];										// Items worn by character
+		ItemInstance*	m_tribute[invslot::TRIBUTE_END - invslot::TRIBUTE_BEGIN + 1];			// Tribute items, searched as worn
+		ItemInstance*	m_inv[invslot::GENERAL_COUNT];											// Items in character personal inventory
+		ItemInstance*	m_bank[invslot::BANK_END - invslot::BANK_BEGIN + 1];					// Items in character bank
+		ItemInstance*	m_shbank[invslot::SHARED_BANK_END - invslot::SHARED_BANK_BEGIN + 1];	// Items in character shared bank
+		ItemInstance*	m_trade[invslot::TRADE_END - invslot::TRADE_BEGIN + 1];				// Items in a trade session
+		::ItemInstQueue	m_cursor;																// Items on cursor: FIFO
 
 	private:
+		// Index buckets, one per invWhere bit
+		enum : uint8 { IndexWorn = 0, IndexPersonal, IndexBank, IndexSharedBank, IndexTrading, IndexCursor, IndexBucketCount };
+
+		struct IndexEntry {
+			uint16 count[IndexBucketCount];		// Instances held, augments and bag contents included
+			uint32 quantity[IndexBucketCount];	// Charges of the non-augment instances
+		};
+		typedef std::unordered_map<uint32, IndexEntry> ItemIndex;
+
+		// Called by ItemInstance as owned items enter, leave or change charges
+		void _AddToIndex(ItemInstance* inst, uint8 bucket, bool counts_quantity);
+		void _RemoveFromIndex(ItemInstance* inst);
+		void _IndexCharges(ItemInstance* inst, int16 charges);
+
+		static uint8 _IndexBucket(int16 slot_id);
+		void _IndexItem(const ItemInstance* inst, bool add);
+		static void _IndexCount(ItemIndex& index, uint32 key, uint8 bucket, bool add, uint32 quantity);
+
+		// Narrows an invWhere mask to the buckets the index says can hold a match
+		static uint8 _IndexedWhere(const ItemIndex& index, uint32 key, uint8 quantity);
+
 		// Active mob version
 		versions::MobVersion m_mob_version;
 		bool m_gm_inventory;
 		const inventory::LookupEntry* m_lookup;
+
+		// Item id, item type and lore group of everything the profile holds, updated in place as
+		// items are put, popped or recharged. The bucket walks still decide the slot returned.
+		ItemIndex m_item_index;
+		ItemIndex m_use_index;
+		ItemIndex m_loregroup_index;
 	};
 }
 
@@ -85,6 +85,10 @@ EQ::ItemInstance::ItemInstance(const ItemData* item, int16 charges) {
 	m_ornament_hero_model = 0;
 	m_recast_timestamp = 0;
 	m_new_id_file = 0;
+
+	m_owner = nullptr;
+	m_owner_bucket = 0;
+	m_owner_quantity = false;
 }
 
 EQ::ItemInstance::ItemInstance(SharedDatabase *db, uint32 item_id, int16 charges) {
@@ -119,6 +123,10 @@ EQ::ItemInstance::ItemInstance(SharedDatabase *db, uint32 item_id, int16 charges
 	m_ornament_hero_model = 0;
 	m_recast_timestamp = 0;
 	m_new_id_file = 0;
+
+	m_owner = nullptr;
+	m_owner_bucket = 0;
+	m_owner_quantity = false;
 }
 
 EQ::ItemInstance::ItemInstance(ItemInstTypes use_type) {
@@ -141,6 +149,10 @@ EQ::ItemInstance::ItemInstance(ItemInstTypes use_type) {
 	m_ornament_hero_model = 0;
 	m_recast_timestamp = 0;
 	m_new_id_file = 0;
+
+	m_owner = nullptr;
+	m_owner_bucket = 0;
+	m_owner_quantity = false;
 }
 
 // Make a copy of an EQ::ItemInstance object
@@ -199,17 +211,33 @@ EQ::ItemInstance::ItemInstance(const ItemInstance& copy)
 	m_ornament_hero_model = copy.m_ornament_hero_model;
 	m_recast_timestamp = copy.m_recast_timestamp;
 	m_new_id_file = copy.m_new_id_file;
+
+	// a copy starts out unowned, whoever takes it indexes it
+	m_owner = nullptr;
+	m_owner_bucket = 0;
+	m_owner_quantity = false;
 }
 
 // Clean up container contents
 EQ::ItemInstance::~ItemInstance()
 {
+	if (m_owner)
+		m_owner->_RemoveFromIndex(this);
+
 	Clear();
 	safe_delete(m_item);
 	safe_delete(m_scaledItem);
 	safe_delete(m_evolveInfo);
 }
 
+void EQ::ItemInstance::SetCharges(int16 charges)
+{
+	if (m_owner)
+		m_owner->_IndexCharges(this, charges);
+
+	m_charges = charges;
+}
+
 // Query item type
 bool EQ::ItemInstance::IsType(item::ItemClass item_class) const
 {
@@ -379,12 +407,23 @@ EQ::ItemInstance* EQ::ItemInstance::PopItem(uint8 index)
 	if (iter != m_contents.end()) {
 		ItemInstance* inst = iter->second;
 		m_contents.erase(index);
+		if (m_owner && inst)
+			m_owner->_RemoveFromIndex(inst);
+
 		return inst; // Return pointer that needs to be deleted (or otherwise managed)
 	}
 	
 	return nullptr;
 }
 
+// Internal Method: "put" item into container, without regard for what is currently in the slot
+void EQ::ItemInstance::_PutItem(uint8 index, ItemInstance* inst)
+{
+	m_contents[index] = inst;
+	if (m_owner && inst)
+		m_owner->_AddToIndex(inst, m_owner_bucket, IsClassBag());
+}
+
 // Remove all items from container
 void EQ::ItemInstance::Clear()
 {
@@ -413,6 +452,9 @@ void EQ::ItemInstance::ClearByFlags(byFlagSetting is_nodrop, byFlagSetting is_no
 
 		const ItemData* item = inst->GetItem();
 		if (item == nullptr) {
+			if (inst->m_owner)
+				inst->m_owner->_RemoveFromIndex(inst);
+
 			cur = m_contents.erase(cur);
 			continue;
 		}
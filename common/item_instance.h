@@ -34,6 +34,7 @@ class EvolveInfo;			// Stores information about an evolving item family
 #include "../common/bodytypes.h"
 #include "../common/deity.h"
 #include "../common/memory_buffer.h"
+#include "../common/object_pool.h"
 
 #include <map>
 
@@ -79,6 +80,10 @@ namespace EQ
 
 		~ItemInstance();
 
+		// Repops and looting churn through instances, keep them off the general heap
+		static void* operator new(size_t size) { return ObjectPool<ItemInstance>::Allocate(size); }
+		static void operator delete(void* ptr, size_t size) { ObjectPool<ItemInstance>::Free(ptr, size); }
+
 		// Query item type
 		bool IsType(item::ItemClass item_class) const;
 
@@ -147,7 +152,7 @@ namespace EQ
 		const ItemData* GetUnscaledItem() const;
 
 		int16 GetCharges() const				{ return m_charges; }
-		void SetCharges(int16 charges)			{ m_charges = charges; }
+		void SetCharges(int16 charges);
 
 		uint32 GetPrice() const					{ return m_price; }
 		void SetPrice(uint32 price)				{ m_price = price; }
@@ -288,7 +293,13 @@ namespace EQ
 		std::map<uint8, ItemInstance*>::const_iterator _cbegin() { return m_contents.cbegin(); }
 		std::map<uint8, ItemInstance*>::const_iterator _cend() { return m_contents.cend(); }
 
-		void _PutItem(uint8 index, ItemInstance* inst) { m_contents[index] = inst; }
+		void _PutItem(uint8 index, ItemInstance* inst);
+
+		// Set while this instance is held by an InventoryProfile, which is told about
+		// content and charge changes so its item index stays current
+		InventoryProfile*	m_owner;
+		uint8				m_owner_bucket;		// Index bucket within the owning profile
+		bool				m_owner_quantity;	// Charges count toward the profile's item quantities
 
 		ItemInstTypes		m_use_type;	// Usage type for item
 		const ItemData*		m_item;		// Ptr to item data
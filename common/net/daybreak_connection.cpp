@@ -4,6 +4,7 @@
 #include "../data_verification.h"
 #include "crc32.h"
 #include <zlib.h>
+#include <cmath>
 #include <fmt/format.h>
 #include <sstream>
 
@@ -11,6 +12,7 @@ EQ::Net::DaybreakConnectionManager::DaybreakConnectionManager()
 {
 	m_attached = nullptr;
 	memset(&m_timer, 0, sizeof(uv_timer_t));
+	memset(&m_flush, 0, sizeof(uv_prepare_t));
 	memset(&m_socket, 0, sizeof(uv_udp_t));
 
 	Attach(EQ::EventLoop::Get().Handle());
@@ -21,6 +23,7 @@ EQ::Net::DaybreakConnectionManager::DaybreakConnectionManager(const DaybreakConn
 	m_attached = nullptr;
 	m_options = opts;
 	memset(&m_timer, 0, sizeof(uv_timer_t));
+	memset(&m_flush, 0, sizeof(uv_prepare_t));
 	memset(&m_socket, 0, sizeof(uv_udp_t));
 
 	Attach(EQ::EventLoop::Get().Handle());
@@ -46,6 +49,15 @@ void EQ::Net::DaybreakConnectionManager::Attach(uv_loop_t *loop)
 			c->ProcessResend();
 		}, update_rate, update_rate);
 
+		//prepare runs once per loop iteration right before it blocks, after everything queued this turn
+		uv_prepare_init(loop, &m_flush);
+		m_flush.data = this;
+		uv_prepare_start(&m_flush, [](uv_prepare_t *handle) {
+			DaybreakConnectionManager *c = (DaybreakConnectionManager*)handle->data;
+			c->FlushPending();
+		});
+		uv_unref((uv_handle_t*)&m_flush);
+
 		uv_udp_init(loop, &m_socket);
 		m_socket.data = this;
 		struct sockaddr_in recv_addr;
@@ -81,6 +93,7 @@ void EQ::Net::DaybreakConnectionManager::Detach()
 	if (m_attached) {
 		uv_udp_recv_stop(&m_socket);
 		uv_timer_stop(&m_timer);
+		uv_prepare_stop(&m_flush);
 		m_attached = nullptr;
 	}
 }
@@ -184,22 +197,41 @@ void EQ::Net::DaybreakConnectionManager::UpdateDataBudget()
 
 void EQ::Net::DaybreakConnectionManager::ProcessResend()
 {
-	auto iter = m_connections.begin();
-	while (iter != m_connections.end()) {
-		auto &connection = iter->second;
-		auto status = connection->m_status;
+	auto now = Clock::now();
+	while (!m_resend_timers.empty() && m_resend_timers.top().deadline <= now) {
+		auto timer = m_resend_timers.top();
+		m_resend_timers.pop();
 
-		switch (status)
-		{
-			case StatusConnected:
-			case StatusDisconnecting:
-				connection->ProcessResend();
-				break;
-			default:
-				break;
+		auto connection = timer.connection.lock();
+		if (connection) {
+			connection->ProcessResend(timer.stream, timer.sequence, timer.deadline, now);
 		}
+	}
+}
 
-		iter++;
+void EQ::Net::DaybreakConnectionManager::FlushPending()
+{
+	if (m_pending_flush.empty()) {
+		return;
+	}
+
+	std::vector<std::weak_ptr<DaybreakConnection>> pending;
+	pending.swap(m_pending_flush);
+	for (auto &c : pending) {
+		auto connection = c.lock();
+		if (!connection) {
+			continue;
+		}
+
+		connection->m_flush_pending = false;
+		try {
+			connection->FlushBuffer();
+		}
+		catch (std::exception &ex) {
+			if (m_on_error_message) {
+				m_on_error_message(fmt::format("Error flushing connection: {0}", ex.what()));
+			}
+		}
 	}
 }
 
@@ -302,7 +334,12 @@ EQ::Net::DaybreakConnection::DaybreakConnection(DaybreakConnectionManager *owner
 	m_encode_passes[1] = owner->m_options.encode_passes[1];
 	m_hold_time = Clock::now();
 	m_buffered_packets_length = 0;
+	memset(m_buffered_acks, 0, sizeof(m_buffered_acks));
+	m_flush_pending = false;
 	m_rolling_ping = 500;
+	m_rtt_smoothed = 0.0;
+	m_rtt_variance = 0.0;
+	m_rtt_sampled = false;
 	m_combined.reset(new char[512]);
 	m_combined[0] = 0;
 	m_combined[1] = OP_Combined;
@@ -325,7 +362,12 @@ EQ::Net::DaybreakConnection::DaybreakConnection(DaybreakConnectionManager *owner
 	m_crc_bytes = 0;
 	m_hold_time = Clock::now();
 	m_buffered_packets_length = 0;
+	memset(m_buffered_acks, 0, sizeof(m_buffered_acks));
+	m_flush_pending = false;
 	m_rolling_ping = 500;
+	m_rtt_smoothed = 0.0;
+	m_rtt_variance = 0.0;
+	m_rtt_sampled = false;
 	m_combined.reset(new char[512]);
 	m_combined[0] = 0;
 	m_combined[1] = OP_Combined;
@@ -393,7 +435,7 @@ void EQ::Net::DaybreakConnection::Process()
 	try {
 		auto now = Clock::now();
 		auto time_since_hold = (size_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - m_hold_time).count();
-		if (time_since_hold >= m_owner->m_options.hold_length_ms) {
+		if (m_owner->m_options.adaptive_combine || time_since_hold >= m_owner->m_options.hold_length_ms) {
 			FlushBuffer();
 		}
 
@@ -891,6 +933,16 @@ void EQ::Net::DaybreakConnection::ChangeStatus(DbProtocolStatus new_status)
 	m_status = new_status;
 }
 
+bool EQ::Net::DaybreakConnection::IsAck(Packet &p) const
+{
+	if (p.Length() < 2 || p.GetInt8(0) != 0) {
+		return false;
+	}
+
+	auto opcode = p.GetInt8(1);
+	return (opcode >= OP_OutOfOrderAck && opcode <= OP_OutOfOrderAck4) || (opcode >= OP_Ack && opcode <= OP_Ack4);
+}
+
 bool EQ::Net::DaybreakConnection::PacketCanBeEncoded(Packet &p) const
 {
 	if (p.Length() < 2) {
@@ -1025,7 +1077,8 @@ void EQ::Net::DaybreakConnection::Decompress(Packet &p, size_t offset, size_t le
 		return;
 	}
 
-	static uint8_t new_buffer[4096];
+	//one per thread, managers can run on different loops
+	static thread_local uint8_t new_buffer[4096];
 	uint8_t *buffer = (uint8_t*)p.Data() + offset;
 	uint32_t new_length = 0;
 
@@ -1066,119 +1119,166 @@ void EQ::Net::DaybreakConnection::Compress(Packet &p, size_t offset, size_t leng
 	p.PutData(offset, new_buffer, new_length);
 }
 
-void EQ::Net::DaybreakConnection::ProcessResend()
+EQ::Net::DaybreakConnection::DaybreakSentPacket *EQ::Net::DaybreakConnection::FindSentPacket(int stream, uint16_t seq)
 {
-	for (int i = 0; i < 4; ++i) {
-		ProcessResend(i);
+	auto s = &m_streams[stream];
+	uint16_t front = s->sequence_out - (uint16_t)s->sent_packets.size();
+	uint16_t index = seq - front;
+	if (index >= s->sent_packets.size()) {
+		return nullptr;
 	}
+
+	return &s->sent_packets[index];
+}
+
+EQ::Net::DaybreakConnection::DaybreakSentPacket &EQ::Net::DaybreakConnection::TrackSentPacket(int stream, DaybreakSentPacket &&sent)
+{
+	auto now = Clock::now();
+	auto s = &m_streams[stream];
+
+	sent.last_sent = now;
+	sent.first_sent = now;
+	sent.times_resent = 0;
+	sent.resend_delay = GetResendDelay();
+	sent.resend_at = now + std::chrono::milliseconds(sent.resend_delay);
+	sent.acked = false;
+	s->sent_packets.push_back(std::move(sent));
+
+	DaybreakResendTimer timer;
+	timer.deadline = s->sent_packets.back().resend_at;
+	timer.connection = m_self;
+	timer.sequence = s->sequence_out;
+	timer.stream = stream;
+	m_owner->m_resend_timers.push(timer);
+
+	s->sequence_out++;
+	return s->sent_packets.back();
 }
 
-void EQ::Net::DaybreakConnection::ProcessResend(int stream)
+void EQ::Net::DaybreakConnection::ProcessResend(int stream, uint16_t seq, Timestamp deadline, Timestamp now)
 {
 	if (m_status == DbProtocolStatus::StatusDisconnected) {
 		return;
 	}
-	
-	auto resends = 0;
-	auto now = Clock::now();
-	auto s = &m_streams[stream];
-	for (auto &entry : s->sent_packets) {
-		auto time_since_last_send = std::chrono::duration_cast<std::chrono::milliseconds>(now - entry.second.last_sent);
-		if (entry.second.times_resent == 0) {
-			if ((size_t)time_since_last_send.count() > entry.second.resend_delay) {
-				auto &p = entry.second.packet;
-				if (p.Length() >= DaybreakHeader::size()) {
-					if (p.GetInt8(0) == 0 && p.GetInt8(1) >= OP_Fragment && p.GetInt8(1) <= OP_Fragment4) {
-						m_stats.resent_fragments++;
-					}
-					else {
-						m_stats.resent_full++;
-					}
-				}
-				else {
-					m_stats.resent_full++;
-				}
-				m_stats.resent_packets++;
 
-				InternalBufferedSend(p);
-				entry.second.last_sent = now;
-				entry.second.times_resent++;
-				entry.second.resend_delay = EQ::Clamp(entry.second.resend_delay * 2, m_owner->m_options.resend_delay_min, m_owner->m_options.resend_delay_max);
-				resends++;
-			}
+	auto sent = FindSentPacket(stream, seq);
+	if (sent == nullptr || sent->acked || sent->resend_at != deadline) {
+		return;
+	}
+
+	DaybreakResendTimer timer;
+	timer.connection = m_self;
+	timer.sequence = seq;
+	timer.stream = stream;
+
+	if (m_status != StatusConnected && m_status != StatusDisconnecting) {
+		sent->resend_at = now + std::chrono::milliseconds(sent->resend_delay);
+		timer.deadline = sent->resend_at;
+		m_owner->m_resend_timers.push(timer);
+		return;
+	}
+
+	if (sent->times_resent > 0) {
+		auto time_since_first_sent = std::chrono::duration_cast<std::chrono::milliseconds>(now - sent->first_sent);
+		if (time_since_first_sent.count() >= m_owner->m_options.resend_timeout) {
+			Close();
+			return;
 		}
-		else {
-			auto time_since_first_sent = std::chrono::duration_cast<std::chrono::milliseconds>(now - entry.second.first_sent);
-			if (time_since_first_sent.count() >= m_owner->m_options.resend_timeout) {
-				Close();
-				return;
-			}
-	
-			if ((size_t)time_since_last_send.count() > entry.second.resend_delay) {
-				auto &p = entry.second.packet;
-				if (p.Length() >= DaybreakHeader::size()) {
-					if (p.GetInt8(0) == 0 && p.GetInt8(1) >= OP_Fragment && p.GetInt8(1) <= OP_Fragment4) {
-						m_stats.resent_fragments++;
-					}
-					else {
-						m_stats.resent_full++;
-					}
-				}
-				else {
-					m_stats.resent_full++;
-				}
-				m_stats.resent_packets++;
+	}
 
-				InternalBufferedSend(p);
-				entry.second.last_sent = now;
-				entry.second.times_resent++;
-				entry.second.resend_delay = EQ::Clamp(entry.second.resend_delay * 2, m_owner->m_options.resend_delay_min, m_owner->m_options.resend_delay_max);
-				resends++;
-			}
+	auto &p = sent->packet;
+	if (p.Length() >= DaybreakHeader::size()) {
+		if (p.GetInt8(0) == 0 && p.GetInt8(1) >= OP_Fragment && p.GetInt8(1) <= OP_Fragment4) {
+			m_stats.resent_fragments++;
+		}
+		else {
+			m_stats.resent_full++;
 		}
 	}
+	else {
+		m_stats.resent_full++;
+	}
+	m_stats.resent_packets++;
+
+	InternalBufferedSend(p);
+	sent->last_sent = now;
+	sent->times_resent++;
+	sent->resend_delay = EQ::Clamp(sent->resend_delay * 2, m_owner->m_options.resend_delay_min, m_owner->m_options.resend_delay_max);
+	sent->resend_at = now + std::chrono::milliseconds(sent->resend_delay);
+
+	timer.deadline = sent->resend_at;
+	m_owner->m_resend_timers.push(timer);
 }
 
 void EQ::Net::DaybreakConnection::Ack(int stream, uint16_t seq)
 {
+	auto sent = FindSentPacket(stream, seq);
+	if (sent == nullptr) {
+		return;
+	}
 
-	auto now = Clock::now();
+	//packets that were resent can not tell which send the ack is for
+	if (!sent->acked && sent->times_resent == 0) {
+		UpdateRoundTrip((uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - sent->last_sent).count());
+	}
+
+	//the ack covers everything up to and including seq
 	auto s = &m_streams[stream];
-	auto iter = s->sent_packets.begin();
-	while (iter != s->sent_packets.end()) {
-		auto order = CompareSequence(seq, iter->first);
+	uint16_t front = s->sequence_out - (uint16_t)s->sent_packets.size();
+	size_t count = (size_t)(uint16_t)(seq - front) + 1;
+	s->sent_packets.erase(s->sent_packets.begin(), s->sent_packets.begin() + count);
+}
 
-		if (order != SequenceFuture) {
-			uint64_t round_time = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - iter->second.last_sent).count();
+void EQ::Net::DaybreakConnection::OutOfOrderAck(int stream, uint16_t seq)
+{
+	auto sent = FindSentPacket(stream, seq);
+	if (sent == nullptr || sent->acked) {
+		return;
+	}
 
-			m_stats.max_ping = std::max(m_stats.max_ping, round_time);
-			m_stats.min_ping = std::min(m_stats.min_ping, round_time);
-			m_stats.last_ping = round_time;
-			m_rolling_ping = (m_rolling_ping * 2 + round_time) / 3;
+	if (sent->times_resent == 0) {
+		UpdateRoundTrip((uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - sent->last_sent).count());
+	}
 
-			iter = s->sent_packets.erase(iter);
-		}
-		else {
-			++iter;
-		}
+	sent->acked = true;
+	sent->packet.Clear();
+
+	auto s = &m_streams[stream];
+	while (!s->sent_packets.empty() && s->sent_packets.front().acked) {
+		s->sent_packets.pop_front();
 	}
 }
 
-void EQ::Net::DaybreakConnection::OutOfOrderAck(int stream, uint16_t seq)
+void EQ::Net::DaybreakConnection::UpdateRoundTrip(uint64_t round_time)
 {
-	auto now = Clock::now();
-	auto s = &m_streams[stream];
-	auto iter = s->sent_packets.find(seq);
-	if (iter != s->sent_packets.end()) {
-		uint64_t round_time = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - iter->second.last_sent).count();
+	m_stats.max_ping = std::max(m_stats.max_ping, round_time);
+	m_stats.min_ping = std::min(m_stats.min_ping, round_time);
+	m_stats.last_ping = round_time;
 
-		m_stats.max_ping = std::max(m_stats.max_ping, round_time);
-		m_stats.min_ping = std::min(m_stats.min_ping, round_time);
-		m_stats.last_ping = round_time;
-		m_rolling_ping = (m_rolling_ping * 2 + round_time) / 3;
-
-		s->sent_packets.erase(iter);
+	//smoothed round trip and its mean deviation, as TCP estimates them (RFC 6298)
+	double sample = (double)round_time;
+	if (!m_rtt_sampled) {
+		m_rtt_smoothed = sample;
+		m_rtt_variance = sample / 2.0;
+		m_rtt_sampled = true;
+	}
+	else {
+		m_rtt_variance = 0.75 * m_rtt_variance + 0.25 * std::abs(m_rtt_smoothed - sample);
+		m_rtt_smoothed = 0.875 * m_rtt_smoothed + 0.125 * sample;
 	}
+
+	m_rolling_ping = (size_t)m_rtt_smoothed;
+}
+
+size_t EQ::Net::DaybreakConnection::GetResendDelay() const
+{
+	auto &opts = m_owner->m_options;
+	double variance = std::max((double)opts.resend_delay_ms, 4.0 * m_rtt_variance);
+
+	return EQ::Clamp(
+		static_cast<size_t>((m_rolling_ping * opts.resend_delay_factor) + variance),
+		opts.resend_delay_min,
+		opts.resend_delay_max);
 }
 
 void EQ::Net::DaybreakConnection::UpdateDataBudget(double budget_add)
@@ -1194,10 +1294,21 @@ void EQ::Net::DaybreakConnection::SendAck(int stream_id, uint16_t seq)
 	ack.opcode = OP_Ack + stream_id;
 	ack.sequence = HostToNetwork(seq);
 
+	//acks are cumulative, one still waiting in the buffer can just be moved up to this sequence
+	if (m_owner->m_options.adaptive_combine && m_buffered_acks[stream_id]) {
+		m_buffered_acks[stream_id]->PutSerialize(0, ack);
+		m_stats.coalesced_acks++;
+		return;
+	}
+
 	DynamicPacket p;
 	p.PutSerialize(0, ack);
 
 	InternalBufferedSend(p);
+
+	if (m_owner->m_options.adaptive_combine && !m_buffered_packets.empty()) {
+		m_buffered_acks[stream_id] = &m_buffered_packets.back();
+	}
 }
 
 void EQ::Net::DaybreakConnection::SendOutOfOrderAck(int stream_id, uint16_t seq)
@@ -1238,11 +1349,21 @@ void EQ::Net::DaybreakConnection::InternalBufferedSend(Packet &p)
 		FlushBuffer();
 	}
 
-	DynamicPacket copy;
-	copy.PutPacket(0, p);
-	m_buffered_packets.push_back(copy);
+	m_buffered_packets.emplace_back();
+	m_buffered_packets.back().PutPacket(0, p);
 	m_buffered_packets_length += p.Length();
 
+	if (m_owner->m_options.adaptive_combine) {
+		//a buffer of nothing but acks waits for the next tick in Process, anything else goes out
+		//once this turn of the loop is done and takes the acks with it
+		if (!m_flush_pending && !IsAck(p)) {
+			m_flush_pending = true;
+			m_owner->m_pending_flush.push_back(m_self);
+		}
+
+		return;
+	}
+
 	if (m_buffered_packets_length + m_buffered_packets.size() > m_owner->m_options.hold_size) {
 		FlushBuffer();
 	}
@@ -1299,7 +1420,11 @@ void EQ::Net::DaybreakConnection::InternalSend(Packet &p)
 
 		m_stats.bytes_before_encode += p.Length();
 
-		DynamicPacket out;
+		//encode straight into the buffer handed to libuv, each compression pass can add a flag byte
+		size_t capacity = p.Length() + 2 + m_crc_bytes;
+		char *data = new char[capacity];
+		StaticPacket out(data, capacity);
+		out.Resize(0);
 		out.PutPacket(0, p);
 
 		for (int i = 0; i < 2; ++i) {
@@ -1329,8 +1454,6 @@ void EQ::Net::DaybreakConnection::InternalSend(Packet &p)
 		uv_ip4_addr(m_endpoint.c_str(), m_port, &send_addr);
 		uv_buf_t send_buffers[1];
 
-		char *data = new char[out.Length()];
-		memcpy(data, out.Data(), out.Length());
 		send_buffers[0] = uv_buf_init(data, out.Length());
 		send_req->data = send_buffers[0].base;
 
@@ -1395,80 +1518,45 @@ void EQ::Net::DaybreakConnection::InternalQueuePacket(Packet &p, int stream_id,
 
 		size_t used = 0;
 		size_t sublen = m_max_packet_size - m_crc_bytes - DaybreakReliableFragmentHeader::size();
-		DynamicPacket first_packet;
-		first_packet.PutSerialize(0, first_header);
-		first_packet.PutData(DaybreakReliableFragmentHeader::size(), (char*)p.Data() + used, sublen);
-		used += sublen;
 
+		//built once in the resend list and sent from there
 		DaybreakSentPacket sent;
-		sent.packet.PutPacket(0, first_packet);
-		sent.last_sent = Clock::now();
-		sent.first_sent = Clock::now();
-		sent.times_resent = 0;
-		sent.resend_delay = EQ::Clamp(
-			static_cast<size_t>((m_rolling_ping * m_owner->m_options.resend_delay_factor) + m_owner->m_options.resend_delay_ms), 
-			m_owner->m_options.resend_delay_min, 
-			m_owner->m_options.resend_delay_max);
-		stream->sent_packets.insert(std::make_pair(stream->sequence_out, sent));
-		stream->sequence_out++;
-
-		InternalBufferedSend(first_packet);
+		sent.packet.Reserve(DaybreakReliableFragmentHeader::size() + sublen);
+		sent.packet.PutSerialize(0, first_header);
+		sent.packet.PutData(DaybreakReliableFragmentHeader::size(), (char*)p.Data() + used, sublen);
+		used += sublen;
+
+		InternalBufferedSend(TrackSentPacket(stream_id, std::move(sent)).packet);
 
 		while (used < length) {
 			auto left = length - used;
-			DynamicPacket packet;
+			auto chunk = left > max_raw_size ? max_raw_size : left;
 			DaybreakReliableHeader header;
 			header.zero = 0;
 			header.opcode = OP_Fragment + stream_id;
 			header.sequence = HostToNetwork(stream->sequence_out);
-			packet.PutSerialize(0, header);
-
-			if (left > max_raw_size) {
-				packet.PutData(DaybreakReliableHeader::size(), (char*)p.Data() + used, max_raw_size);
-				used += max_raw_size;
-			}
-			else {
-				packet.PutData(DaybreakReliableHeader::size(), (char*)p.Data() + used, left);
-				used += left;
-			}
 
 			DaybreakSentPacket sent;
-			sent.packet.PutPacket(0, packet);
-			sent.last_sent = Clock::now();
-			sent.first_sent = Clock::now();
-			sent.times_resent = 0;
-			sent.resend_delay = EQ::Clamp(
-				static_cast<size_t>((m_rolling_ping * m_owner->m_options.resend_delay_factor) + m_owner->m_options.resend_delay_ms),
-				m_owner->m_options.resend_delay_min,
-				m_owner->m_options.resend_delay_max);
-			stream->sent_packets.insert(std::make_pair(stream->sequence_out, sent));
-			stream->sequence_out++;
-
-			InternalBufferedSend(packet);
+			sent.packet.Reserve(DaybreakReliableHeader::size() + chunk);
+			sent.packet.PutSerialize(0, header);
+			sent.packet.PutData(DaybreakReliableHeader::size(), (char*)p.Data() + used, chunk);
+			used += chunk;
+
+			InternalBufferedSend(TrackSentPacket(stream_id, std::move(sent)).packet);
 		}
 	}
 	else {
-		DynamicPacket packet;
 		DaybreakReliableHeader header;
 		header.zero = 0;
 		header.opcode = OP_Packet + stream_id;
 		header.sequence = HostToNetwork(stream->sequence_out);
-		packet.PutSerialize(0, header);
-		packet.PutPacket(DaybreakReliableHeader::size(), p);
 
 		DaybreakSentPacket sent;
-		sent.packet.PutPacket(0, packet);
-		sent.last_sent = Clock::now();
-		sent.first_sent = Clock::now();
-		sent.times_resent = 0;
-		sent.resend_delay = EQ::Clamp(
-			static_cast<size_t>((m_rolling_ping * m_owner->m_options.resend_delay_factor) + m_owner->m_options.resend_delay_ms),
-			m_owner->m_options.resend_delay_min,
-			m_owner->m_options.resend_delay_max);
-		stream->sent_packets.insert(std::make_pair(stream->sequence_out, sent));
-		stream->sequence_out++;
-
-		InternalBufferedSend(packet);
+		sent.packet.Reserve(DaybreakReliableHeader::size() + length);
+		sent.packet.PutSerialize(0, header);
+		sent.packet.PutPacket(DaybreakReliableHeader::size(), p);
+
+		InternalBufferedSend(TrackSentPacket(stream_id, std::move(sent)).packet);
 	}
 }
 
@@ -1488,6 +1576,8 @@ void EQ::Net::DaybreakConnection::FlushBuffer()
 		}
 
 		out.Resize(length);
+		m_stats.combined_datagrams++;
+		m_stats.combined_packets += m_buffered_packets.size();
 		InternalSend(out);
 	}
 	else {
@@ -1497,6 +1587,7 @@ void EQ::Net::DaybreakConnection::FlushBuffer()
 
 	m_buffered_packets.clear();
 	m_buffered_packets_length = 0;
+	memset(m_buffered_acks, 0, sizeof(m_buffered_acks));
 }
 
 EQ::Net::SequenceOrder EQ::Net::DaybreakConnection::CompareSequence(uint16_t expected, uint16_t actual) const
@@ -9,6 +9,8 @@
 #include <memory>
 #include <map>
 #include <queue>
+#include <deque>
+#include <vector>
 #include <list>
 
 namespace EQ
@@ -93,6 +95,9 @@ namespace EQ
 				datarate_remaining = 0.0;
 				bytes_after_decode = 0;
 				bytes_before_encode = 0;
+				combined_datagrams = 0;
+				combined_packets = 0;
+				coalesced_acks = 0;
 			}
 
 			void Reset() {
@@ -109,6 +114,9 @@ namespace EQ
 				datarate_remaining = 0.0;
 				bytes_after_decode = 0;
 				bytes_before_encode = 0;
+				combined_datagrams = 0;
+				combined_packets = 0;
+				coalesced_acks = 0;
 			}
 
 			uint64_t recv_bytes;
@@ -131,6 +139,9 @@ namespace EQ
 			double datarate_remaining;
 			uint64_t bytes_after_decode;
 			uint64_t bytes_before_encode;
+			uint64_t combined_datagrams; //datagrams sent as OP_Combined
+			uint64_t combined_packets; //protocol packets that went out inside them
+			uint64_t coalesced_acks; //acks folded into an ack already waiting in the buffer
 		};
 
 		class DaybreakConnectionManager;
@@ -174,10 +185,15 @@ namespace EQ
 			Timestamp m_hold_time;
 			std::list<DynamicPacket> m_buffered_packets;
 			size_t m_buffered_packets_length;
+			DynamicPacket *m_buffered_acks[4];
+			bool m_flush_pending;
 			std::unique_ptr<char[]> m_combined;
 			DaybreakConnectionStats m_stats;
 			Timestamp m_last_session_stats;
 			size_t m_rolling_ping;
+			double m_rtt_smoothed;
+			double m_rtt_variance;
+			bool m_rtt_sampled;
 			Timestamp m_close_time;
 			double m_outgoing_budget;
 
@@ -186,8 +202,10 @@ namespace EQ
 				DynamicPacket packet;
 				Timestamp last_sent;
 				Timestamp first_sent;
+				Timestamp resend_at;
 				size_t times_resent;
 				size_t resend_delay;
+				bool acked;
 			};
 
 			struct DaybreakStream
@@ -207,7 +225,8 @@ namespace EQ
 				uint32_t fragment_current_bytes;
 				uint32_t fragment_total_bytes;
 
-				std::map<uint16_t, DaybreakSentPacket> sent_packets;
+				//unacked reliable packets in sequence order, the front one is sequence_out - sent_packets.size()
+				std::deque<DaybreakSentPacket> sent_packets;
 			};
 
 			DaybreakStream m_streams[4];
@@ -223,14 +242,18 @@ namespace EQ
 			bool ValidateCRC(Packet &p);
 			void AppendCRC(Packet &p);
 			bool PacketCanBeEncoded(Packet &p) const;
+			bool IsAck(Packet &p) const;
 			void Decode(Packet &p, size_t offset, size_t length);
 			void Encode(Packet &p, size_t offset, size_t length);
 			void Decompress(Packet &p, size_t offset, size_t length);
 			void Compress(Packet &p, size_t offset, size_t length);
-			void ProcessResend();
-			void ProcessResend(int stream);
+			DaybreakSentPacket *FindSentPacket(int stream, uint16_t seq);
+			DaybreakSentPacket &TrackSentPacket(int stream, DaybreakSentPacket &&sent);
+			void ProcessResend(int stream, uint16_t seq, Timestamp deadline, Timestamp now);
 			void Ack(int stream, uint16_t seq);
 			void OutOfOrderAck(int stream, uint16_t seq);
+			void UpdateRoundTrip(uint64_t round_time);
+			size_t GetResendDelay() const;
 			void UpdateDataBudget(double budget_add);
 
 			void SendConnect();
@@ -272,6 +295,7 @@ namespace EQ
 				resend_timeout = 30000;
 				connection_close_time = 2000;
 				outgoing_data_rate = 0.0;
+				adaptive_combine = false;
 			}
 
 			size_t max_packet_size;
@@ -295,6 +319,20 @@ namespace EQ
 			DaybreakEncodeType encode_passes[2];
 			int port;
 			double outgoing_data_rate;
+			//ignore hold_size/hold_length_ms and combine up to the max packet size, data is flushed right
+			//before the loop waits for io and acks on their own wait for the next tic, with only the
+			//newest cumulative ack per stream kept
+			bool adaptive_combine;
+		};
+
+		struct DaybreakResendTimer
+		{
+			Timestamp deadline;
+			std::weak_ptr<DaybreakConnection> connection;
+			uint16_t sequence;
+			int stream;
+
+			bool operator>(const DaybreakResendTimer &o) const { return deadline > o.deadline; }
 		};
 
 		class DaybreakConnectionManager
@@ -308,6 +346,7 @@ namespace EQ
 			void Process();
 			void UpdateDataBudget();
 			void ProcessResend();
+			void FlushPending();
 			void OnNewConnection(std::function<void(std::shared_ptr<DaybreakConnection>)> func) { m_on_new_connection = func; }
 			void OnConnectionStateChange(std::function<void(std::shared_ptr<DaybreakConnection>, DbProtocolStatus, DbProtocolStatus)> func) { m_on_connection_state_change = func; }
 			void OnPacketRecv(std::function<void(std::shared_ptr<DaybreakConnection>, const Packet &)> func) { m_on_packet_recv = func; }
@@ -320,6 +359,7 @@ namespace EQ
 
 			EQ::Random m_rand;
 			uv_timer_t m_timer;
+			uv_prepare_t m_flush;
 			uv_udp_t m_socket;
 			uv_loop_t *m_attached;
 			DaybreakConnectionManagerOptions m_options;
@@ -328,6 +368,11 @@ namespace EQ
 			std::function<void(std::shared_ptr<DaybreakConnection>, const Packet&)> m_on_packet_recv;
 			std::function<void(const std::string&)> m_on_error_message;
 			std::map<std::pair<std::string, int>, std::shared_ptr<DaybreakConnection>> m_connections;
+			std::vector<std::weak_ptr<DaybreakConnection>> m_pending_flush;
+
+			//every reliable packet in flight keyed by when it is next due for a resend, acked and
+			//rescheduled packets are skipped when their stale entries come up
+			std::priority_queue<DaybreakResendTimer, std::vector<DaybreakResendTimer>, std::greater<DaybreakResendTimer>> m_resend_timers;
 
 			void ProcessPacket(const std::string &endpoint, int port, const char *data, size_t size);
 			std::shared_ptr<DaybreakConnection> FindConnectionByEndpoint(std::string addr, int port);
@@ -1,37 +1,148 @@
 #include "eqstream.h"
 #include "../eqemu_logsys.h"
+#include <future>
 
-EQ::Net::EQStreamManager::EQStreamManager(const EQStreamManagerInterfaceOptions &options) : EQStreamManagerInterface(options), m_daybreak(options.daybreak_options)
+EQ::Net::EQStreamManager::EQStreamManager(const EQStreamManagerInterfaceOptions &options) : EQStreamManagerInterface(options)
 {
-	m_daybreak.OnNewConnection(std::bind(&EQStreamManager::DaybreakNewConnection, this, std::placeholders::_1));
-	m_daybreak.OnConnectionStateChange(std::bind(&EQStreamManager::DaybreakConnectionStateChange, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-	m_daybreak.OnPacketRecv(std::bind(&EQStreamManager::DaybreakPacketRecv, this, std::placeholders::_1, std::placeholders::_2));
+	m_threaded = options.io_thread;
+	m_loop = &EQ::EventLoop::Get();
+	m_io_loop = nullptr;
+	m_alive = std::make_shared<bool>(true);
+
+	if (!m_threaded) {
+		CreateDaybreak();
+		return;
+	}
+
+	std::promise<EQ::EventLoop*> started;
+	auto io_loop = started.get_future();
+	m_io_thread = std::thread([this, &started]() {
+		auto &loop = EQ::EventLoop::Get();
+		CreateDaybreak();
+		started.set_value(&loop);
+		loop.Run();
+		m_daybreak.reset();
+	});
+
+	m_io_loop = io_loop.get();
+	LogNetcode("Daybreak running on a dedicated io thread for port [{}]", options.daybreak_options.port);
 }
 
 EQ::Net::EQStreamManager::~EQStreamManager()
 {
+	StopIOThread();
 }
 
 void EQ::Net::EQStreamManager::SetOptions(const EQStreamManagerInterfaceOptions &options)
 {
 	m_options = options;
-	auto &opts = m_daybreak.GetOptions();
+
+	if (m_io_loop) {
+		//the options are too large to capture inline, this only runs on a settings change
+		std::unique_ptr<DaybreakConnectionManagerOptions> daybreak_options(new DaybreakConnectionManagerOptions(options.daybreak_options));
+		m_io_loop->Post([this, daybreak_options = std::move(daybreak_options)]() {
+			m_daybreak->GetOptions() = *daybreak_options;
+		});
+		return;
+	}
+
+	auto &opts = m_daybreak->GetOptions();
 	opts = options.daybreak_options;
 }
 
+void EQ::Net::EQStreamManager::CreateDaybreak()
+{
+	m_daybreak.reset(new DaybreakConnectionManager(m_options.daybreak_options));
+	m_daybreak->OnNewConnection(std::bind(&EQStreamManager::DaybreakNewConnection, this, std::placeholders::_1));
+	m_daybreak->OnConnectionStateChange(std::bind(&EQStreamManager::DaybreakConnectionStateChange, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+	m_daybreak->OnPacketRecv(std::bind(&EQStreamManager::DaybreakPacketRecv, this, std::placeholders::_1, std::placeholders::_2));
+}
+
+void EQ::Net::EQStreamManager::StopIOThread()
+{
+	if (!m_io_thread.joinable()) {
+		return;
+	}
+
+	m_io_loop->Post([this]() {
+		m_daybreak.reset();
+		EQ::EventLoop::Get().Shutdown();
+	});
+
+	m_io_thread.join();
+	m_io_loop = nullptr;
+}
+
+//the Daybreak* handlers run wherever the daybreak manager does, when that is the io thread
+//they only copy what they need and hand it to our own loop
 void EQ::Net::EQStreamManager::DaybreakNewConnection(std::shared_ptr<DaybreakConnection> connection)
+{
+	if (!m_threaded) {
+		AddStream(connection, connection->GetStatus());
+		return;
+	}
+
+	std::weak_ptr<bool> alive = m_alive;
+	auto status = connection->GetStatus();
+	m_loop->Post([this, alive, connection, status]() {
+		if (!alive.expired()) {
+			AddStream(connection, status);
+		}
+	});
+}
+
+void EQ::Net::EQStreamManager::DaybreakConnectionStateChange(std::shared_ptr<DaybreakConnection> connection, DbProtocolStatus from, DbProtocolStatus to)
+{
+	if (!m_threaded) {
+		StreamStateChange(connection, from, to);
+		return;
+	}
+
+	std::weak_ptr<bool> alive = m_alive;
+	m_loop->Post([this, alive, connection, from, to]() {
+		if (!alive.expired()) {
+			StreamStateChange(connection, from, to);
+		}
+	});
+}
+
+void EQ::Net::EQStreamManager::DaybreakPacketRecv(std::shared_ptr<DaybreakConnection> connection, const Packet &p)
+{
+	std::unique_ptr<EQ::Net::Packet> t(new EQ::Net::DynamicPacket());
+	t->PutPacket(0, p);
+
+	if (!m_threaded) {
+		StreamPacketRecv(connection, std::move(t));
+		return;
+	}
+
+	std::weak_ptr<bool> alive = m_alive;
+	m_loop->Post([this, alive, connection, t = std::move(t)]() mutable {
+		if (!alive.expired()) {
+			StreamPacketRecv(connection, std::move(t));
+		}
+	});
+}
+
+void EQ::Net::EQStreamManager::AddStream(std::shared_ptr<DaybreakConnection> connection, DbProtocolStatus status)
 {
 	std::shared_ptr<EQStream> stream(new EQStream(this, connection));
+	stream->m_self = stream;
+	stream->m_loop = m_loop;
+	stream->m_io_loop = m_io_loop;
+	stream->m_status = status;
 	m_streams.insert(std::make_pair(connection, stream));
 	if (m_on_new_connection) {
 		m_on_new_connection(stream);
 	}
 }
 
-void EQ::Net::EQStreamManager::DaybreakConnectionStateChange(std::shared_ptr<DaybreakConnection> connection, DbProtocolStatus from, DbProtocolStatus to)
+void EQ::Net::EQStreamManager::StreamStateChange(std::shared_ptr<DaybreakConnection> connection, DbProtocolStatus from, DbProtocolStatus to)
 {
 	auto iter = m_streams.find(connection);
 	if (iter != m_streams.end()) {
+		iter->second->m_status = to;
+
 		if (m_on_connection_state_change) {
 			m_on_connection_state_change(iter->second, from, to);
 		}
@@ -42,14 +153,11 @@ void EQ::Net::EQStreamManager::DaybreakConnectionStateChange(std::shared_ptr<Day
 	}
 }
 
-void EQ::Net::EQStreamManager::DaybreakPacketRecv(std::shared_ptr<DaybreakConnection> connection, const Packet &p)
+void EQ::Net::EQStreamManager::StreamPacketRecv(std::shared_ptr<DaybreakConnection> connection, std::unique_ptr<Packet> p)
 {
 	auto iter = m_streams.find(connection);
 	if (iter != m_streams.end()) {
-		auto &stream = iter->second;
-		std::unique_ptr<EQ::Net::Packet> t(new EQ::Net::DynamicPacket());
-		t->PutPacket(0, p);
-		stream->m_packet_queue.push_back(std::move(t));
+		iter->second->m_packet_queue.push_back(std::move(p));
 	}
 }
 
@@ -57,6 +165,9 @@ EQ::Net::EQStream::EQStream(EQStreamManagerInterface *owner, std::shared_ptr<Day
 {
 	m_owner = owner;
 	m_connection = connection;
+	m_loop = nullptr;
+	m_io_loop = nullptr;
+	m_status = StatusConnecting;
 	m_opcode_manager = nullptr;
 }
 
@@ -76,6 +187,7 @@ void EQ::Net::EQStream::QueuePacket(const EQApplicationPacket *p, bool ack_req)
 		}
 
 		EQ::Net::DynamicPacket out;
+		out.Reserve(m_owner->GetOptions().opcode_size + p->size);
 		switch (m_owner->GetOptions().opcode_size) {
 		case 1:
 			out.PutUInt8(0, opcode);
@@ -87,6 +199,14 @@ void EQ::Net::EQStream::QueuePacket(const EQApplicationPacket *p, bool ack_req)
 			break;
 		}
 
+		if (m_io_loop) {
+			auto connection = m_connection;
+			m_io_loop->Post([connection, out = std::move(out), ack_req]() mutable {
+				connection->QueuePacket(out, 0, ack_req);
+			});
+			return;
+		}
+
 		if (ack_req) {
 			m_connection->QueuePacket(out);
 		}
@@ -133,6 +253,12 @@ EQApplicationPacket *EQ::Net::EQStream::PopPacket() {
 }
 
 void EQ::Net::EQStream::Close() {
+	if (m_io_loop) {
+		auto connection = m_connection;
+		m_io_loop->Post([connection]() { connection->Close(); });
+		return;
+	}
+
 	m_connection->Close();
 }
 
@@ -210,7 +336,7 @@ EQStreamInterface::MatchState EQ::Net::EQStream::CheckSignature(const Signature
 }
 
 EQStreamState EQ::Net::EQStream::GetState() {
-	auto status = m_connection->GetStatus();
+	auto status = m_io_loop ? m_status : m_connection->GetStatus();
 	switch (status) {
 	case StatusConnecting:
 		return UNESTABLISHED;
@@ -226,7 +352,26 @@ EQStreamState EQ::Net::EQStream::GetState() {
 EQ::Net::EQStream::Stats EQ::Net::EQStream::GetStats() const
 {
 	Stats ret;
-	ret.DaybreakStats = m_connection->GetStats();
+	if (m_io_loop) {
+		//the connection belongs to the io thread, report the last copy it sent us and ask for a new one
+		ret.DaybreakStats = m_stats;
+
+		std::weak_ptr<EQStream> self = m_self;
+		auto connection = m_connection;
+		auto loop = m_loop;
+		m_io_loop->Post([self, connection, loop]() {
+			//the stats are too large to capture inline, this only runs when someone asks for them
+			std::unique_ptr<DaybreakConnectionStats> stats(new DaybreakConnectionStats(connection->GetStats()));
+			loop->Post([self, stats = std::move(stats)]() {
+				if (auto stream = self.lock()) {
+					stream->m_stats = *stats;
+				}
+			});
+		});
+	}
+	else {
+		ret.DaybreakStats = m_connection->GetStats();
+	}
 
 	for (int i = 0; i < _maxEmuOpcode; ++i) {
 		ret.RecvCount[i] = 0;
@@ -246,6 +391,13 @@ EQ::Net::EQStream::Stats EQ::Net::EQStream::GetStats() const
 
 void EQ::Net::EQStream::ResetStats()
 {
+	if (m_io_loop) {
+		auto connection = m_connection;
+		m_io_loop->Post([connection]() { connection->ResetStats(); });
+		m_stats.Reset();
+		return;
+	}
+
 	m_connection->ResetStats();
 }
 
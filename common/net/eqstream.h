@@ -3,9 +3,11 @@
 #include "../eq_packet.h"
 #include "../eq_stream_intf.h"
 #include "../opcodemgr.h"
+#include "../event/event_loop.h"
 #include "daybreak_connection.h"
 #include <vector>
 #include <deque>
+#include <thread>
 #include <unordered_map>
 
 namespace EQ
@@ -23,14 +25,26 @@ namespace EQ
 			void OnNewConnection(std::function<void(std::shared_ptr<EQStream>)> func) { m_on_new_connection = func; }
 			void OnConnectionStateChange(std::function<void(std::shared_ptr<EQStream>, DbProtocolStatus, DbProtocolStatus)> func) { m_on_connection_state_change = func; }
 		private:
-			DaybreakConnectionManager m_daybreak;
+			//with io_thread set the daybreak manager lives on its own thread and loop, everything
+			//else here (streams, callbacks) stays on the loop of the thread that created us
+			std::unique_ptr<DaybreakConnectionManager> m_daybreak;
+			bool m_threaded;
+			EQ::EventLoop *m_loop;
+			EQ::EventLoop *m_io_loop;
+			std::thread m_io_thread;
+			std::shared_ptr<bool> m_alive;
 			std::function<void(std::shared_ptr<EQStream>)> m_on_new_connection;
 			std::function<void(std::shared_ptr<EQStream>, DbProtocolStatus, DbProtocolStatus)> m_on_connection_state_change;
 			std::map<std::shared_ptr<DaybreakConnection>, std::shared_ptr<EQStream>> m_streams;
 
+			void CreateDaybreak();
+			void StopIOThread();
 			void DaybreakNewConnection(std::shared_ptr<DaybreakConnection> connection);
 			void DaybreakConnectionStateChange(std::shared_ptr<DaybreakConnection> connection, DbProtocolStatus from, DbProtocolStatus to);
 			void DaybreakPacketRecv(std::shared_ptr<DaybreakConnection> connection, const Packet &p);
+			void AddStream(std::shared_ptr<DaybreakConnection> connection, DbProtocolStatus status);
+			void StreamStateChange(std::shared_ptr<DaybreakConnection> connection, DbProtocolStatus from, DbProtocolStatus to);
+			void StreamPacketRecv(std::shared_ptr<DaybreakConnection> connection, std::unique_ptr<Packet> p);
 			friend class EQStream;
 		};
 
@@ -64,6 +78,11 @@ namespace EQ
 		private:
 			EQStreamManagerInterface *m_owner;
 			std::shared_ptr<DaybreakConnection> m_connection;
+			std::weak_ptr<EQStream> m_self;
+			EQ::EventLoop *m_loop;
+			EQ::EventLoop *m_io_loop;
+			DbProtocolStatus m_status;
+			DaybreakConnectionStats m_stats;
 			OpcodeManager **m_opcode_manager;
 			std::deque<std::unique_ptr<EQ::Net::Packet>> m_packet_queue;
 			std::unordered_map<int, int> m_packet_recv_count;
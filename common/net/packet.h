@@ -13,7 +13,7 @@ namespace EQ {
 		class Packet
 		{
 		public:
-			Packet() : m_stream(std::ios::out | std::ios::binary) { }
+			Packet() { }
 			virtual ~Packet() { }
 
 			virtual const void *Data() const = 0;
@@ -35,20 +35,7 @@ namespace EQ {
 			}
 
 			template<typename T>
-			void PutSerialize(size_t offset, const T &value) {
-				m_stream.clear();
-				cereal::BinaryOutputArchive output(m_stream);
-				output(value);
-
-				auto str = m_stream.str();
-				if (Length() < offset + str.length()) {
-					if (!Resize(offset + str.length())) {
-						throw std::out_of_range("Packet::PutSerialize(), could not resize packet and would of written past the end.");
-					}
-				}
-
-				memcpy((char*)Data() + offset, &str[0], str.length());
-			}
+			void PutSerialize(size_t offset, const T &value);
 
 			void PutInt8(size_t offset, int8_t value);
 			void PutInt16(size_t offset, int16_t value);
@@ -80,10 +67,58 @@ namespace EQ {
 
 			std::string ToString() const;
 			std::string ToString(size_t line_length) const;
+		};
+
+		/**
+		 * Output buffer that writes straight into a packet from an offset, growing it as needed
+		 *
+		 * Only built for the duration of a PutSerialize call so plain packets carry no stream state.
+		 */
+		class PacketStreamBuffer : public std::streambuf
+		{
+		public:
+			PacketStreamBuffer(Packet &packet, size_t offset) : m_packet(packet), m_offset(offset) { }
+
 		protected:
-			std::stringstream m_stream;
+			virtual std::streamsize xsputn(const char *s, std::streamsize n) {
+				size_t length = static_cast<size_t>(n);
+				if (m_packet.Length() < m_offset + length) {
+					if (!m_packet.Resize(m_offset + length)) {
+						throw std::out_of_range("Packet::PutSerialize(), could not resize packet and would of written past the end.");
+					}
+				}
+
+				memcpy((char*)m_packet.Data() + m_offset, s, length);
+				m_offset += length;
+				return n;
+			}
+
+			virtual int_type overflow(int_type c) {
+				if (traits_type::eq_int_type(c, traits_type::eof())) {
+					return traits_type::not_eof(c);
+				}
+
+				char ch = traits_type::to_char_type(c);
+				xsputn(&ch, 1);
+				return c;
+			}
+
+		private:
+			Packet &m_packet;
+			size_t m_offset;
 		};
 
+		template<typename T>
+		void Packet::PutSerialize(size_t offset, const T &value)
+		{
+			PacketStreamBuffer buffer(*this, offset);
+			std::ostream stream(&buffer);
+			stream.exceptions(std::ios::badbit);
+
+			cereal::BinaryOutputArchive output(stream);
+			output(value);
+		}
+
 		class StaticPacket : public Packet
 		{
 		public:
@@ -91,7 +126,7 @@ namespace EQ {
 			virtual ~StaticPacket() { }
 			StaticPacket(const StaticPacket &o) { m_data = o.m_data; m_data_length = o.m_data_length; m_max_data_length = o.m_max_data_length; }
 			StaticPacket& operator=(const StaticPacket &o) { m_data = o.m_data; m_data_length = o.m_data_length; return *this; }
-			StaticPacket(StaticPacket &&o) noexcept { m_data = o.m_data; m_data_length = o.m_data_length; }
+			StaticPacket(StaticPacket &&o) noexcept { m_data = o.m_data; m_data_length = o.m_data_length; m_max_data_length = o.m_max_data_length; }
 
 			virtual const void *Data() const { return m_data; }
 			virtual void *Data() { return m_data; }
@@ -0,0 +1,104 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2021 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef _EQEMU_OBJECT_POOL_H
+#define _EQEMU_OBJECT_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace EQ
+{
+	/**
+	 * Free list of fixed size blocks for objects that are made and thrown away in bulk
+	 *
+	 * Blocks are cut from chunks of ChunkCount objects, one malloc per chunk instead of one per
+	 * object. A released block goes on the free list of the thread releasing it, so no locking is
+	 * needed. Chunks are never handed back, a pool stays at the high water mark of live objects.
+	 *
+	 * Route a class through a pool by giving it a static operator new and operator delete that
+	 * call Allocate and Free with the size they were given.
+	 */
+	template<typename T, size_t ChunkCount = 256>
+	class ObjectPool
+	{
+	public:
+		static void *Allocate(size_t size) {
+			//anything derived from T does not fit a block
+			if (size != sizeof(T)) {
+				return ::operator new(size);
+			}
+
+			auto &list = FreeList();
+			if (list.head == nullptr) {
+				Grow(list);
+			}
+
+			Block *block = list.head;
+			list.head = block->next;
+			return block;
+		}
+
+		static void Free(void *ptr, size_t size) {
+			if (ptr == nullptr) {
+				return;
+			}
+
+			if (size != sizeof(T)) {
+				::operator delete(ptr);
+				return;
+			}
+
+			auto &list = FreeList();
+			Block *block = static_cast<Block*>(ptr);
+			block->next = list.head;
+			list.head = block;
+		}
+
+	private:
+		union Block
+		{
+			Block *next;
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+		};
+
+		//trivial on purpose, blocks still in use elsewhere must survive the thread that made them
+		struct List
+		{
+			Block *head;
+		};
+
+		static List &FreeList() {
+			static thread_local List list = { nullptr };
+			return list;
+		}
+
+		static void Grow(List &list) {
+			Block *chunk = static_cast<Block*>(::operator new(sizeof(Block) * ChunkCount));
+
+			//hand blocks out front to back
+			for (size_t i = ChunkCount; i > 0; --i) {
+				chunk[i - 1].next = list.head;
+				list.head = &chunk[i - 1];
+			}
+		}
+	};
+}
+
+#endif
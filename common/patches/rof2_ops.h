@@ -50,7 +50,7 @@ E(OP_BuffCreate)
 E(OP_CancelTrade)
 E(OP_CastSpell)
 E(OP_ChannelMessage)
-E(OP_CharInventory)
+EI(OP_CharInventory)
 E(OP_ClickObjectAction)
 E(OP_Consider)
 E(OP_Damage)
@@ -87,8 +87,8 @@ E(OP_HPUpdate)
 E(OP_Illusion)
 E(OP_InspectBuffs)
 E(OP_InspectRequest)
-E(OP_ItemLinkResponse)
-E(OP_ItemPacket)
+EI(OP_ItemLinkResponse)
+EI(OP_ItemPacket)
 E(OP_ItemVerifyReply)
 E(OP_LeadershipExpUpdate)
 E(OP_LogServer)
@@ -212,3 +212,4 @@ D(OP_ZoneEntry)
 
 #undef E
 #undef D
+#undef EI
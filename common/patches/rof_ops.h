@@ -35,7 +35,7 @@ E(OP_BuffCreate)
 E(OP_CancelTrade)
 E(OP_CastSpell)
 E(OP_ChannelMessage)
-E(OP_CharInventory)
+EI(OP_CharInventory)
 E(OP_ClickObjectAction)
 E(OP_ClientUpdate)
 E(OP_Consider)
@@ -73,8 +73,8 @@ E(OP_HPUpdate)
 E(OP_Illusion)
 E(OP_InspectBuffs)
 E(OP_InspectRequest)
-E(OP_ItemLinkResponse)
-E(OP_ItemPacket)
+EI(OP_ItemLinkResponse)
+EI(OP_ItemPacket)
 E(OP_ItemVerifyReply)
 E(OP_LeadershipExpUpdate)
 E(OP_LogServer)
@@ -197,3 +197,4 @@ D(OP_ZoneEntry)
 
 #undef E
 #undef D
+#undef EI
@@ -29,7 +29,7 @@ E(OP_BecomeTrader)
 E(OP_Buff)
 E(OP_CancelTrade)
 E(OP_ChannelMessage)
-E(OP_CharInventory)
+EI(OP_CharInventory)
 E(OP_ClientUpdate)
 E(OP_Consider)
 E(OP_Damage)
@@ -53,8 +53,8 @@ E(OP_GroundSpawn)
 E(OP_GuildMemberList)
 E(OP_Illusion)
 E(OP_InspectRequest)
-E(OP_ItemLinkResponse)
-E(OP_ItemPacket)
+EI(OP_ItemLinkResponse)
+EI(OP_ItemPacket)
 E(OP_ItemVerifyReply)
 E(OP_LeadershipExpUpdate)
 E(OP_LogServer)
@@ -137,3 +137,4 @@ D(OP_WhoAllRequest)
 
 #undef E
 #undef D
+#undef EI
@@ -19,3 +19,5 @@
 
 #define E(x) static void Encode_##x(EQApplicationPacket **p, std::shared_ptr<EQStreamInterface> dest, bool ack_req);
 #define D(x) static void Decode_##x(EQApplicationPacket *p);
+//an encoder that reads the live ItemInstance behind an EQ::InternalSerializedItem_Struct
+#define EI(x) E(x)
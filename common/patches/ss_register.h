@@ -19,3 +19,4 @@
 
 #define E(x) encoders[x] = Encode_##x;
 #define D(x) decoders[x] = Decode_##x;
+#define EI(x) encoders[x] = Encode_##x; item_encoders[x] = true;
@@ -8,3 +8,4 @@ D(OP_SetServerFilter)
 
 #undef E
 #undef D
+#undef EI
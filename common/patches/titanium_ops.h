@@ -26,7 +26,7 @@ E(OP_BazaarSearch)
 E(OP_BecomeTrader)
 E(OP_Buff)
 E(OP_ChannelMessage)
-E(OP_CharInventory)
+EI(OP_CharInventory)
 E(OP_ClientUpdate)
 E(OP_Damage)
 E(OP_DeleteCharge)
@@ -50,8 +50,8 @@ E(OP_GuildMemberList)
 E(OP_Illusion)
 E(OP_InspectAnswer)
 E(OP_InspectRequest)
-E(OP_ItemLinkResponse)
-E(OP_ItemPacket)
+EI(OP_ItemLinkResponse)
+EI(OP_ItemPacket)
 E(OP_LeadershipExpUpdate)
 E(OP_LFGuild)
 E(OP_LootItem)
@@ -116,3 +116,4 @@ D(OP_WhoAllRequest)
 
 #undef E
 #undef D
+#undef EI
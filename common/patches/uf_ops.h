@@ -31,7 +31,7 @@ E(OP_Buff)
 E(OP_BuffCreate)
 E(OP_CancelTrade)
 E(OP_ChannelMessage)
-E(OP_CharInventory)
+EI(OP_CharInventory)
 E(OP_ClientUpdate)
 E(OP_Consider)
 E(OP_Damage)
@@ -62,8 +62,8 @@ E(OP_GuildsList)
 E(OP_Illusion)
 E(OP_InspectBuffs)
 E(OP_InspectRequest)
-E(OP_ItemLinkResponse)
-E(OP_ItemPacket)
+EI(OP_ItemLinkResponse)
+EI(OP_ItemPacket)
 E(OP_ItemVerifyReply)
 E(OP_LeadershipExpUpdate)
 E(OP_LogServer)
@@ -160,3 +160,4 @@ D(OP_WhoAllRequest)
 
 #undef E
 #undef D
+#undef EI
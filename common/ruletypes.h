@@ -247,6 +247,7 @@ RULE_INT (World, TellQueueSize, 20, "Maximum tell queue size")
 RULE_BOOL(World, StartZoneSameAsBindOnCreation, true, "Should the start zone always be the same location as your bind?")
 RULE_BOOL(World, EnforceCharacterLimitAtLogin, false, "Enforce the limit for characters that are online at login")
 RULE_BOOL(World, EnableDevTools, true, "Enable or Disable the Developer Tools globally (Most of the time you want this enabled)")
+RULE_INT(World, WhoAllCacheMS, 1000, "Time in milliseconds an identical /who all reply is served from cache. 0 disables the cache")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Zone)
@@ -280,6 +281,8 @@ RULE_BOOL(Zone, EnableZoneControllerGlobals, false, "Enables the ability to use
 RULE_INT(Zone, GlobalLootMultiplier, 1, "Sets Global Loot drop multiplier for database based drops, useful for double, triple loot etc")
 RULE_BOOL(Zone, KillProcessOnDynamicShutdown, true, "When process has booted a zone and has hit its zone shut down timer, it will hard kill the process to free memory back to the OS")
 RULE_INT(Zone, SecondsBeforeIdle, 60, "Seconds before IDLE_WHEN_EMPTY define kicks in")
+RULE_BOOL(Zone, PreloadQuests, true, "Load the quest scripts of every NPC type in the zone's spawn groups at zone boot and quest reload instead of on their first event")
+RULE_BOOL(Zone, UseSharedMemoryNPCTypes, true, "Serve npc_types from the shared memory segment when it is available. Types changed with #npcedit, #npceditmass or an npc type cache clear are read from the database until the next #hotfix, other npc_types edits take effect after a #hotfix")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Map)
@@ -289,6 +292,8 @@ RULE_REAL(Map, DistanceCanTravelBeforeAdjustment, 10.0, "Distance a mob can path
 RULE_BOOL(Map, MobZVisualDebug, false, "Displays spell effects determining whether or not NPC is hitting Best Z calcs (blue for hit, red for miss)")
 RULE_REAL(Map, FixPathingZMaxDeltaSendTo, 20, "At runtime in SendTo: maximum change in Z to allow the BestZ code to apply")
 RULE_INT(Map, FindBestZHeightAdjust, 1, "Adds this to the current Z before seeking the best Z position")
+RULE_BOOL(Map, LosCache, true, "Reuse line of sight results between two mobs while neither has moved")
+RULE_REAL(Map, LosCacheGranularity, 0.0, "How far either end may move before a cached line of sight result is recalculated, 0 only reuses results for the exact same positions")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Pathing)
@@ -708,6 +713,9 @@ RULE_INT(Network, ResendDelayMinMS, 300, "Minimum timespan between two send retr
 RULE_INT(Network, ResendDelayMaxMS, 5000, "Maximum timespan between two send retries (milliseconds)")
 RULE_REAL(Network, ClientDataRate, 0.0, "KB / sec, 0.0 disabled")
 RULE_BOOL(Network, CompressZoneStream, true, "Setting whether the zone stream should be compressed for transmission")
+RULE_BOOL(Network, DedicatedIOThread, false, "Run the client protocol (acks, resends, fragment reassembly) on its own thread so a slow world or zone tick does not delay it. Packet encoding does not move to this thread")
+RULE_BOOL(Network, AdaptiveCombine, false, "Combine outgoing protocol packets up to the max packet size and send them when the server has nothing else to do this turn, instead of holding them for a fixed time")
+RULE_INT(Network, EncodeThreads, 0, "Worker threads a zone uses to encode the packets queued for its clients during a tick at the end of the tick, 0 encodes them as they are queued (read at boot)")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(QueryServ)
@@ -34,6 +34,7 @@
 #include "loottable.h"
 #include "memory_mapped_file.h"
 #include "mysql.h"
+#include "npc_type_data.h"
 #include "rulesys.h"
 #include "shareddb.h"
 #include "string_util.h"
@@ -1364,6 +1365,408 @@ bool SharedDatabase::LoadNPCFactionLists(const std::string &prefix) {
 	return true;
 }
 
+/**
+ * npc types
+ */
+void SharedDatabase::GetNPCTypesCount(uint32 &npc_type_count, uint32 &max_npc_type_id)
+{
+	npc_type_count  = 0;
+	max_npc_type_id = 0;
+
+	const std::string query   = "SELECT COUNT(*), MAX(id) FROM npc_types";
+	auto              results = QueryDatabase(query);
+	if (!results.Success() || results.RowCount() == 0) {
+		return;
+	}
+
+	auto row = results.begin();
+
+	npc_type_count  = static_cast<uint32>(atoul(row[0]));
+	max_npc_type_id = static_cast<uint32>(atoul(row[1] ? row[1] : "0"));
+}
+
+std::string SharedDatabase::GetNPCTypesQuery(const std::string &where_condition)
+{
+	return StringFormat(
+		"SELECT "
+		"npc_types.id, "
+		"npc_types.name, "
+		"npc_types.level, "
+		"npc_types.race, "
+		"npc_types.class, "
+		"npc_types.hp, "
+		"npc_types.mana, "
+		"npc_types.gender, "
+		"npc_types.texture, "
+		"npc_types.helmtexture, "
+		"npc_types.herosforgemodel, "
+		"npc_types.size, "
+		"npc_types.loottable_id, "
+		"npc_types.merchant_id, "
+		"npc_types.alt_currency_id, "
+		"npc_types.adventure_template_id, "
+		"npc_types.trap_template, "
+		"npc_types.attack_speed, "
+		"npc_types.STR, "
+		"npc_types.STA, "
+		"npc_types.DEX, "
+		"npc_types.AGI, "
+		"npc_types._INT, "
+		"npc_types.WIS, "
+		"npc_types.CHA, "
+		"npc_types.MR, "
+		"npc_types.CR, "
+		"npc_types.DR, "
+		"npc_types.FR, "
+		"npc_types.PR, "
+		"npc_types.Corrup, "
+		"npc_types.PhR, "
+		"npc_types.mindmg, "
+		"npc_types.maxdmg, "
+		"npc_types.attack_count, "
+		"npc_types.special_abilities, "
+		"npc_types.npc_spells_id, "
+		"npc_types.npc_spells_effects_id, "
+		"npc_types.d_melee_texture1, "
+		"npc_types.d_melee_texture2, "
+		"npc_types.ammo_idfile, "
+		"npc_types.prim_melee_type, "
+		"npc_types.sec_melee_type, "
+		"npc_types.ranged_type, "
+		"npc_types.runspeed, "
+		"npc_types.findable, "
+		"npc_types.trackable, "
+		"npc_types.hp_regen_rate, "
+		"npc_types.mana_regen_rate, "
+		"npc_types.aggroradius, "
+		"npc_types.assistradius, "
+		"npc_types.bodytype, "
+		"npc_types.npc_faction_id, "
+		"npc_types.face, "
+		"npc_types.luclin_hairstyle, "
+		"npc_types.luclin_haircolor, "
+		"npc_types.luclin_eyecolor, "
+		"npc_types.luclin_eyecolor2, "
+		"npc_types.luclin_beardcolor, "
+		"npc_types.luclin_beard, "
+		"npc_types.drakkin_heritage, "
+		"npc_types.drakkin_tattoo, "
+		"npc_types.drakkin_details, "
+		"npc_types.armortint_id, "
+		"npc_types.armortint_red, "
+		"npc_types.armortint_green, "
+		"npc_types.armortint_blue, "
+		"npc_types.see_invis, "
+		"npc_types.see_invis_undead, "
+		"npc_types.lastname, "
+		"npc_types.qglobal, "
+		"npc_types.AC, "
+		"npc_types.npc_aggro, "
+		"npc_types.spawn_limit, "
+		"npc_types.see_hide, "
+		"npc_types.see_improved_hide, "
+		"npc_types.ATK, "
+		"npc_types.Accuracy, "
+		"npc_types.Avoidance, "
+		"npc_types.slow_mitigation, "
+		"npc_types.maxlevel, "
+		"npc_types.scalerate, "
+		"npc_types.private_corpse, "
+		"npc_types.unique_spawn_by_name, "
+		"npc_types.underwater, "
+		"npc_types.emoteid, "
+		"npc_types.spellscale, "
+		"npc_types.healscale, "
+		"npc_types.no_target_hotkey, "
+		"npc_types.raid_target, "
+		"npc_types.attack_delay, "
+		"npc_types.light, "
+		"npc_types.armtexture, "
+		"npc_types.bracertexture, "
+		"npc_types.handtexture, "
+		"npc_types.legtexture, "
+		"npc_types.feettexture, "
+		"npc_types.ignore_despawn, "
+		"npc_types.show_name, "
+		"npc_types.untargetable, "
+		"npc_types.charm_ac, "
+		"npc_types.charm_min_dmg, "
+		"npc_types.charm_max_dmg, "
+		"npc_types.charm_attack_delay, "
+		"npc_types.charm_accuracy_rating, "
+		"npc_types.charm_avoidance_rating, "
+		"npc_types.charm_atk, "
+		"npc_types.skip_global_loot, "
+		"npc_types.rare_spawn, "
+		"npc_types.stuck_behavior, "
+		"npc_types.model, "
+		"npc_types.flymode, "
+		"npc_types.always_aggro, "
+		"npc_types.exp_mod "
+		"FROM npc_types %s",
+		where_condition.c_str()
+	);
+}
+
+void SharedDatabase::LoadNPCTypeRow(MySQLRequestRow &row, NPCType *npc_type)
+{
+	npc_type->npc_id = atoi(row[0]);
+
+	strn0cpy(npc_type->name, row[1], 50);
+
+	npc_type->level              = atoi(row[2]);
+	npc_type->race               = atoi(row[3]);
+	npc_type->class_             = atoi(row[4]);
+	npc_type->max_hp             = atoi(row[5]);
+	npc_type->current_hp         = npc_type->max_hp;
+	npc_type->Mana               = atoi(row[6]);
+	npc_type->gender             = atoi(row[7]);
+	npc_type->texture            = atoi(row[8]);
+	npc_type->helmtexture        = atoi(row[9]);
+	npc_type->herosforgemodel    = atoul(row[10]);
+	npc_type->size               = atof(row[11]);
+	npc_type->loottable_id       = atoi(row[12]);
+	npc_type->merchanttype       = atoi(row[13]);
+	npc_type->alt_currency_type  = atoi(row[14]);
+	npc_type->adventure_template = atoi(row[15]);
+	npc_type->trap_template      = atoi(row[16]);
+	npc_type->attack_speed       = atof(row[17]);
+	npc_type->STR                = atoi(row[18]);
+	npc_type->STA                = atoi(row[19]);
+	npc_type->DEX                = atoi(row[20]);
+	npc_type->AGI                = atoi(row[21]);
+	npc_type->INT                = atoi(row[22]);
+	npc_type->WIS                = atoi(row[23]);
+	npc_type->CHA                = atoi(row[24]);
+	npc_type->MR                 = atoi(row[25]);
+	npc_type->CR                 = atoi(row[26]);
+	npc_type->DR                 = atoi(row[27]);
+	npc_type->FR                 = atoi(row[28]);
+	npc_type->PR                 = atoi(row[29]);
+	npc_type->Corrup             = atoi(row[30]);
+	npc_type->PhR                = atoi(row[31]);
+	npc_type->min_dmg            = atoi(row[32]);
+	npc_type->max_dmg            = atoi(row[33]);
+	npc_type->attack_count       = atoi(row[34]);
+
+	if (row[35] != nullptr) {
+		strn0cpy(npc_type->special_abilities, row[35], 512);
+	}
+	else {
+		npc_type->special_abilities[0] = '\0';
+	}
+
+	npc_type->npc_spells_id         = atoi(row[36]);
+	npc_type->npc_spells_effects_id = atoi(row[37]);
+	npc_type->d_melee_texture1      = atoi(row[38]);
+	npc_type->d_melee_texture2      = atoi(row[39]);
+	strn0cpy(npc_type->ammo_idfile, row[40], 30);
+	npc_type->prim_melee_type = atoi(row[41]);
+	npc_type->sec_melee_type  = atoi(row[42]);
+	npc_type->ranged_type     = atoi(row[43]);
+	npc_type->runspeed        = atof(row[44]);
+	npc_type->findable        = atoi(row[45]) == 0 ? false : true;
+	npc_type->trackable       = atoi(row[46]) == 0 ? false : true;
+	npc_type->hp_regen        = atoi(row[47]);
+	npc_type->mana_regen      = atoi(row[48]);
+
+	// set default value for aggroradius
+	npc_type->aggroradius = (int32) atoi(row[49]);
+	if (npc_type->aggroradius <= 0) {
+		npc_type->aggroradius = 70;
+	}
+
+	npc_type->assistradius = (int32) atoi(row[50]);
+	if (npc_type->assistradius <= 0) {
+		npc_type->assistradius = npc_type->aggroradius;
+	}
+
+	if (row[51] && strlen(row[51])) {
+		npc_type->bodytype = (uint8) atoi(row[51]);
+	}
+	else {
+		npc_type->bodytype = 0;
+	}
+
+	npc_type->npc_faction_id = atoi(row[52]);
+
+	npc_type->luclinface       = atoi(row[53]);
+	npc_type->hairstyle        = atoi(row[54]);
+	npc_type->haircolor        = atoi(row[55]);
+	npc_type->eyecolor1        = atoi(row[56]);
+	npc_type->eyecolor2        = atoi(row[57]);
+	npc_type->beardcolor       = atoi(row[58]);
+	npc_type->beard            = atoi(row[59]);
+	npc_type->drakkin_heritage = atoi(row[60]);
+	npc_type->drakkin_tattoo   = atoi(row[61]);
+	npc_type->drakkin_details  = atoi(row[62]);
+
+	uint32 armor_tint_id = atoi(row[63]);
+
+	npc_type->armor_tint.Head.Color = (atoi(row[64]) & 0xFF) << 16;
+	npc_type->armor_tint.Head.Color |= (atoi(row[65]) & 0xFF) << 8;
+	npc_type->armor_tint.Head.Color |= (atoi(row[66]) & 0xFF);
+	npc_type->armor_tint.Head.Color |= (npc_type->armor_tint.Head.Color) ? (0xFF << 24) : 0;
+
+	if (armor_tint_id != 0) {
+		std::string armortint_query   = StringFormat(
+			"SELECT red1h, grn1h, blu1h, "
+			"red2c, grn2c, blu2c, "
+			"red3a, grn3a, blu3a, "
+			"red4b, grn4b, blu4b, "
+			"red5g, grn5g, blu5g, "
+			"red6l, grn6l, blu6l, "
+			"red7f, grn7f, blu7f, "
+			"red8x, grn8x, blu8x, "
+			"red9x, grn9x, blu9x "
+			"FROM npc_types_tint WHERE id = %d",
+			armor_tint_id
+		);
+		auto        armortint_results = QueryDatabase(armortint_query);
+		if (!armortint_results.Success() || armortint_results.RowCount() == 0) {
+			armor_tint_id = 0;
+		}
+		else {
+			auto armorTint_row = armortint_results.begin();
+
+			for (int index = EQ::textures::textureBegin; index <= EQ::textures::LastTexture; index++) {
+				npc_type->armor_tint.Slot[index].Color = atoi(armorTint_row[index * 3]) << 16;
+				npc_type->armor_tint.Slot[index].Color |= atoi(armorTint_row[index * 3 + 1]) << 8;
+				npc_type->armor_tint.Slot[index].Color |= atoi(armorTint_row[index * 3 + 2]);
+				npc_type->armor_tint.Slot[index].Color |= (npc_type->armor_tint.Slot[index].Color)
+					? (0xFF << 24) : 0;
+			}
+		}
+	}
+	// Try loading npc_types tint fields if armor tint is 0 or query failed to get results
+	if (armor_tint_id == 0) {
+		for (int index = EQ::textures::armorChest; index < EQ::textures::materialCount; index++) {
+			npc_type->armor_tint.Slot[index].Color = npc_type->armor_tint.Slot[0].Color; // odd way to 'zero-out' the array...
+		}
+	}
+
+	npc_type->see_invis        = atoi(row[67]);
+	npc_type->see_invis_undead = atoi(row[68]) == 0 ? false : true;    // Set see_invis_undead flag
+
+	if (row[69] != nullptr) {
+		strn0cpy(npc_type->lastname, row[69], 32);
+	}
+
+	npc_type->qglobal              = atoi(row[70]) == 0 ? false : true;    // qglobal
+	npc_type->AC                   = atoi(row[71]);
+	npc_type->npc_aggro            = atoi(row[72]) == 0 ? false : true;
+	npc_type->spawn_limit          = atoi(row[73]);
+	npc_type->see_hide             = atoi(row[74]) == 0 ? false : true;
+	npc_type->see_improved_hide    = atoi(row[75]) == 0 ? false : true;
+	npc_type->ATK                  = atoi(row[76]);
+	npc_type->accuracy_rating      = atoi(row[77]);
+	npc_type->avoidance_rating     = atoi(row[78]);
+	npc_type->slow_mitigation      = atoi(row[79]);
+	npc_type->maxlevel             = atoi(row[80]);
+	npc_type->scalerate            = atoi(row[81]);
+	npc_type->private_corpse       = atoi(row[82]) == 1 ? true : false;
+	npc_type->unique_spawn_by_name = atoi(row[83]) == 1 ? true : false;
+	npc_type->underwater           = atoi(row[84]) == 1 ? true : false;
+	npc_type->emoteid              = atoi(row[85]);
+	npc_type->spellscale           = atoi(row[86]);
+	npc_type->healscale            = atoi(row[87]);
+	npc_type->no_target_hotkey     = atoi(row[88]) == 1 ? true : false;
+	npc_type->raid_target          = atoi(row[89]) == 0 ? false : true;
+	npc_type->attack_delay         = atoi(row[90]) * 100; // TODO: fix DB
+	npc_type->light                = (atoi(row[91]) & 0x0F);
+
+	npc_type->armtexture     = atoi(row[92]);
+	npc_type->bracertexture  = atoi(row[93]);
+	npc_type->handtexture    = atoi(row[94]);
+	npc_type->legtexture     = atoi(row[95]);
+	npc_type->feettexture    = atoi(row[96]);
+	npc_type->ignore_despawn = atoi(row[97]) == 1 ? true : false;
+	npc_type->show_name      = atoi(row[98]) != 0 ? true : false;
+	npc_type->untargetable   = atoi(row[99]) != 0 ? true : false;
+
+	npc_type->charm_ac               = atoi(row[100]);
+	npc_type->charm_min_dmg          = atoi(row[101]);
+	npc_type->charm_max_dmg          = atoi(row[102]);
+	npc_type->charm_attack_delay     = atoi(row[103]) * 100; // TODO: fix DB
+	npc_type->charm_accuracy_rating  = atoi(row[104]);
+	npc_type->charm_avoidance_rating = atoi(row[105]);
+	npc_type->charm_atk              = atoi(row[106]);
+
+	npc_type->skip_global_loot 	= atoi(row[107]) != 0;
+	npc_type->rare_spawn       	= atoi(row[108]) != 0;
+	npc_type->stuck_behavior   	= atoi(row[109]);
+	npc_type->use_model        	= atoi(row[110]);
+	npc_type->flymode          	= atoi(row[111]);
+	npc_type->always_aggro	        = atoi(row[112]);
+	npc_type->exp_mod              = atoi(row[113]);
+
+	npc_type->skip_auto_scale = false; // hardcoded here for now
+}
+
+void SharedDatabase::LoadNPCTypes(void *data, uint32 size, uint32 npc_type_count, uint32 max_npc_type_id)
+{
+	EQ::FixedMemoryHashSet<NPCType> hash(reinterpret_cast<uint8 *>(data), size, npc_type_count, max_npc_type_id);
+
+	auto results = QueryDatabase(GetNPCTypesQuery("ORDER BY npc_types.id"));
+	if (!results.Success()) {
+		return;
+	}
+
+	NPCType npc_type;
+	for (auto row = results.begin(); row != results.end(); ++row) {
+		memset(&npc_type, 0, sizeof(NPCType));
+		LoadNPCTypeRow(row, &npc_type);
+
+		hash.insert(npc_type.npc_id, npc_type);
+	}
+}
+
+bool SharedDatabase::LoadNPCTypes(const std::string &prefix)
+{
+	npc_types_mmf.reset(nullptr);
+	npc_types_hash.reset(nullptr);
+
+	try {
+		auto Config = EQEmuConfig::get();
+		EQ::IPCMutex mutex("npc_types");
+		mutex.Lock();
+		std::string file_name = Config->SharedMemDir + prefix + std::string("npc_types");
+		LogInfo("[Shared Memory] Attempting to load file [{}]", file_name);
+		npc_types_mmf  = std::make_unique<EQ::MemoryMappedFile>(file_name);
+		npc_types_hash = std::make_unique<EQ::FixedMemoryHashSet<NPCType>>(reinterpret_cast<uint8 *>(npc_types_mmf->Get()), npc_types_mmf->Size());
+		mutex.Unlock();
+	} catch (std::exception &ex) {
+		LogError("Error Loading npc types: {}", ex.what());
+		return false;
+	}
+
+	return true;
+}
+
+bool SharedDatabase::IsSharedNPCType(const NPCType *npc_type) const
+{
+	if (!npc_types_mmf || !npc_type) {
+		return false;
+	}
+
+	auto begin = reinterpret_cast<const uint8 *>(npc_types_mmf->Get());
+	auto ptr   = reinterpret_cast<const uint8 *>(npc_type);
+	return ptr >= begin && ptr < begin + npc_types_mmf->Size();
+}
+
+const NPCType *SharedDatabase::GetNPCType(uint32 id)
+{
+	if (!npc_types_hash) {
+		return nullptr;
+	}
+
+	if (npc_types_hash->exists(id)) {
+		return &(npc_types_hash->at(id));
+	}
+
+	return nullptr;
+}
+
 // Create appropriate EQ::ItemInstance class
 EQ::ItemInstance* SharedDatabase::CreateItem(uint32 item_id, int16 charges, uint32 aug1, uint32 aug2, uint32 aug3, uint32 aug4, uint32 aug5, uint32 aug6, uint8 attuned)
 {
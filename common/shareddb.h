@@ -41,6 +41,7 @@ struct InspectMessage_Struct;
 struct PlayerProfile_Struct;
 struct SPDat_Spell_Struct;
 struct NPCFactionList;
+struct NPCType;
 struct LootTable_Struct;
 struct LootDrop_Struct;
 
@@ -155,6 +156,17 @@ public:
 	void LoadNPCFactionLists(void *data, uint32 size, uint32 list_count, uint32 max_lists);
 	bool LoadNPCFactionLists(const std::string &prefix);
 
+	/**
+	 * npc types
+	 */
+	void GetNPCTypesCount(uint32 &npc_type_count, uint32 &max_npc_type_id);
+	std::string GetNPCTypesQuery(const std::string &where_condition);
+	void LoadNPCTypeRow(MySQLRequestRow &row, NPCType *npc_type);
+	void LoadNPCTypes(void *data, uint32 size, uint32 npc_type_count, uint32 max_npc_type_id);
+	bool LoadNPCTypes(const std::string &prefix);
+	const NPCType *GetNPCType(uint32 id);
+	bool IsSharedNPCType(const NPCType *npc_type) const;
+
 	/**
 	 * loot
 	 */
@@ -205,6 +217,8 @@ protected:
 	std::unique_ptr<EQ::FixedMemoryHashSet<EQ::ItemData>>          items_hash;
 	std::unique_ptr<EQ::MemoryMappedFile>                             faction_mmf;
 	std::unique_ptr<EQ::FixedMemoryHashSet<NPCFactionList>>           faction_hash;
+	std::unique_ptr<EQ::MemoryMappedFile>                             npc_types_mmf;
+	std::unique_ptr<EQ::FixedMemoryHashSet<NPCType>>                  npc_types_hash;
 	std::unique_ptr<EQ::MemoryMappedFile>                             loot_table_mmf;
 	std::unique_ptr<EQ::FixedMemoryVariableHashSet<LootTable_Struct>> loot_table_hash;
 	std::unique_ptr<EQ::MemoryMappedFile>                             loot_drop_mmf;
@@ -16,6 +16,7 @@ StructStrategy::StructStrategy() {
 	for(r = 0; r < _maxEmuOpcode; r++) {
 		encoders[r] = PassEncoder;
 		decoders[r] = PassDecoder;
+		item_encoders[r] = false;
 	}
 }
 
@@ -23,6 +23,8 @@ public:
 	void Encode(EQApplicationPacket **p, std::shared_ptr<EQStreamInterface> dest, bool ack_req) const;
 	//this method takes an EQ wire struct, and converts it into an eqemu struct
 	void Decode(EQApplicationPacket *p) const;
+	//true when the encoder for this opcode reads item instances through the pointers in the packet
+	bool EncodesItems(EmuOpcode op) const { return item_encoders[op]; }
 
 	virtual std::string Describe() const = 0;
 	virtual const EQ::versions::ClientVersion ClientVersion() const = 0;
@@ -38,6 +40,7 @@ protected:
 
 	Encoder encoders[_maxEmuOpcode];
 	Decoder decoders[_maxEmuOpcode];
+	bool item_encoders[_maxEmuOpcode];
 };
 
 //effectively a singleton, but I decided to do it this way for no apparent reason.
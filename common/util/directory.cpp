@@ -6,14 +6,18 @@
 #include <dirent.h>
 #endif
 
+#include <sys/stat.h>
+
 struct EQ::Directory::impl {
 	DIR *m_dir;
+	std::string m_path;
 };
 
 EQ::Directory::Directory(const std::string &path)
 {
 	m_impl = new impl;
 	m_impl->m_dir = opendir(path.c_str());
+	m_impl->m_path = path;
 }
 
 EQ::Directory::~Directory()
@@ -39,6 +43,17 @@ void EQ::Directory::GetFiles(std::vector<std::string>& files)
 			case DT_REG:
 				files.push_back(ent->d_name);
 				break;
+			case DT_LNK:
+			case DT_UNKNOWN:
+			{
+				// links and file systems that do not report the type need a stat to tell
+				struct stat st;
+				std::string full_path = m_impl->m_path + "/" + ent->d_name;
+				if (stat(full_path.c_str(), &st) == 0 && (st.st_mode & S_IFMT) == S_IFREG) {
+					files.push_back(ent->d_name);
+				}
+				break;
+			}
 			default:
 				break;
 			}
@@ -29,6 +29,7 @@
 #include "../common/string_util.h"
 #include "items.h"
 #include "npc_faction.h"
+#include "npc_types.h"
 #include "loot.h"
 #include "skill_caps.h"
 #include "spells.h"
@@ -179,6 +180,7 @@ int main(int argc, char **argv)
 	bool load_all        = true;
 	bool load_items      = false;
 	bool load_factions   = false;
+	bool load_npc_types  = false;
 	bool load_loot       = false;
 	bool load_skill_caps = false;
 	bool load_spells     = false;
@@ -215,6 +217,13 @@ int main(int argc, char **argv)
 					}
 					break;
 
+				case 'n':
+					if (strcasecmp("npc_types", argv[i]) == 0) {
+						load_npc_types = true;
+						load_all       = false;
+					}
+					break;
+
 				case 's':
 					if (strcasecmp("skill_caps", argv[i]) == 0) {
 						load_skill_caps = true;
@@ -265,6 +274,16 @@ int main(int argc, char **argv)
 		}
 	}
 
+	if (load_all || load_npc_types) {
+		LogInfo("Loading npc types");
+		try {
+			LoadNPCTypes(&content_db, hotfix_name);
+		} catch (std::exception &ex) {
+			LogError("{}", ex.what());
+			return 1;
+		}
+	}
+
 	if (load_all || load_loot) {
 		LogInfo("Loading loot");
 		try {
@@ -0,0 +1,207 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2021 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_INBOX_H
+#define __EQEMU_TESTS_INBOX_H
+
+#include "cppunit/cpptest.h"
+#include "../common/event/inbox.h"
+#include "../common/event/event_loop.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+class InboxTest : public Test::Suite {
+	typedef void(InboxTest::*TestFunction)(void);
+public:
+	InboxTest() {
+		TEST_ADD(InboxTest::OrderTest);
+		TEST_ADD(InboxTest::FullTest);
+		TEST_ADD(InboxTest::WrapTest);
+		TEST_ADD(InboxTest::MultipleProducerTest);
+		TEST_ADD(InboxTest::EmptyTest);
+		TEST_ADD(InboxTest::LoopOverflowTest);
+		TEST_ADD(InboxTest::InlineFunctionTest);
+		TEST_ADD(InboxTest::LoopMoveOnlyTest);
+	}
+
+	~InboxTest() {
+	}
+
+	private:
+
+	void OrderTest() {
+		EQ::Event::Inbox<int, 8> inbox;
+		int value = 0;
+
+		TEST_ASSERT(!inbox.TryPop(value));
+		TEST_ASSERT(inbox.TryPush(1));
+		TEST_ASSERT(inbox.TryPush(2));
+		TEST_ASSERT(inbox.TryPop(value));
+		TEST_ASSERT_EQUALS(value, 1);
+		TEST_ASSERT(inbox.TryPop(value));
+		TEST_ASSERT_EQUALS(value, 2);
+		TEST_ASSERT(!inbox.TryPop(value));
+	}
+
+	void FullTest() {
+		EQ::Event::Inbox<int, 4> inbox;
+		int value = 0;
+
+		for (int i = 0; i < 4; ++i) {
+			TEST_ASSERT(inbox.TryPush(int(i)));
+		}
+
+		TEST_ASSERT(!inbox.TryPush(4));
+		TEST_ASSERT(inbox.TryPop(value));
+		TEST_ASSERT_EQUALS(value, 0);
+		TEST_ASSERT(inbox.TryPush(4));
+	}
+
+	void WrapTest() {
+		EQ::Event::Inbox<int, 4> inbox;
+		int value = 0;
+		bool ordered = true;
+
+		for (int i = 0; i < 100; ++i) {
+			inbox.TryPush(int(i));
+			if (!inbox.TryPop(value) || value != i) {
+				ordered = false;
+			}
+		}
+
+		TEST_ASSERT(ordered);
+	}
+
+	void MultipleProducerTest() {
+		const int producers = 4;
+		const int per_producer = 20000;
+		EQ::Event::Inbox<int, 256> inbox;
+
+		std::vector<std::thread> threads;
+		for (int p = 0; p < producers; ++p) {
+			threads.push_back(std::thread([&inbox, p, per_producer]() {
+				for (int i = 0; i < per_producer; ++i) {
+					while (!inbox.TryPush(p * per_producer + i)) {
+						std::this_thread::yield();
+					}
+				}
+			}));
+		}
+
+		//every value arrives once and each producer's values arrive in the order they were pushed
+		std::vector<int> next(producers, 0);
+		bool ordered = true;
+		int received = 0;
+		int value = 0;
+		while (received < producers * per_producer) {
+			if (!inbox.TryPop(value)) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			int p = value / per_producer;
+			if (value % per_producer != next[p]) {
+				ordered = false;
+			}
+
+			next[p] = value % per_producer + 1;
+			++received;
+		}
+
+		for (auto &t : threads) {
+			t.join();
+		}
+
+		TEST_ASSERT(ordered);
+		TEST_ASSERT(!inbox.TryPop(value));
+	}
+
+	void EmptyTest() {
+		EQ::Event::Inbox<int, 4> inbox;
+		int value = 0;
+
+		TEST_ASSERT(inbox.Empty());
+		TEST_ASSERT(inbox.TryPush(1));
+		TEST_ASSERT(!inbox.Empty());
+		TEST_ASSERT(inbox.TryPop(value));
+		TEST_ASSERT(inbox.Empty());
+	}
+
+	void LoopOverflowTest() {
+		auto &loop = EQ::EventLoop::Get();
+		const int count = (int)EQ::EventLoop::InboxCapacity * 3;
+		std::vector<int> seen;
+
+		//posting past a full inbox must not wait for this thread to drain it
+		std::thread poster([&loop, &seen, count]() {
+			for (int i = 0; i < count; ++i) {
+				loop.Post([&seen, i]() { seen.push_back(i); });
+			}
+		});
+		poster.join();
+
+		loop.Process();
+
+		bool ordered = (int)seen.size() == count;
+		for (size_t i = 0; ordered && i < seen.size(); ++i) {
+			ordered = seen[i] == (int)i;
+		}
+
+		TEST_ASSERT(ordered);
+	}
+
+	void InlineFunctionTest() {
+		auto owned = std::make_shared<int>(0);
+		{
+			EQ::Event::InlineFunction<32> a([owned]() { ++*owned; });
+			TEST_ASSERT(owned.use_count() == 2);
+
+			EQ::Event::InlineFunction<32> b(std::move(a));
+			TEST_ASSERT(!a);
+			TEST_ASSERT(owned.use_count() == 2);
+			b();
+
+			a = std::move(b);
+			a();
+			TEST_ASSERT(!b);
+			TEST_ASSERT_EQUALS(*owned, 2);
+
+			a.Reset();
+			TEST_ASSERT(owned.use_count() == 1);
+
+			b = [owned]() { ++*owned; };
+		}
+
+		//captures go when the holder does
+		TEST_ASSERT(owned.use_count() == 1);
+	}
+
+	void LoopMoveOnlyTest() {
+		auto &loop = EQ::EventLoop::Get();
+		std::unique_ptr<int> value(new int(42));
+		int seen = 0;
+
+		loop.Post([&seen, value = std::move(value)]() { seen = *value; });
+		loop.Process();
+
+		TEST_ASSERT_EQUALS(seen, 42);
+	}
+};
+
+#endif
@@ -0,0 +1,171 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2021 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_INVENTORY_PROFILE_H
+#define __EQEMU_TESTS_INVENTORY_PROFILE_H
+
+#include "cppunit/cpptest.h"
+#include "../common/inventory_profile.h"
+#include <cstring>
+
+class InventoryProfileTest : public Test::Suite {
+	typedef void(InventoryProfileTest::*TestFunction)(void);
+public:
+	InventoryProfileTest() {
+		memset(&sword, 0, sizeof(sword));
+		sword.ID = 1001;
+		sword.LoreGroup = 1001;
+		sword.ItemClass = EQ::item::ItemClassCommon;
+		sword.Slots = 0xFFFFFFFF;
+
+		memset(&arrow, 0, sizeof(arrow));
+		arrow.ID = 2002;
+		arrow.ItemType = EQ::item::ItemTypeArrow;
+		arrow.ItemClass = EQ::item::ItemClassCommon;
+		arrow.Stackable = true;
+		arrow.StackSize = 100;
+		arrow.Slots = 0xFFFFFFFF;
+
+		memset(&bag, 0, sizeof(bag));
+		bag.ID = 3003;
+		bag.ItemClass = EQ::item::ItemClassBag;
+		bag.BagSlots = 10;
+		bag.Slots = 0xFFFFFFFF;
+
+		memset(&aug, 0, sizeof(aug));
+		aug.ID = 4004;
+		aug.LoreGroup = 4004;
+		aug.ItemClass = EQ::item::ItemClassCommon;
+		aug.Slots = 0xFFFFFFFF;
+
+		TEST_ADD(InventoryProfileTest::PutPopTest);
+		TEST_ADD(InventoryProfileTest::ChargesTest);
+		TEST_ADD(InventoryProfileTest::AugmentTest);
+		TEST_ADD(InventoryProfileTest::SwapTest);
+		TEST_ADD(InventoryProfileTest::CursorTest);
+	}
+
+	~InventoryProfileTest() {
+	}
+
+	private:
+
+	void PutPopTest() {
+		EQ::InventoryProfile inv;
+		inv.SetInventoryVersion(EQ::versions::MobVersion::RoF2);
+
+		inv.PutItem(EQ::invslot::slotPrimary, EQ::ItemInstance(&sword));
+		TEST_ASSERT(inv.HasItem(sword.ID) == EQ::invslot::slotPrimary);
+		TEST_ASSERT(inv.HasItem(sword.ID, 0, invWherePersonal) == INVALID_INDEX);
+		TEST_ASSERT(inv.CountItem(sword.ID) == 1);
+
+		inv.PutItem(EQ::invslot::GENERAL_BEGIN, EQ::ItemInstance(&bag));
+		int16 bag_slot = EQ::InventoryProfile::CalcSlotId(EQ::invslot::GENERAL_BEGIN, 2);
+		inv.PutItem(bag_slot, EQ::ItemInstance(&arrow, 20));
+		TEST_ASSERT(inv.HasItem(arrow.ID) == bag_slot);
+		TEST_ASSERT(inv.HasItemByUse(EQ::item::ItemTypeArrow) == bag_slot);
+
+		delete inv.PopItem(EQ::invslot::GENERAL_BEGIN);
+		TEST_ASSERT(inv.HasItem(arrow.ID) == INVALID_INDEX);
+		TEST_ASSERT(inv.HasItem(bag.ID) == INVALID_INDEX);
+		TEST_ASSERT(inv.HasItemByUse(EQ::item::ItemTypeArrow) == INVALID_INDEX);
+		TEST_ASSERT(inv.CountItem(arrow.ID) == 0);
+	}
+
+	void ChargesTest() {
+		EQ::InventoryProfile inv;
+		inv.SetInventoryVersion(EQ::versions::MobVersion::RoF2);
+
+		inv.PutItem(EQ::invslot::GENERAL_BEGIN, EQ::ItemInstance(&arrow, 20));
+		inv.PutItem(EQ::invslot::GENERAL_BEGIN + 1, EQ::ItemInstance(&arrow, 20));
+		TEST_ASSERT(inv.CountItem(arrow.ID) == 40);
+		TEST_ASSERT(inv.HasItem(arrow.ID, 40) == EQ::invslot::GENERAL_BEGIN + 1);
+		TEST_ASSERT(inv.HasItem(arrow.ID, 41) == INVALID_INDEX);
+
+		inv.GetItem(EQ::invslot::GENERAL_BEGIN)->SetCharges(50);
+		TEST_ASSERT(inv.CountItem(arrow.ID) == 70);
+		TEST_ASSERT(inv.HasItem(arrow.ID, 50) == EQ::invslot::GENERAL_BEGIN);
+
+		inv.DeleteItem(EQ::invslot::GENERAL_BEGIN + 1, 5);
+		TEST_ASSERT(inv.CountItem(arrow.ID) == 65);
+		TEST_ASSERT(inv.CountItem(arrow.ID, invWhereBank) == 0);
+
+		EQ::InventoryProfile::CleanDirty();
+	}
+
+	void AugmentTest() {
+		EQ::InventoryProfile inv;
+		inv.SetInventoryVersion(EQ::versions::MobVersion::RoF2);
+
+		inv.PutItem(EQ::invslot::slotPrimary, EQ::ItemInstance(&sword));
+		inv.GetItem(EQ::invslot::slotPrimary)->PutAugment(EQ::invaug::SOCKET_BEGIN, EQ::ItemInstance(&aug));
+		TEST_ASSERT(inv.HasItem(aug.ID) == EQ::invslot::SLOT_AUGMENT_GENERIC_RETURN);
+		TEST_ASSERT(inv.HasItemByLoreGroup(aug.LoreGroup) == EQ::invslot::SLOT_AUGMENT_GENERIC_RETURN);
+		TEST_ASSERT(inv.CountItem(aug.ID) == 0);
+
+		inv.GetItem(EQ::invslot::slotPrimary)->DeleteAugment(EQ::invaug::SOCKET_BEGIN);
+		TEST_ASSERT(inv.HasItem(aug.ID) == INVALID_INDEX);
+		TEST_ASSERT(inv.HasItemByLoreGroup(aug.LoreGroup) == INVALID_INDEX);
+	}
+
+	void SwapTest() {
+		EQ::InventoryProfile inv;
+		inv.SetInventoryVersion(EQ::versions::MobVersion::RoF2);
+		EQ::InventoryProfile::SwapItemFailState fail_state;
+
+		inv.PutItem(EQ::invslot::slotPrimary, EQ::ItemInstance(&sword));
+		TEST_ASSERT(inv.SwapItem(EQ::invslot::slotPrimary, EQ::invslot::GENERAL_BEGIN, fail_state));
+		TEST_ASSERT(inv.HasItem(sword.ID, 0, invWhereWorn) == INVALID_INDEX);
+		TEST_ASSERT(inv.HasItem(sword.ID, 0, invWherePersonal) == EQ::invslot::GENERAL_BEGIN);
+
+		TEST_ASSERT(inv.SwapItem(EQ::invslot::slotPrimary, EQ::invslot::GENERAL_BEGIN, fail_state));
+		TEST_ASSERT(inv.HasItem(sword.ID, 0, invWhereWorn) == EQ::invslot::slotPrimary);
+		TEST_ASSERT(inv.CountItem(sword.ID, invWherePersonal) == 0);
+
+		inv.PutItem(EQ::invslot::GENERAL_BEGIN, EQ::ItemInstance(&arrow, 20));
+		TEST_ASSERT(inv.SwapItem(EQ::invslot::slotPrimary, EQ::invslot::GENERAL_BEGIN, fail_state));
+		TEST_ASSERT(inv.CountItem(sword.ID, invWherePersonal) == 1);
+		TEST_ASSERT(inv.CountItem(arrow.ID, invWhereWorn) == 20);
+		TEST_ASSERT(inv.CountItem(arrow.ID, invWherePersonal) == 0);
+	}
+
+	void CursorTest() {
+		EQ::InventoryProfile inv;
+		inv.SetInventoryVersion(EQ::versions::MobVersion::RoF2);
+		EQ::InventoryProfile::SwapItemFailState fail_state;
+
+		inv.PushCursor(EQ::ItemInstance(&sword));
+		inv.PushCursor(EQ::ItemInstance(&arrow, 20));
+		TEST_ASSERT(inv.CountItem(sword.ID, invWhereCursor) == 1);
+		TEST_ASSERT(inv.CountItem(arrow.ID, invWhereCursor) == 20);
+
+		TEST_ASSERT(inv.SwapItem(EQ::invslot::slotCursor, EQ::invslot::GENERAL_BEGIN, fail_state));
+		TEST_ASSERT(inv.CountItem(sword.ID, invWhereCursor) == 0);
+		TEST_ASSERT(inv.HasItem(sword.ID) == EQ::invslot::GENERAL_BEGIN);
+
+		delete inv.PopItem(EQ::invslot::slotCursor);
+		TEST_ASSERT(inv.CountItem(arrow.ID) == 0);
+	}
+
+	EQ::ItemData sword;
+	EQ::ItemData arrow;
+	EQ::ItemData bag;
+	EQ::ItemData aug;
+};
+
+#endif
@@ -0,0 +1,189 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2021 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+/**
+ * Repop plus mass loot allocation benchmark
+ *
+ * Each round repops every spawn with a loot list the way AddLootTableToNPC builds one, then
+ * loots every corpse: an item instance is created per entry, the looter's inventory keeps a
+ * clone, and the entries and instances are released in shuffled order as corpses rot and
+ * inventories turn over. The same work runs once on the global heap and once through the
+ * EQ::ObjectPool the zone uses for ServerLootItem_Struct and EQ::ItemInstance.
+ *
+ * Usage: loot_pool_benchmark [spawns] [entries per spawn] [rounds]
+ */
+
+#include "../common/eq_packet_structs.h"
+#include "../common/item_data.h"
+#include "../common/item_instance.h"
+#include "../common/object_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <list>
+#include <new>
+#include <random>
+#include <utility>
+#include <vector>
+
+// ServerLootItem_Struct's own operators are defined in the zone, both policies construct with ::new
+struct HeapAllocation {
+	template<typename T, typename... Args>
+	static T *Make(Args &&... args)
+	{
+		return ::new(::operator new(sizeof(T))) T(std::forward<Args>(args)...);
+	}
+
+	template<typename T>
+	static void Destroy(T *ptr)
+	{
+		ptr->~T();
+		::operator delete(ptr);
+	}
+};
+
+struct PoolAllocation {
+	template<typename T, typename... Args>
+	static T *Make(Args &&... args)
+	{
+		return ::new(EQ::ObjectPool<T>::Allocate(sizeof(T))) T(std::forward<Args>(args)...);
+	}
+
+	template<typename T>
+	static void Destroy(T *ptr)
+	{
+		ptr->~T();
+		EQ::ObjectPool<T>::Free(ptr, sizeof(T));
+	}
+};
+
+struct BenchmarkTimes {
+	double repop = 0.0;
+	double loot  = 0.0;
+	double rot   = 0.0;
+
+	double Total() const { return repop + loot + rot; }
+};
+
+typedef std::chrono::steady_clock BenchmarkClock;
+
+static double ElapsedMS(BenchmarkClock::time_point since)
+{
+	return std::chrono::duration<double, std::milli>(BenchmarkClock::now() - since).count();
+}
+
+template<typename Allocation>
+static BenchmarkTimes RunBenchmark(const std::vector<EQ::ItemData> &items, int spawns, int entries, int rounds)
+{
+	typedef std::list<ServerLootItem_Struct *> LootList;
+
+	BenchmarkTimes times;
+	std::mt19937   rng(1);
+
+	for (int round = 0; round < rounds; ++round) {
+		std::vector<LootList>                spawn_loot(spawns);
+		std::vector<ServerLootItem_Struct *> rotting;
+		std::vector<EQ::ItemInstance *>      looted;
+		rotting.reserve((size_t) spawns * entries);
+		looted.reserve((size_t) spawns * entries);
+
+		auto start = BenchmarkClock::now();
+		for (int spawn = 0; spawn < spawns; ++spawn) {
+			for (int entry = 0; entry < entries; ++entry) {
+				auto item = Allocation::template Make<ServerLootItem_Struct>();
+				memset(item, 0, sizeof(ServerLootItem_Struct));
+				item->item_id    = items[(spawn + entry) % items.size()].ID;
+				item->charges    = 1;
+				item->equip_slot = -1;
+				spawn_loot[spawn].push_back(item);
+			}
+		}
+		times.repop += ElapsedMS(start);
+
+		start = BenchmarkClock::now();
+		for (auto &loot : spawn_loot) {
+			for (auto item : loot) {
+				const EQ::ItemData &data = items[item->item_id - items.front().ID];
+
+				auto inst = Allocation::template Make<EQ::ItemInstance>(&data, (int16) item->charges);
+				looted.push_back(Allocation::template Make<EQ::ItemInstance>(*inst));
+				Allocation::Destroy(inst);
+
+				rotting.push_back(item);
+			}
+			loot.clear();
+		}
+		times.loot += ElapsedMS(start);
+
+		std::shuffle(rotting.begin(), rotting.end(), rng);
+		std::shuffle(looted.begin(), looted.end(), rng);
+
+		start = BenchmarkClock::now();
+		for (auto item : rotting) {
+			Allocation::Destroy(item);
+		}
+		for (auto inst : looted) {
+			Allocation::Destroy(inst);
+		}
+		times.rot += ElapsedMS(start);
+	}
+
+	return times;
+}
+
+static void PrintTimes(const char *label, const BenchmarkTimes &times)
+{
+	std::cout << label
+		<< " repop " << times.repop << " ms"
+		<< ", loot " << times.loot << " ms"
+		<< ", rot " << times.rot << " ms"
+		<< ", total " << times.Total() << " ms" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+	int spawns  = argc > 1 ? atoi(argv[1]) : 5000;
+	int entries = argc > 2 ? atoi(argv[2]) : 8;
+	int rounds  = argc > 3 ? atoi(argv[3]) : 20;
+	if (spawns <= 0 || entries <= 0 || rounds <= 0) {
+		std::cerr << "Usage: " << argv[0] << " [spawns] [entries per spawn] [rounds]" << std::endl;
+		return 1;
+	}
+
+	std::vector<EQ::ItemData> items(64);
+	for (size_t i = 0; i < items.size(); ++i) {
+		memset(&items[i], 0, sizeof(EQ::ItemData));
+		items[i].ID        = 1001 + (uint32) i;
+		items[i].ItemClass = EQ::item::ItemClassCommon;
+		items[i].Slots     = 0xFFFFFFFF;
+	}
+
+	std::cout << spawns << " spawns, " << entries << " loot entries each, " << rounds << " rounds" << std::endl;
+
+	// first pass of each warms the heap and the pool chunks, only the second is reported
+	RunBenchmark<HeapAllocation>(items, spawns, entries, 1);
+	PrintTimes("heap:", RunBenchmark<HeapAllocation>(items, spawns, entries, rounds));
+
+	RunBenchmark<PoolAllocation>(items, spawns, entries, 1);
+	PrintTimes("pool:", RunBenchmark<PoolAllocation>(items, spawns, entries, rounds));
+
+	return 0;
+}
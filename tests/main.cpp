@@ -29,6 +29,10 @@
 #include "string_util_test.h"
 #include "data_verification_test.h"
 #include "skills_util_test.h"
+#include "inbox_test.h"
+#include "task_scheduler_test.h"
+#include "object_pool_test.h"
+#include "inventory_profile_test.h"
 #include "../common/eqemu_config.h"
 
 const EQEmuConfig *Config;
@@ -49,6 +53,10 @@ int main() {
 		tests.add(new StringUtilTest());
 		tests.add(new DataVerificationTest());
 		tests.add(new SkillsUtilsTest());
+		tests.add(new InboxTest());
+		tests.add(new TaskSchedulerTest());
+		tests.add(new ObjectPoolTest());
+		tests.add(new InventoryProfileTest());
 		tests.run(*output, true);
 	} catch(...) {
 		return -1;
@@ -0,0 +1,111 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2021 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_OBJECT_POOL_H
+#define __EQEMU_TESTS_OBJECT_POOL_H
+
+#include "cppunit/cpptest.h"
+#include "../common/object_pool.h"
+#include <cstring>
+#include <set>
+#include <vector>
+
+struct PooledTestObject
+{
+	int value;
+	double pad[3];
+
+	static void* operator new(size_t size) { return EQ::ObjectPool<PooledTestObject, 4>::Allocate(size); }
+	static void operator delete(void* ptr, size_t size) { EQ::ObjectPool<PooledTestObject, 4>::Free(ptr, size); }
+};
+
+struct PooledTestDerived : public PooledTestObject
+{
+	char extra[64];
+};
+
+class ObjectPoolTest : public Test::Suite {
+	typedef void(ObjectPoolTest::*TestFunction)(void);
+public:
+	ObjectPoolTest() {
+		TEST_ADD(ObjectPoolTest::ReuseTest);
+		TEST_ADD(ObjectPoolTest::GrowTest);
+		TEST_ADD(ObjectPoolTest::DerivedTest);
+	}
+
+	~ObjectPoolTest() {
+	}
+
+	private:
+
+	void ReuseTest() {
+		auto a = new PooledTestObject();
+		a->value = 1;
+		delete a;
+
+		auto b = new PooledTestObject();
+		TEST_ASSERT(a == b);
+		delete b;
+	}
+
+	void GrowTest() {
+		std::vector<PooledTestObject*> objects;
+		std::set<PooledTestObject*> unique;
+
+		//several chunks worth
+		for (int i = 0; i < 19; ++i) {
+			auto obj = new PooledTestObject();
+			obj->value = i;
+			objects.push_back(obj);
+			unique.insert(obj);
+		}
+
+		TEST_ASSERT_EQUALS(unique.size(), objects.size());
+
+		bool intact = true;
+		for (int i = 0; i < 19; ++i) {
+			if (objects[i]->value != i) {
+				intact = false;
+			}
+		}
+		TEST_ASSERT(intact);
+
+		for (auto obj : objects) {
+			delete obj;
+		}
+	}
+
+	void DerivedTest() {
+		//leaves a block at the head of the free list
+		auto base = new PooledTestObject();
+		delete base;
+
+		//too big for a block, comes from the heap and goes back there
+		PooledTestObject *obj = new PooledTestDerived();
+		TEST_ASSERT(obj != base);
+		memset(static_cast<PooledTestDerived*>(obj)->extra, 0, sizeof(PooledTestDerived::extra));
+		delete static_cast<PooledTestDerived*>(obj);
+
+		//had the derived object been put on the list it would be handed out here
+		auto next = new PooledTestObject();
+		TEST_ASSERT(next == base);
+		delete next;
+	}
+};
+
+#endif
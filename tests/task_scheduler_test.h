@@ -0,0 +1,149 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2021 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_TASK_SCHEDULER_H
+#define __EQEMU_TESTS_TASK_SCHEDULER_H
+
+#include "cppunit/cpptest.h"
+#include "../common/event/task_scheduler.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class TaskSchedulerTest : public Test::Suite {
+	typedef void(TaskSchedulerTest::*TestFunction)(void);
+public:
+	TaskSchedulerTest() {
+		TEST_ADD(TaskSchedulerTest::EnqueueTest);
+		TEST_ADD(TaskSchedulerTest::PostTest);
+		TEST_ADD(TaskSchedulerTest::NestedTest);
+		TEST_ADD(TaskSchedulerTest::StoppedTest);
+		TEST_ADD(TaskSchedulerTest::StopWhilePostingTest);
+	}
+
+	~TaskSchedulerTest() {
+	}
+
+	private:
+
+	void EnqueueTest() {
+		EQ::Event::TaskScheduler scheduler(2);
+
+		auto a = scheduler.Enqueue([](int x, int y) { return x + y; }, 2, 3);
+		auto b = scheduler.Enqueue([]() { return std::string("done"); });
+
+		TEST_ASSERT_EQUALS(a.get(), 5);
+		TEST_ASSERT(b.get() == "done");
+	}
+
+	void PostTest() {
+		EQ::Event::TaskScheduler scheduler(4);
+		std::atomic<int> count(0);
+
+		for (int i = 0; i < 10000; ++i) {
+			scheduler.Post([&count]() { ++count; });
+		}
+
+		scheduler.Enqueue([]() {}).get();
+		while (scheduler.GetStats().queued > 0) {
+			std::this_thread::yield();
+		}
+
+		scheduler.Stop();
+		TEST_ASSERT_EQUALS(count.load(), 10000);
+		TEST_ASSERT_EQUALS(scheduler.GetStats().completed, (uint64_t)10001);
+	}
+
+	void NestedTest() {
+		EQ::Event::TaskScheduler scheduler(4);
+		std::atomic<int> count(0);
+
+		auto outer = scheduler.Enqueue(
+			[&scheduler, &count]() {
+				std::vector<std::future<void>> inner;
+				for (int i = 0; i < 100; ++i) {
+					inner.push_back(scheduler.Enqueue([&count]() { ++count; }));
+				}
+
+				for (auto &f : inner) {
+					f.get();
+				}
+			}
+		);
+
+		outer.get();
+		TEST_ASSERT_EQUALS(count.load(), 100);
+	}
+
+	void StoppedTest() {
+		EQ::Event::TaskScheduler scheduler(1);
+		scheduler.Stop();
+
+		bool thrown = false;
+		try {
+			scheduler.Post([]() {});
+		}
+		catch (std::runtime_error &) {
+			thrown = true;
+		}
+
+		TEST_ASSERT(thrown);
+	}
+
+	void StopWhilePostingTest() {
+		for (int round = 0; round < 200; ++round) {
+			EQ::Event::TaskScheduler scheduler(2);
+			std::atomic<int> accepted(0);
+			std::atomic<int> ran(0);
+			std::atomic<bool> go(false);
+
+			std::vector<std::thread> posters;
+			for (int t = 0; t < 4; ++t) {
+				posters.push_back(std::thread([&]() {
+					while (!go) {
+					}
+
+					try {
+						for (int i = 0; i < 1000; ++i) {
+							scheduler.Post([&ran]() { ++ran; });
+							++accepted;
+						}
+					}
+					catch (std::runtime_error &) {
+					}
+				}));
+			}
+
+			go = true;
+			while (accepted < 100) {
+			}
+
+			scheduler.Stop();
+
+			for (auto &t : posters) {
+				t.join();
+			}
+
+			//every task that was accepted ran before the workers exited
+			TEST_ASSERT_EQUALS(ran.load(), accepted.load());
+			TEST_ASSERT_EQUALS(scheduler.GetStats().queued, (size_t)0);
+		}
+	}
+};
+
+#endif
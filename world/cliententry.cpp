@@ -127,6 +127,7 @@ void ClientListEntry::SetChar(uint32 iCharID, const char *iCharName)
 {
 	pcharid = iCharID;
 	strn0cpy(pname, iCharName, sizeof(pname));
+	client_list.UpdateCLEIndex(this);
 }
 
 void ClientListEntry::SetOnline(ZoneServer *iZS, CLE_Status iOnline)
@@ -161,6 +162,8 @@ void ClientListEntry::SetOnline(CLE_Status iOnline)
 	if (pOnline >= CLE_Status::Online) {
 		stale = 0;
 	}
+
+	client_list.UpdateCLEIndex(this);
 }
 
 void ClientListEntry::LSUpdate(ZoneServer *iZS)
@@ -239,6 +242,8 @@ void ClientListEntry::Update(ZoneServer *iZS, ServerClientList_Struct *scl, CLE_
 		memcpy(pLFGComments, scl->LFGComments, sizeof(pLFGComments));
 	}
 
+	client_list.UpdateCLEIndex(this);
+
 	SetOnline(iOnline);
 }
 
@@ -288,6 +293,8 @@ void ClientListEntry::ClearVars(bool iAll)
 	for (auto &elem : tell_queue)
 		safe_delete_array(elem);
 	tell_queue.clear();
+
+	client_list.UpdateCLEIndex(this);
 }
 
 void ClientListEntry::Camp(ZoneServer *iZS)
@@ -358,6 +365,7 @@ bool ClientListEntry::CheckAuth(uint32 loginserver_account_id, const char *key_p
 			}
 			strn0cpy(paccountname, loginserver_account_name, sizeof(paccountname));
 			padmin = default_account_status;
+			client_list.UpdateCLEIndex(this);
 		}
 		std::string lsworldadmin;
 		if (database.GetVariable("honorlsworldadmin", lsworldadmin)) {
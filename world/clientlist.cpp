@@ -35,6 +35,7 @@
 #include "wguild_mgr.h"
 #include "world_store.h"
 #include <set>
+#include <algorithm>
 
 extern WebInterfaceList web_interface;
 
@@ -45,6 +46,8 @@ ClientList::ClientList()
 : CLStale_timer(10000)
 {
 	NextCLEID = 1;
+	cle_head_order = 0;
+	cle_tail_order = 0;
 
 	m_tick = std::make_unique<EQ::Timer>(5000, true, std::bind(&ClientList::OnTick, this, std::placeholders::_1));
 }
@@ -86,14 +89,9 @@ void ClientList::CLERemoveZSRef(ZoneServer* iZS) {
 }
 
 ClientListEntry* ClientList::GetCLE(uint32 iID) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->GetID() == iID) {
-			return iterator.GetData();
-		}
-		iterator.Advance();
+	auto it = cle_by_id.find(iID);
+	if (it != cle_by_id.end()) {
+		return it->second;
 	}
 	return 0;
 }
@@ -214,57 +212,162 @@ void ClientList::DisconnectByIP(uint32 iIP) {
 	}
 }
 
-ClientListEntry* ClientList::FindCharacter(const char* name) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+static std::string FoldCLEName(const char *name)
+{
+	std::string folded = name ? name : "";
+	std::transform(folded.begin(), folded.end(), folded.begin(), ::tolower);
+	return folded;
+}
 
-	iterator.Reset();
-	while(iterator.MoreElements())
-	{
-		if (strcasecmp(iterator.GetData()->name(), name) == 0) {
-			return iterator.GetData();
-		}
-		iterator.Advance();
+// who_class key for CLEs that are not in a zone, never requested by /who all
+static const uint32 CLE_NOT_IN_GAME = 0xFFFFFFFF;
+
+static uint32 GetCLEWhoClass(ClientListEntry *cle)
+{
+	return cle->Online() >= CLE_Status::Zoning ? cle->class_() : CLE_NOT_IN_GAME;
+}
+
+template<typename Key>
+static void AddToCLEBucket(std::unordered_map<Key, std::vector<ClientListEntry *>> &index, const Key &key, ClientListEntry *cle)
+{
+	index[key].push_back(cle);
+}
+
+template<typename Key>
+static void RemoveFromCLEBucket(std::unordered_map<Key, std::vector<ClientListEntry *>> &index, const Key &key, ClientListEntry *cle)
+{
+	auto bucket = index.find(key);
+	if (bucket == index.end()) {
+		return;
+	}
+
+	auto &entries = bucket->second;
+	entries.erase(std::remove(entries.begin(), entries.end(), cle), entries.end());
+	if (entries.empty()) {
+		index.erase(bucket);
 	}
-	return nullptr;
 }
 
-ClientListEntry* ClientList::FindCLEByAccountID(uint32 iAccID) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+template<typename Key>
+static void MoveCLEBucket(std::unordered_map<Key, std::vector<ClientListEntry *>> &index, Key &indexed_key, const Key &key, ClientListEntry *cle)
+{
+	if (indexed_key == key) {
+		return;
+	}
 
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->AccountID() == iAccID) {
-			return iterator.GetData();
-		}
-		iterator.Advance();
+	RemoveFromCLEBucket(index, indexed_key, cle);
+	AddToCLEBucket(index, key, cle);
+	indexed_key = key;
+}
+
+template<typename Key>
+static const std::vector<ClientListEntry *> *FindCLEBucket(const std::unordered_map<Key, std::vector<ClientListEntry *>> &index, const Key &key)
+{
+	auto bucket = index.find(key);
+	if (bucket == index.end()) {
+		return nullptr;
 	}
-	return nullptr;
+
+	return &bucket->second;
 }
 
-ClientListEntry* ClientList::FindCLEByCharacterID(uint32 iCharID) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+void ClientList::IndexCLE(ClientListEntry* cle, bool at_head) {
+	CLEIndexKeys keys;
+	keys.order      = at_head ? --cle_head_order : ++cle_tail_order;
+	keys.name       = FoldCLEName(cle->name());
+	keys.account_id = cle->AccountID();
+	keys.char_id    = cle->CharID();
+	keys.ls_id      = cle->LSID();
+	keys.guild_id   = cle->GuildID();
+	keys.who_class  = GetCLEWhoClass(cle);
+
+	cle_by_id[cle->GetID()] = cle;
+	AddToCLEBucket(cle_by_name, keys.name, cle);
+	AddToCLEBucket(cle_by_account_id, keys.account_id, cle);
+	AddToCLEBucket(cle_by_char_id, keys.char_id, cle);
+	AddToCLEBucket(cle_by_lsid, keys.ls_id, cle);
+	AddToCLEBucket(cle_by_guild_id, keys.guild_id, cle);
+	AddToCLEBucket(cle_in_game_by_class, keys.who_class, cle);
+
+	cle_index_keys[cle->GetID()] = keys;
+}
 
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->CharID() == iCharID) {
-			return iterator.GetData();
-		}
-		iterator.Advance();
+void ClientList::UnindexCLE(ClientListEntry* cle) {
+	auto it = cle_index_keys.find(cle->GetID());
+	if (it == cle_index_keys.end()) {
+		return;
 	}
-	return nullptr;
+
+	CLEIndexKeys &keys = it->second;
+	RemoveFromCLEBucket(cle_by_name, keys.name, cle);
+	RemoveFromCLEBucket(cle_by_account_id, keys.account_id, cle);
+	RemoveFromCLEBucket(cle_by_char_id, keys.char_id, cle);
+	RemoveFromCLEBucket(cle_by_lsid, keys.ls_id, cle);
+	RemoveFromCLEBucket(cle_by_guild_id, keys.guild_id, cle);
+	RemoveFromCLEBucket(cle_in_game_by_class, keys.who_class, cle);
+
+	cle_by_id.erase(cle->GetID());
+	cle_index_keys.erase(it);
 }
 
-ClientListEntry* ClientList::FindCLEByLSID(uint32 iLSID) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+/**
+ * Called by ClientListEntry whenever one of its lookup keys may have changed
+ *
+ * @param cle
+ */
+void ClientList::UpdateCLEIndex(ClientListEntry* cle) {
+	auto it = cle_index_keys.find(cle->GetID());
+	if (it == cle_index_keys.end()) {
+		return; // not in clientlist yet
+	}
 
-	iterator.Reset();
-	while (iterator.MoreElements()) {
-		if (iterator.GetData()->LSID() == iLSID) {
-			return iterator.GetData();
+	CLEIndexKeys &keys = it->second;
+	MoveCLEBucket(cle_by_name, keys.name, FoldCLEName(cle->name()), cle);
+	MoveCLEBucket(cle_by_account_id, keys.account_id, cle->AccountID(), cle);
+	MoveCLEBucket(cle_by_char_id, keys.char_id, cle->CharID(), cle);
+	MoveCLEBucket(cle_by_lsid, keys.ls_id, cle->LSID(), cle);
+	MoveCLEBucket(cle_by_guild_id, keys.guild_id, cle->GuildID(), cle);
+	MoveCLEBucket(cle_in_game_by_class, keys.who_class, GetCLEWhoClass(cle), cle);
+}
+
+// several CLEs can share a key (stale entries, zero ids), the linear lookups this replaces
+// returned the one closest to the head of clientlist
+ClientListEntry* ClientList::FindIndexedCLE(const std::vector<ClientListEntry *> *bucket) {
+	if (!bucket || bucket->empty()) {
+		return nullptr;
+	}
+
+	if (bucket->size() == 1) {
+		return bucket->front();
+	}
+
+	ClientListEntry *found       = nullptr;
+	int64           found_order = 0;
+	for (auto cle : *bucket) {
+		int64 order = cle_index_keys[cle->GetID()].order;
+		if (!found || order < found_order) {
+			found       = cle;
+			found_order = order;
 		}
-		iterator.Advance();
 	}
-	return nullptr;
+
+	return found;
+}
+
+ClientListEntry* ClientList::FindCharacter(const char* name) {
+	return FindIndexedCLE(FindCLEBucket(cle_by_name, FoldCLEName(name)));
+}
+
+ClientListEntry* ClientList::FindCLEByAccountID(uint32 iAccID) {
+	return FindIndexedCLE(FindCLEBucket(cle_by_account_id, iAccID));
+}
+
+ClientListEntry* ClientList::FindCLEByCharacterID(uint32 iCharID) {
+	return FindIndexedCLE(FindCLEBucket(cle_by_char_id, iCharID));
+}
+
+ClientListEntry* ClientList::FindCLEByLSID(uint32 iLSID) {
+	return FindIndexedCLE(FindCLEBucket(cle_by_lsid, iLSID));
 }
 
 void ClientList::SendCLEList(const int16& admin, const char* to, WorldTCPConnection* connection, const char* iName) {
@@ -317,6 +420,7 @@ void ClientList::CLEAdd(uint32 iLSID, const char *iLoginServerName, const char*
 	auto tmp = new ClientListEntry(GetNextCLEID(), iLSID, iLoginServerName, iLoginName, iLoginKey, iWorldAdmin, ip, local);
 
 	clientlist.Append(tmp);
+	IndexCLE(tmp, false);
 }
 
 void ClientList::CLCheckStale() {
@@ -333,22 +437,16 @@ void ClientList::CLCheckStale() {
 }
 
 void ClientList::ClientUpdate(ZoneServer* zoneserver, ServerClientList_Struct* scl) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-	ClientListEntry* cle;
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->GetID() == scl->wid) {
-			cle = iterator.GetData();
-			if (scl->remove == 2){
-				cle->LeavingZone(zoneserver, CLE_Status::Offline);
-			}
-			else if (scl->remove == 1)
-				cle->LeavingZone(zoneserver, CLE_Status::Zoning);
-			else
-				cle->Update(zoneserver, scl);
-			return;
+	ClientListEntry* cle = GetCLE(scl->wid);
+	if (cle) {
+		if (scl->remove == 2){
+			cle->LeavingZone(zoneserver, CLE_Status::Offline);
 		}
-		iterator.Advance();
+		else if (scl->remove == 1)
+			cle->LeavingZone(zoneserver, CLE_Status::Zoning);
+		else
+			cle->Update(zoneserver, scl);
+		return;
 	}
 	if (scl->remove == 2)
 		cle = new ClientListEntry(GetNextCLEID(), zoneserver, scl, CLE_Status::Online);
@@ -357,20 +455,15 @@ void ClientList::ClientUpdate(ZoneServer* zoneserver, ServerClientList_Struct* s
 	else
 		cle = new ClientListEntry(GetNextCLEID(), zoneserver, scl, CLE_Status::InZone);
 	clientlist.Insert(cle);
+	IndexCLE(cle, true);
 	zoneserver->ChangeWID(scl->charid, cle->GetID());
 }
 
 void ClientList::CLEKeepAlive(uint32 numupdates, uint32* wid) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-	uint32 i;
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		for (i=0; i<numupdates; i++) {
-			if (wid[i] == iterator.GetData()->GetID())
-				iterator.GetData()->KeepAlive();
-		}
-		iterator.Advance();
+	for (uint32 i = 0; i < numupdates; i++) {
+		ClientListEntry* cle = GetCLE(wid[i]);
+		if (cle)
+			cle->KeepAlive();
 	}
 }
 
@@ -402,26 +495,18 @@ void ClientList::SendOnlineGuildMembers(uint32 FromID, uint32 GuildID)
 		return;
 	}
 
-	LinkedListIterator<ClientListEntry*> Iterator(clientlist);
-
-	Iterator.Reset();
+	static const std::vector<ClientListEntry *> no_members;
+	auto members = FindCLEBucket(cle_by_guild_id, GuildID);
+	if (!members) {
+		members = &no_members;
+	}
 
-	while(Iterator.MoreElements())
+	for (auto CLE : *members)
 	{
-		ClientListEntry* CLE = Iterator.GetData();
-
-		if(CLE && (CLE->GuildID() == GuildID))
-		{
-			PacketLength += (strlen(CLE->name()) + 5);
-			++Count;
-		}
-
-		Iterator.Advance();
-
+		PacketLength += (strlen(CLE->name()) + 5);
+		++Count;
 	}
 
-	Iterator.Reset();
-
 	auto pack = new ServerPacket(ServerOP_OnlineGuildMembersResponse, PacketLength);
 
 	char *Buffer = (char *)pack->pBuffer;
@@ -429,29 +514,109 @@ void ClientList::SendOnlineGuildMembers(uint32 FromID, uint32 GuildID)
 	VARSTRUCT_ENCODE_TYPE(uint32, Buffer, FromID);
 	VARSTRUCT_ENCODE_TYPE(uint32, Buffer, Count);
 
-	while(Iterator.MoreElements())
+	for (auto CLE : *members)
 	{
-		ClientListEntry* CLE = Iterator.GetData();
+		VARSTRUCT_ENCODE_STRING(Buffer, CLE->name());
+		VARSTRUCT_ENCODE_TYPE(uint32, Buffer, CLE->zone());
+	}
+	zoneserver_list.SendPacket(from->zone(), from->instance(), pack);
+	safe_delete(pack);
+}
 
-		if(CLE && (CLE->GuildID() == GuildID))
-		{
-			VARSTRUCT_ENCODE_STRING(Buffer, CLE->name());
-			VARSTRUCT_ENCODE_TYPE(uint32, Buffer, CLE->zone());
+
+/**
+ * Collects the CLEs that are in a zone, in clientlist order
+ *
+ * @param class_filter class id, or 0xFFFF for every class
+ * @param into
+ */
+void ClientList::GetInGameCLEs(uint32 class_filter, std::vector<ClientListEntry *> &into) {
+	if (class_filter != 0xFFFF) {
+		auto bucket = FindCLEBucket(cle_in_game_by_class, class_filter);
+		if (bucket) {
+			into.insert(into.end(), bucket->begin(), bucket->end());
+		}
+	}
+	else {
+		for (auto &bucket : cle_in_game_by_class) {
+			if (bucket.first != CLE_NOT_IN_GAME) {
+				into.insert(into.end(), bucket.second.begin(), bucket.second.end());
+			}
 		}
+	}
 
-		Iterator.Advance();
+	std::sort(
+		into.begin(), into.end(), [this](ClientListEntry *a, ClientListEntry *b) {
+			return cle_index_keys[a->GetID()].order < cle_index_keys[b->GetID()].order;
+		}
+	);
+}
+
+bool ClientList::WhoAllMatches(ClientListEntry* cle, int16 admin, Who_All_Struct* whom, int whomlen) {
+	const char* tmpZone = ZoneName(cle->zone());
+	return (
+		(cle->Online() >= CLE_Status::Zoning) &&
+		(!cle->GetGM() || cle->Anon() != 1 || admin >= cle->Admin()) &&
+		(whom == 0 || (
+			((cle->Admin() >= 80 && cle->GetGM()) || whom->gmlookup == 0xFFFF) &&
+			(whom->lvllow == 0xFFFF || (cle->level() >= whom->lvllow && cle->level() <= whom->lvlhigh && (cle->Anon()==0 || admin>cle->Admin()))) &&
+			(whom->wclass == 0xFFFF || (cle->class_() == whom->wclass && (cle->Anon()==0 || admin>cle->Admin()))) &&
+			(whom->wrace == 0xFFFF || (cle->race() == whom->wrace && (cle->Anon()==0 || admin>cle->Admin()))) &&
+			(whomlen == 0 || (
+				(tmpZone != 0 && strncasecmp(tmpZone, whom->whom, whomlen) == 0) ||
+				strncasecmp(cle->name(),whom->whom, whomlen) == 0 ||
+				(strncasecmp(guild_mgr.GetGuildName(cle->GuildID()), whom->whom, whomlen) == 0) ||
+				(admin >= 100 && strncasecmp(cle->AccountName(), whom->whom, whomlen) == 0)
+			))
+		))
+	);
+}
+
+std::string ClientList::GetWhoAllCacheKey(int16 admin, Who_All_Struct* whom) {
+	if (!whom) {
+		return fmt::format("{}", admin);
 	}
-	zoneserver_list.SendPacket(from->zone(), from->instance(), pack);
-	safe_delete(pack);
+
+	std::string whom_name(whom->whom, strnlen(whom->whom, sizeof(whom->whom)));
+	return fmt::format(
+		"{}:{}:{}:{}:{}:{}:{}",
+		admin,
+		whom->wrace,
+		whom->wclass,
+		whom->lvllow,
+		whom->lvlhigh,
+		whom->gmlookup,
+		FoldCLEName(whom_name.c_str())
+	);
 }
 
+// takes ownership of reply
+void ClientList::CacheWhoAllReply(const std::string &key, uint32 now, ServerPacket* reply) {
+	const size_t max_entries = 256;
+
+	uint32 ttl = (uint32) RuleI(World, WhoAllCacheMS);
+	for (auto it = who_all_cache.begin(); it != who_all_cache.end();) {
+		if (now - it->second.timestamp >= ttl) {
+			it = who_all_cache.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+
+	if (who_all_cache.size() >= max_entries && who_all_cache.find(key) == who_all_cache.end()) {
+		delete reply;
+		return;
+	}
+
+	auto &entry = who_all_cache[key];
+	entry.timestamp = now;
+	entry.reply.reset(reply);
+}
 
 void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_Struct* whom, WorldTCPConnection* connection) {
 	try{
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-	LinkedListIterator<ClientListEntry*> countclients(clientlist);
 	ClientListEntry* cle = 0;
-	ClientListEntry* countcle = 0;
 	//char tmpgm[25] = "";
 	//char accinfo[150] = "";
 	char line[300] = "";
@@ -487,28 +652,34 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 			whom->wrace = FROGLOK; // This is what EQEmu uses for the Froglok Race number.
 	}
 
+	std::string cache_key;
+	uint32 now = Timer::GetCurrentTime();
+	if (RuleI(World, WhoAllCacheMS) > 0) {
+		cache_key = GetWhoAllCacheKey(admin, whom);
+
+		auto cached = who_all_cache.find(cache_key);
+		if (cached != who_all_cache.end() && now - cached->second.timestamp < (uint32) RuleI(World, WhoAllCacheMS)) {
+			memcpy(cached->second.reply->pBuffer, &fromid, sizeof(uint32));
+			SendPacket(to, cached->second.reply.get());
+			return;
+		}
+	}
+
+	//evaluate the filters once per candidate, both passes below walk the matches
+	std::vector<ClientListEntry *> matches;
+	GetInGameCLEs((whom && whom->wclass != 0xFFFF) ? whom->wclass : 0xFFFF, matches);
+	matches.erase(
+		std::remove_if(
+			matches.begin(), matches.end(), [&](ClientListEntry *candidate) {
+				return !WhoAllMatches(candidate, admin, whom, whomlen);
+			}
+		),
+		matches.end()
+	);
+
 	uint32 totalusers=0;
 	uint32 totallength=0;
-	countclients.Reset();
-	while(countclients.MoreElements()){
-		countcle = countclients.GetData();
-		const char* tmpZone = ZoneName(countcle->zone());
-		if (
-	(countcle->Online() >= CLE_Status::Zoning) &&
-	(!countcle->GetGM() || countcle->Anon() != 1 || admin >= countcle->Admin()) &&
-	(whom == 0 || (
-		((countcle->Admin() >= 80 && countcle->GetGM()) || whom->gmlookup == 0xFFFF) &&
-		(whom->lvllow == 0xFFFF || (countcle->level() >= whom->lvllow && countcle->level() <= whom->lvlhigh && (countcle->Anon()==0 || admin > countcle->Admin()))) &&
-		(whom->wclass == 0xFFFF || (countcle->class_() == whom->wclass && (countcle->Anon()==0 || admin > countcle->Admin()))) &&
-		(whom->wrace == 0xFFFF || (countcle->race() == whom->wrace && (countcle->Anon()==0 || admin > countcle->Admin()))) &&
-		(whomlen == 0 || (
-			(tmpZone != 0 && strncasecmp(tmpZone, whom->whom, whomlen) == 0) ||
-			strncasecmp(countcle->name(),whom->whom, whomlen) == 0 ||
-			(strncasecmp(guild_mgr.GetGuildName(countcle->GuildID()), whom->whom, whomlen) == 0) ||
-			(admin >= 100 && strncasecmp(countcle->AccountName(), whom->whom, whomlen) == 0)
-		))
-	))
-) {
+	for (auto countcle : matches) {
 			if((countcle->Anon()>0 && admin>=countcle->Admin() && admin>0) || countcle->Anon()==0 ){
 				totalusers++;
 				if(totalusers<=20 || admin>=100)
@@ -519,8 +690,6 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 				if(totalusers<=20 || admin>=100)
 					totallength=totallength+strlen(countcle->name())+strlen(guild_mgr.GetGuildName(countcle->GuildID()))+5;
 			}
-		}
-		countclients.Advance();
 	}
 	uint32 plid=fromid;
 	uint32 playerineqstring=5001;
@@ -567,33 +736,14 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 	memcpy(bufptr,&totalusers, sizeof(uint32));
 	bufptr+=sizeof(uint32);
 
-	iterator.Reset();
 	int idx=-1;
-	while(iterator.MoreElements()) {
-		cle = iterator.GetData();
+	for (auto match : matches) {
+		cle = match;
 
-		const char* tmpZone = ZoneName(cle->zone());
-		if (
-	(cle->Online() >= CLE_Status::Zoning) &&
-	(!cle->GetGM() || cle->Anon() != 1 || admin >= cle->Admin()) &&
-	(whom == 0 || (
-		((cle->Admin() >= 80 && cle->GetGM()) || whom->gmlookup == 0xFFFF) &&
-		(whom->lvllow == 0xFFFF || (cle->level() >= whom->lvllow && cle->level() <= whom->lvlhigh && (cle->Anon()==0 || admin>cle->Admin()))) &&
-		(whom->wclass == 0xFFFF || (cle->class_() == whom->wclass && (cle->Anon()==0 || admin>cle->Admin()))) &&
-		(whom->wrace == 0xFFFF || (cle->race() == whom->wrace && (cle->Anon()==0 || admin>cle->Admin()))) &&
-		(whomlen == 0 || (
-			(tmpZone != 0 && strncasecmp(tmpZone, whom->whom, whomlen) == 0) ||
-			strncasecmp(cle->name(),whom->whom, whomlen) == 0 ||
-			(strncasecmp(guild_mgr.GetGuildName(cle->GuildID()), whom->whom, whomlen) == 0) ||
-			(admin >= 100 && strncasecmp(cle->AccountName(), whom->whom, whomlen) == 0)
-		))
-	))
-) {
 			line[0] = 0;
 			uint32 rankstring=0xFFFFFFFF;
 				if((cle->Anon()==1 && cle->GetGM() && cle->Admin()>admin) || (idx>=20 && admin<100)){ //hide gms that are anon from lesser gms and normal players, cut off at 20
 					rankstring=0;
-					iterator.Advance();
 					continue;
 				} else if (cle->GetGM()) {
 					if (cle->Admin() >=250)
@@ -707,12 +857,16 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 	ending=207;
 	memcpy(bufptr,&ending, sizeof(uint32));
 	bufptr+=sizeof(uint32);
-		}
-		iterator.Advance();
 	}
 	//zoneserver_list.SendPacket(pack2); // NO NO NO WHY WOULD YOU SEND IT TO EVERY ZONE SERVER?!?
 	SendPacket(to,pack2);
-	safe_delete(pack2);
+
+	if (!cache_key.empty()) {
+		CacheWhoAllReply(cache_key, now, pack2);
+	}
+	else {
+		safe_delete(pack2);
+	}
 	}
 	catch(...){
 		LogInfo("Unknown error in world's SendWhoAll (probably mem error), ignoring");
@@ -934,7 +1088,7 @@ void ClientList::SendLFGMatches(ServerLFGMatchesRequest_Struct *smrs) {
 }
 
 void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct* whom, WorldTCPConnection* connection) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+	std::vector<ClientListEntry *> candidates;
 	ClientListEntry* cle = 0;
 	char tmpgm[25] = "";
 	char accinfo[150] = "";
@@ -952,9 +1106,9 @@ void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct*
 		fmt::format_to(out, "\r\n");
 	else
 		fmt::format_to(out, "\n");
-	iterator.Reset();
-	while (iterator.MoreElements()) {
-		cle = iterator.GetData();
+	GetInGameCLEs((whom && whom->wclass != 0xFFFF) ? whom->wclass : 0xFFFF, candidates);
+	for (auto candidate : candidates) {
+		cle = candidate;
 		const char* tmpZone = ZoneName(cle->zone());
 		if (
 			(cle->Online() >= CLE_Status::Zoning)
@@ -1028,7 +1182,6 @@ void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct*
 				if (admin >= 100 && admin >= cle->Admin())
 					sprintf(line, "  %s[RolePlay %i %s] %s (%s)%s zone: %s%s%s", tmpgm, cle->level(), GetClassIDName(cle->class_(), cle->level()), cle->name(), GetRaceIDName(cle->race()), tmpguild, tmpZone, LFG, accinfo);
 				else if (cle->Admin() >= 80 && admin < 80 && cle->GetGM()) {
-					iterator.Advance();
 					continue;
 				}
 				else
@@ -1038,7 +1191,6 @@ void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct*
 				if (admin >= 100 && admin >= cle->Admin())
 					sprintf(line, "  %s[ANON %i %s] %s (%s)%s zone: %s%s%s", tmpgm, cle->level(), GetClassIDName(cle->class_(), cle->level()), cle->name(), GetRaceIDName(cle->race()), tmpguild, tmpZone, LFG, accinfo);
 				else if (cle->Admin() >= 80 && cle->GetGM()) {
-					iterator.Advance();
 					continue;
 				}
 				else
@@ -1063,7 +1215,6 @@ void ClientList::ConsoleSendWhoAll(const char* to, int16 admin, Who_All_Struct*
 			if (x >= 20 && admin < 80)
 				break;
 		}
-		iterator.Advance();
 	}
 
 	if (x >= 20 && admin < 80)
@@ -1150,6 +1301,8 @@ void ClientList::ZoneBootup(ZoneServer* zs) {
 }
 
 void ClientList::RemoveCLEReferances(ClientListEntry* cle) {
+	UnindexCLE(cle);
+
 	LinkedListIterator<Client*> iterator(list);
 
 	iterator.Reset();
@@ -1194,14 +1347,11 @@ bool ClientList::SendPacket(const char* to, ServerPacket* pack) {
 void ClientList::SendGuildPacket(uint32 guild_id, ServerPacket* pack) {
 	std::set<uint32> zone_ids;
 
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->GuildID() == guild_id) {
-			zone_ids.insert(iterator.GetData()->zone());
+	auto members = FindCLEBucket(cle_by_guild_id, guild_id);
+	if (members) {
+		for (auto cle : *members) {
+			zone_ids.insert(cle->zone());
 		}
-		iterator.Advance();
 	}
 
 	//now we know all the zones, send it to each one... this is kinda a shitty way to do this
@@ -1215,15 +1365,16 @@ void ClientList::SendGuildPacket(uint32 guild_id, ServerPacket* pack) {
 }
 
 void ClientList::UpdateClientGuild(uint32 char_id, uint32 guild_id) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+	auto characters = FindCLEBucket(cle_by_char_id, char_id);
+	if (!characters) {
+		return;
+	}
 
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		ClientListEntry *cle = iterator.GetData();
-		if (cle->CharID() == char_id) {
-			cle->SetGuild(guild_id);
-		}
-		iterator.Advance();
+	// copied, SetGuild re-buckets the guild index while we walk
+	std::vector<ClientListEntry *> entries(*characters);
+	for (auto cle : entries) {
+		cle->SetGuild(guild_id);
+		UpdateCLEIndex(cle);
 	}
 }
 
@@ -11,6 +11,7 @@
 #include "../common/net/console_server_connection.h"
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 class Client;
 class ZoneServer;
@@ -65,6 +66,7 @@ public:
 	void	CLEAdd(uint32 iLSID, const char* iLoginServerName, const char* iLoginName, const char* iLoginKey, int16 iWorldAdmin = 0, uint32 ip = 0, uint8 local=0);
 	void	UpdateClientGuild(uint32 char_id, uint32 guild_id);
 	void	RemoveCLEByLSID(uint32 iLSID);
+	void	UpdateCLEIndex(ClientListEntry* cle);
 	bool    IsAccountInGame(uint32 iLSID);
 
 	int GetClientCount();
@@ -84,6 +86,44 @@ private:
 	uint32 NextCLEID;
 	LinkedList<ClientListEntry *> clientlist;
 
+	//lookup indexes over clientlist, CLEs keep them current through UpdateCLEIndex
+	struct CLEIndexKeys {
+		int64       order; //position in clientlist, lower is closer to the head
+		std::string name;  //case folded
+		uint32      account_id;
+		uint32      char_id;
+		uint32      ls_id;
+		uint32      guild_id;
+		uint32      who_class; //class_() while in game, CLE_NOT_IN_GAME otherwise
+	};
+	typedef std::unordered_map<uint32, std::vector<ClientListEntry *>> CLEIndex;
+
+	void	IndexCLE(ClientListEntry* cle, bool at_head);
+	void	UnindexCLE(ClientListEntry* cle);
+	ClientListEntry* FindIndexedCLE(const std::vector<ClientListEntry *> *bucket);
+	void	GetInGameCLEs(uint32 class_filter, std::vector<ClientListEntry *> &into);
+	bool	WhoAllMatches(ClientListEntry* cle, int16 admin, Who_All_Struct* whom, int whomlen);
+	std::string GetWhoAllCacheKey(int16 admin, Who_All_Struct* whom);
+	void	CacheWhoAllReply(const std::string &key, uint32 now, ServerPacket* reply);
+
+	std::unordered_map<uint32, ClientListEntry *>                       cle_by_id;
+	std::unordered_map<uint32, CLEIndexKeys>                            cle_index_keys;
+	std::unordered_map<std::string, std::vector<ClientListEntry *>>     cle_by_name;
+	CLEIndex cle_by_account_id;
+	CLEIndex cle_by_char_id;
+	CLEIndex cle_by_lsid;
+	CLEIndex cle_by_guild_id;
+	CLEIndex cle_in_game_by_class;
+	int64    cle_head_order;
+	int64    cle_tail_order;
+
+	//recent /who all replies keyed by query and requester status, see World:WhoAllCacheMS
+	struct WhoAllCacheEntry {
+		uint32                        timestamp;
+		std::unique_ptr<ServerPacket> reply;
+	};
+	std::unordered_map<std::string, WhoAllCacheEntry> who_all_cache;
+
 
 	std::unique_ptr<EQ::Timer> m_tick;
 };
@@ -549,6 +549,8 @@ int main(int argc, char** argv) {
 	opts.daybreak_options.resend_delay_min = RuleI(Network, ResendDelayMinMS);
 	opts.daybreak_options.resend_delay_max = RuleI(Network, ResendDelayMaxMS);
 	opts.daybreak_options.outgoing_data_rate = RuleR(Network, ClientDataRate);
+	opts.daybreak_options.adaptive_combine = RuleB(Network, AdaptiveCombine);
+	opts.io_thread = RuleB(Network, DedicatedIOThread);
 
 	EQ::Net::EQStreamManager eqsm(opts);
 
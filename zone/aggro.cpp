@@ -909,7 +909,7 @@ bool Mob::CheckLosFN(Mob *other)
 	bool Result = false;
 
 	if (other) {
-		Result = CheckLosFN(other->GetX(), other->GetY(), other->GetZ(), other->GetSize());
+		Result = CheckLosFN(other->GetX(), other->GetY(), other->GetZ(), other->GetSize(), other->GetID());
 	}
 
 	SetLastLosState(Result);
@@ -917,7 +917,8 @@ bool Mob::CheckLosFN(Mob *other)
 	return Result;
 }
 
-bool Mob::CheckLosFN(float posX, float posY, float posZ, float mobSize) {
+//target_id lets the zone reuse the result for this pair while neither side moves
+bool Mob::CheckLosFN(float posX, float posY, float posZ, float mobSize, uint16 target_id) {
 	if(zone->zonemap == nullptr) {
 		//not sure what the best return is on error
 		//should make this a database variable, but im lazy today
@@ -944,7 +945,7 @@ bool Mob::CheckLosFN(float posX, float posY, float posZ, float mobSize) {
 #if LOSDEBUG>=5
 	LogDebug("LOS from ([{}], [{}], [{}]) to ([{}], [{}], [{}]) sizes: ([{}], [{}])", myloc.x, myloc.y, myloc.z, oloc.x, oloc.y, oloc.z, GetSize(), mobSize);
 #endif
-	return zone->zonemap->CheckLoS(myloc, oloc);
+	return zone->CheckLoS(GetID(), target_id, myloc, oloc);
 }
 
 bool Mob::CheckLosFN(glm::vec3 posWatcher, float sizeWatcher, glm::vec3 posTarget, float sizeTarget) {
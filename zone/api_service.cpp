@@ -117,6 +117,9 @@ Json::Value ApiGetPacketStatistics(EQ::Net::WebsocketServerConnection *connectio
 		row["resent_fragments"]         = stats.resent_fragments;
 		row["resent_non_fragments"]     = stats.resent_full;
 		row["dropped_datarate_packets"] = stats.dropped_datarate_packets;
+		row["combined_datagrams"]       = stats.combined_datagrams;
+		row["combined_packets"]         = stats.combined_packets;
+		row["coalesced_acks"]           = stats.coalesced_acks;
 
 		Json::Value sent_packet_types;
 
@@ -714,6 +714,7 @@ bool Aura::Process()
 
 	if (movement_type == AuraMovement::Follow && GetPosition() != owner->GetPosition() && movement_timer.Check()) {
 		m_Position = owner->GetPosition();
+		UpdatePositionTable();
 		auto app = new EQApplicationPacket(OP_ClientUpdate, sizeof(PlayerPositionUpdateServer_Struct));
 		auto spu = (PlayerPositionUpdateServer_Struct *) app->pBuffer;
 		MakeSpawnUpdate(spu);
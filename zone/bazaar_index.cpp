@@ -0,0 +1,511 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2021 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include <algorithm>
+#include <cctype>
+
+#include "../common/eq_constants.h"
+#include "../common/item_data.h"
+#include "bazaar_index.h"
+#include "zonedb.h"
+
+static std::string FoldName(const char *name)
+{
+	std::string folded = name ? name : "";
+	std::transform(folded.begin(), folded.end(), folded.begin(), ::tolower);
+	return folded;
+}
+
+static uint32 PackTrigram(const std::string &s, size_t pos)
+{
+	return ((uint32) (uint8) s[pos] << 16) | ((uint32) (uint8) s[pos + 1] << 8) | (uint32) (uint8) s[pos + 2];
+}
+
+// bit n-1 of mask, how MID(REVERSE(BIN(mask)), n, 1) = 1 read it
+static bool HasBit(uint32 mask, uint32 position)
+{
+	return position >= 1 && position <= 32 && (mask & (1u << (position - 1))) != 0;
+}
+
+void BazaarIndex::AddListing(uint32 char_id, uint32 item_id, uint32 serial_number, int32 charges, uint32 cost, uint8 slot_id)
+{
+	RemoveListing(char_id, slot_id);
+
+	const EQ::ItemData *item = database.GetItem(item_id);
+	if (!item) {
+		return;
+	}
+
+	auto &listing = m_traders[char_id][slot_id];
+	listing.char_id       = char_id;
+	listing.item_id       = item_id;
+	listing.serial_number = serial_number;
+	listing.charges       = charges;
+	listing.cost          = cost;
+	listing.slot_id       = slot_id;
+
+	auto listed = m_items.find(item_id);
+	if (listed == m_items.end()) {
+		ListedItem entry;
+		entry.item        = item;
+		entry.folded_name = FoldName(item->Name);
+		IndexName(item_id, entry.folded_name);
+		listed = m_items.emplace(item_id, std::move(entry)).first;
+	}
+
+	listed->second.listings.push_back(&listing);
+}
+
+void BazaarIndex::RemoveListing(uint32 char_id, uint8 slot_id)
+{
+	auto trader = m_traders.find(char_id);
+	if (trader == m_traders.end()) {
+		return;
+	}
+
+	auto listing = trader->second.find(slot_id);
+	if (listing == trader->second.end()) {
+		return;
+	}
+
+	UnlinkListing(&listing->second);
+	trader->second.erase(listing);
+	if (trader->second.empty()) {
+		m_traders.erase(trader);
+	}
+}
+
+void BazaarIndex::RemoveTrader(uint32 char_id)
+{
+	auto trader = m_traders.find(char_id);
+	if (trader == m_traders.end()) {
+		return;
+	}
+
+	for (auto &listing : trader->second) {
+		UnlinkListing(&listing.second);
+	}
+
+	m_traders.erase(trader);
+}
+
+void BazaarIndex::RemoveItem(uint32 char_id, uint32 item_id)
+{
+	auto trader = m_traders.find(char_id);
+	if (trader == m_traders.end()) {
+		return;
+	}
+
+	for (auto listing = trader->second.begin(); listing != trader->second.end();) {
+		if (listing->second.item_id == item_id) {
+			UnlinkListing(&listing->second);
+			listing = trader->second.erase(listing);
+		}
+		else {
+			++listing;
+		}
+	}
+
+	if (trader->second.empty()) {
+		m_traders.erase(trader);
+	}
+}
+
+void BazaarIndex::UpdateCharges(uint32 char_id, uint32 serial_number, int32 charges)
+{
+	auto trader = m_traders.find(char_id);
+	if (trader == m_traders.end()) {
+		return;
+	}
+
+	for (auto &listing : trader->second) {
+		if (listing.second.serial_number == serial_number) {
+			listing.second.charges = charges;
+		}
+	}
+}
+
+void BazaarIndex::UpdatePrice(uint32 char_id, uint32 item_id, int32 charges, bool match_charges, uint32 cost)
+{
+	auto trader = m_traders.find(char_id);
+	if (trader == m_traders.end()) {
+		return;
+	}
+
+	for (auto &listing : trader->second) {
+		if (listing.second.item_id == item_id && (!match_charges || listing.second.charges == charges)) {
+			listing.second.cost = cost;
+		}
+	}
+}
+
+void BazaarIndex::Clear()
+{
+	m_traders.clear();
+	m_items.clear();
+	m_name_trigrams.clear();
+}
+
+void BazaarIndex::UnlinkListing(const BazaarListing *listing)
+{
+	auto listed = m_items.find(listing->item_id);
+	if (listed == m_items.end()) {
+		return;
+	}
+
+	auto &listings = listed->second.listings;
+	listings.erase(std::remove(listings.begin(), listings.end(), listing), listings.end());
+	if (listings.empty()) {
+		UnindexName(listed->first, listed->second.folded_name);
+		m_items.erase(listed);
+	}
+}
+
+void BazaarIndex::IndexName(uint32 item_id, const std::string &folded_name)
+{
+	std::vector<uint32> trigrams;
+	for (size_t i = 0; i + 3 <= folded_name.length(); ++i) {
+		trigrams.push_back(PackTrigram(folded_name, i));
+	}
+
+	std::sort(trigrams.begin(), trigrams.end());
+	trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+	for (auto trigram : trigrams) {
+		m_name_trigrams[trigram].push_back(item_id);
+	}
+}
+
+void BazaarIndex::UnindexName(uint32 item_id, const std::string &folded_name)
+{
+	for (size_t i = 0; i + 3 <= folded_name.length(); ++i) {
+		auto posting = m_name_trigrams.find(PackTrigram(folded_name, i));
+		if (posting == m_name_trigrams.end()) {
+			continue; // repeated trigram, already removed
+		}
+
+		auto &ids = posting->second;
+		ids.erase(std::remove(ids.begin(), ids.end(), item_id), ids.end());
+		if (ids.empty()) {
+			m_name_trigrams.erase(posting);
+		}
+	}
+}
+
+/**
+ * Case insensitive substring test, an apostrophe in the search text matches any character
+ * (searches used to turn them into LIKE wildcards)
+ *
+ * @param folded_name
+ * @param folded_search
+ * @return
+ */
+bool BazaarIndex::MatchesName(const std::string &folded_name, const std::string &folded_search)
+{
+	if (folded_search.length() > folded_name.length()) {
+		return false;
+	}
+
+	for (size_t start = 0; start + folded_search.length() <= folded_name.length(); ++start) {
+		size_t i = 0;
+		while (i < folded_search.length() && (folded_search[i] == '\'' || folded_search[i] == folded_name[start + i])) {
+			++i;
+		}
+
+		if (i == folded_search.length()) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+uint32 BazaarIndex::GetStatValue(const EQ::ItemData *item, uint32 item_stat)
+{
+	int32 value = 0;
+	switch (item_stat) {
+		case STAT_AC:
+			value = item->AC;
+			break;
+		case STAT_AGI:
+			value = item->AAgi;
+			break;
+		case STAT_CHA:
+			value = item->ACha;
+			break;
+		case STAT_DEX:
+			value = item->ADex;
+			break;
+		case STAT_INT:
+			value = item->AInt;
+			break;
+		case STAT_STA:
+			value = item->ASta;
+			break;
+		case STAT_STR:
+			value = item->AStr;
+			break;
+		case STAT_WIS:
+			value = item->AWis;
+			break;
+		case STAT_COLD:
+			value = item->CR;
+			break;
+		case STAT_DISEASE:
+			value = item->DR;
+			break;
+		case STAT_FIRE:
+			value = item->FR;
+			break;
+		case STAT_MAGIC:
+			value = item->MR;
+			break;
+		case STAT_POISON:
+			value = item->PR;
+			break;
+		case STAT_HP:
+			value = item->HP;
+			break;
+		case STAT_MANA:
+			value = item->Mana;
+			break;
+		case STAT_ENDURANCE:
+			value = item->Endur;
+			break;
+		case STAT_ATTACK:
+			value = item->Attack;
+			break;
+		case STAT_HP_REGEN:
+			value = item->Regen;
+			break;
+		case STAT_MANA_REGEN:
+			value = item->ManaRegen;
+			break;
+		case STAT_HASTE:
+			value = item->Haste;
+			break;
+		case STAT_DAMAGE_SHIELD:
+			value = item->DamageShield;
+			break;
+		default:
+			return 0;
+	}
+
+	return value > 0 ? (uint32) value : 0;
+}
+
+static bool IsKnownStat(uint32 item_stat)
+{
+	switch (item_stat) {
+		case STAT_AC:
+		case STAT_AGI:
+		case STAT_CHA:
+		case STAT_DEX:
+		case STAT_INT:
+		case STAT_STA:
+		case STAT_STR:
+		case STAT_WIS:
+		case STAT_COLD:
+		case STAT_DISEASE:
+		case STAT_FIRE:
+		case STAT_MAGIC:
+		case STAT_POISON:
+		case STAT_HP:
+		case STAT_MANA:
+		case STAT_ENDURANCE:
+		case STAT_ATTACK:
+		case STAT_HP_REGEN:
+		case STAT_MANA_REGEN:
+		case STAT_HASTE:
+		case STAT_DAMAGE_SHIELD:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool BazaarIndex::PassesItemFilters(const EQ::ItemData *item, const BazaarSearchCriteria &criteria) const
+{
+	if (criteria.in_class != 0xFFFFFFFF && !HasBit(item->Classes, criteria.in_class)) {
+		return false;
+	}
+
+	if (criteria.in_race != 0xFFFFFFFF && !HasBit(item->Races, criteria.in_race)) {
+		return false;
+	}
+
+	if (criteria.item_slot != 0xFFFFFFFF && !HasBit(item->Slots, criteria.item_slot + 1)) {
+		return false;
+	}
+
+	switch (criteria.item_type) {
+		case 0xFFFFFFFF:
+			break;
+		case 0:
+			// 1H Slashing
+			if (item->ItemType != 0 || item->Damage == 0) {
+				return false;
+			}
+			break;
+		case 31:
+			if (item->ItemClass != 2) {
+				return false;
+			}
+			break;
+		case 46:
+			if (item->Scroll.Effect <= 0 || item->Scroll.Effect >= 65000) {
+				return false;
+			}
+			break;
+		case 47:
+			if (item->Scroll.Effect != 998) {
+				return false;
+			}
+			break;
+		case 48:
+			if (item->Scroll.Effect < 1298 || item->Scroll.Effect > 1307) {
+				return false;
+			}
+			break;
+		case 49:
+			if (item->Focus.Effect <= 0) {
+				return false;
+			}
+			break;
+		default:
+			if (item->ItemType != criteria.item_type) {
+				return false;
+			}
+	}
+
+	if (IsKnownStat(criteria.item_stat) && GetStatValue(item, criteria.item_stat) == 0) {
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Rows come out ordered by item id, charges and trader, at most limit of them
+ *
+ * @param criteria
+ * @param limit
+ * @param results
+ */
+void BazaarIndex::Search(const BazaarSearchCriteria &criteria, size_t limit, std::vector<BazaarSearchResult> &results) const
+{
+	std::string search = FoldName(criteria.name.c_str());
+
+	// narrow by the rarest trigram of the search text, apostrophes are wildcards so skip those
+	const std::vector<uint32> *candidates = nullptr;
+	bool                      use_trigrams = false;
+	for (size_t i = 0; i + 3 <= search.length(); ++i) {
+		if (search[i] == '\'' || search[i + 1] == '\'' || search[i + 2] == '\'') {
+			continue;
+		}
+
+		use_trigrams = true;
+		auto posting = m_name_trigrams.find(PackTrigram(search, i));
+		if (posting == m_name_trigrams.end()) {
+			return;
+		}
+
+		if (!candidates || posting->second.size() < candidates->size()) {
+			candidates = &posting->second;
+		}
+	}
+
+	std::vector<const ListedItem *> items;
+	if (use_trigrams) {
+		std::vector<uint32> ids(candidates->begin(), candidates->end());
+		std::sort(ids.begin(), ids.end());
+		for (auto id : ids) {
+			items.push_back(&m_items.find(id)->second);
+		}
+	}
+	else {
+		for (auto &listed : m_items) {
+			items.push_back(&listed.second);
+		}
+	}
+
+	std::vector<const BazaarListing *> listings;
+	for (auto listed : items) {
+		if (!search.empty() && !MatchesName(listed->folded_name, search)) {
+			continue;
+		}
+
+		if (!PassesItemFilters(listed->item, criteria)) {
+			continue;
+		}
+
+		listings.clear();
+		for (auto listing : listed->listings) {
+			if (criteria.char_id != 0 && listing->char_id != criteria.char_id) {
+				continue;
+			}
+
+			if (criteria.min_price != 0 && listing->cost < criteria.min_price) {
+				continue;
+			}
+
+			if (criteria.max_price != 0 && listing->cost > criteria.max_price) {
+				continue;
+			}
+
+			listings.push_back(listing);
+		}
+
+		std::sort(
+			listings.begin(), listings.end(), [](const BazaarListing *a, const BazaarListing *b) {
+				if (a->charges != b->charges) {
+					return a->charges < b->charges;
+				}
+				if (a->char_id != b->char_id) {
+					return a->char_id < b->char_id;
+				}
+				return a->slot_id < b->slot_id;
+			}
+		);
+
+		uint32 stat_value = GetStatValue(listed->item, criteria.item_stat);
+		for (size_t i = 0; i < listings.size();) {
+			if (results.size() >= limit) {
+				return;
+			}
+
+			auto first = listings[i];
+
+			BazaarSearchResult result;
+			result.item          = listed->item;
+			result.char_id       = first->char_id;
+			result.serial_number = first->serial_number;
+			result.cost          = first->cost;
+			result.charges       = first->charges;
+			result.total_charges = 0;
+			result.count         = 0;
+			result.stat_value    = stat_value;
+
+			for (; i < listings.size() && listings[i]->charges == first->charges && listings[i]->char_id == first->char_id; ++i) {
+				result.total_charges += listings[i]->charges;
+				result.count++;
+			}
+
+			results.push_back(result);
+		}
+	}
+}
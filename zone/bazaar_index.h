@@ -0,0 +1,104 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2021 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#ifndef EQEMU_BAZAAR_INDEX_H
+#define EQEMU_BAZAAR_INDEX_H
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../common/types.h"
+
+namespace EQ {
+	struct ItemData;
+}
+
+struct BazaarListing {
+	uint32 char_id;
+	uint32 item_id;
+	uint32 serial_number;
+	int32  charges;
+	uint32 cost;
+	uint8  slot_id;
+};
+
+struct BazaarSearchCriteria {
+	uint32      char_id   = 0;          // 0 = any trader
+	uint32      in_class  = 0xFFFFFFFF;
+	uint32      in_race   = 0xFFFFFFFF;
+	uint32      item_stat = 0xFFFFFFFF;
+	uint32      item_slot = 0xFFFFFFFF;
+	uint32      item_type = 0xFFFFFFFF;
+	uint32      min_price = 0;
+	uint32      max_price = 0;
+	std::string name;
+};
+
+// one row per item id, charges and trader, like the old GROUP BY over the trader table
+struct BazaarSearchResult {
+	const EQ::ItemData *item;
+	uint32             char_id;
+	uint32             serial_number;
+	uint32             cost;
+	int32              charges;
+	int32              total_charges;
+	uint32             count;
+	uint32             stat_value;
+};
+
+/**
+ * In memory mirror of the trader table, kept current by the ZoneDatabase trader calls
+ *
+ * Listed items are indexed by id and by lower cased name trigrams, so a search only looks at
+ * the items whose names can contain the search text. The class, race and slot filters test the
+ * bitmasks already held in the shared item data.
+ */
+class BazaarIndex {
+public:
+	void AddListing(uint32 char_id, uint32 item_id, uint32 serial_number, int32 charges, uint32 cost, uint8 slot_id);
+	void RemoveListing(uint32 char_id, uint8 slot_id);
+	void RemoveTrader(uint32 char_id);
+	void RemoveItem(uint32 char_id, uint32 item_id);
+	void UpdateCharges(uint32 char_id, uint32 serial_number, int32 charges);
+	void UpdatePrice(uint32 char_id, uint32 item_id, int32 charges, bool match_charges, uint32 cost);
+	void Clear();
+
+	void Search(const BazaarSearchCriteria &criteria, size_t limit, std::vector<BazaarSearchResult> &results) const;
+
+	static bool MatchesName(const std::string &folded_name, const std::string &folded_search);
+	static uint32 GetStatValue(const EQ::ItemData *item, uint32 item_stat);
+
+private:
+	struct ListedItem {
+		const EQ::ItemData                *item;
+		std::string                       folded_name;
+		std::vector<const BazaarListing *> listings;
+	};
+
+	bool PassesItemFilters(const EQ::ItemData *item, const BazaarSearchCriteria &criteria) const;
+	void IndexName(uint32 item_id, const std::string &folded_name);
+	void UnindexName(uint32 item_id, const std::string &folded_name);
+	void UnlinkListing(const BazaarListing *listing);
+
+	std::unordered_map<uint32, std::map<uint8, BazaarListing>> m_traders;       // char_id -> slot -> listing
+	std::map<uint32, ListedItem>                                m_items;         // item_id, ordered for results
+	std::unordered_map<uint32, std::vector<uint32>>             m_name_trigrams; // trigram -> item ids
+};
+
+#endif //EQEMU_BAZAAR_INDEX_H
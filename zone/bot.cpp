@@ -4014,6 +4014,7 @@ bool Bot::Spawn(Client* botCharacterOwner) {
 		this->m_Position.x = botCharacterOwner->GetX();
 		this->m_Position.y = botCharacterOwner->GetY();
 		this->m_Position.z = botCharacterOwner->GetZ();
+		UpdatePositionTable();
 
 		// Make the bot look at the bot owner
 		FaceTarget(botCharacterOwner);
@@ -9405,6 +9406,7 @@ void EntityList::AddBot(Bot *newBot, bool SendSpawnPacket, bool dontqueue) {
 		}
 		bot_list.push_back(newBot);
 		mob_list.insert(std::pair<uint16, Mob*>(newBot->GetID(), newBot));
+		mob_positions.Add(newBot);
 	}
 }
 
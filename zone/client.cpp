@@ -446,6 +446,7 @@ Client::~Client() {
 		m_Position.x = m_pp.binds[0].x;
 		m_Position.y = m_pp.binds[0].y;
 		m_Position.z = m_pp.binds[0].z;
+		UpdatePositionTable();
 	}
 
 	// we save right now, because the client might be zoning and the world
@@ -1349,6 +1349,7 @@ void Client::Handle_Connect_OP_ZoneEntry(const EQApplicationPacket *app)
 	m_Position.y = m_pp.y;
 	m_Position.z = m_pp.z;
 	m_Position.w = m_pp.heading;
+	UpdatePositionTable();
 	race = m_pp.race;
 	base_race = m_pp.race;
 	gender = m_pp.gender;
@@ -4655,6 +4656,7 @@ void Client::Handle_OP_ClientUpdate(const EQApplicationPacket *app) {
 	m_Position.x = cx;
 	m_Position.y = cy;
 	m_Position.z = cz;
+	UpdatePositionTable();
 
 	/* Visual Debugging */
 	if (RuleB(Character, OPClientUpdateVisualDebug)) {
@@ -2024,6 +2024,7 @@ void Client::HandleRespawnFromHover(uint32 Option)
 				m_Position.x = corpse->GetX();
 				m_Position.y = corpse->GetY();
 				m_Position.z = corpse->GetZ();
+				UpdatePositionTable();
 			}
 
 			auto outapp =
@@ -2082,6 +2083,7 @@ void Client::HandleRespawnFromHover(uint32 Option)
 			m_Position.y = chosen->y;
 			m_Position.z = chosen->z;
 			m_Position.w = chosen->heading;
+			UpdatePositionTable();
 
 			ClearHover();
 			entity_list.RefreshClientXTargets(this);
@@ -57,6 +57,8 @@
 #include "../common/eqemu_logsys.h"
 #include "../common/profanity_manager.h"
 #include "../common/net/eqstream.h"
+#include "../common/event/event_loop.h"
+#include "../common/event/task_scheduler.h"
 
 #include "data_bucket.h"
 #include "command.h"
@@ -79,6 +81,7 @@ extern QueryServ* QServ;
 extern WorldServer worldserver;
 extern TaskManager *task_manager;
 extern FastMath g_Math;
+extern EQ::Event::TaskScheduler *encode_pool;
 void CatchSignal(int sig_num);
 
 
@@ -5663,16 +5666,13 @@ void command_repop(Client *c, const Seperator *sep)
 	if (sep->arg[1] && strcasecmp(sep->arg[1], "force") == 0) {
 		timearg++;
 
-		LinkedListIterator<Spawn2*> iterator(zone->spawn2_list);
-		iterator.Reset();
-		while (iterator.MoreElements()) {
+		for (auto spawn : zone->spawn2_list) {
 			std::string query = StringFormat(
 				"DELETE FROM respawn_times WHERE id = %lu AND instance_id = %lu",
-				(unsigned long)iterator.GetData()->GetID(),
+				(unsigned long)spawn->GetID(),
 				(unsigned long)zone->GetInstanceID()
 			);
 			auto results = database.QueryDatabase(query);
-			iterator.Advance();
 		}
 		c->Message(Chat::White, "Zone depop: Force resetting spawn timers.");
 	}
@@ -8436,6 +8436,13 @@ void command_checklos(Client *c, const Seperator *sep)
 		else {
 			c->Message(Chat::White, "You do not have LOS to %s", c->GetTarget()->GetName());
 		}
+
+		uint64 hits = zone->GetLosCacheHits();
+		uint64 misses = zone->GetLosCacheMisses();
+		c->Message(Chat::White, "LOS cache: %llu hits, %llu misses (%.1f%% hit rate), %u pairs",
+			(unsigned long long)hits, (unsigned long long)misses,
+			hits + misses > 0 ? static_cast<double>(hits) * 100.0 / static_cast<double>(hits + misses) : 0.0,
+			(uint32)zone->GetLosCacheSize());
 	}
 	else {
 		c->Message(Chat::White, "ERROR: Target required");
@@ -8694,6 +8701,10 @@ void command_npceditmass(Client *c, const Seperator *sep)
 		);
 
 		c->Message(Chat::Yellow, "Changes applied to (%i) NPC's", found_count);
+		for (auto &npc_id : npc_ids) {
+			zone->MarkNPCTypeReloaded(std::stoul(npc_id));
+		}
+
 		zone->Repop();
 	}
 	else {
@@ -8804,6 +8815,9 @@ void command_npcedit(Client *c, const Seperator *sep)
 	}
 
 	uint32 npcTypeID = c->GetTarget()->CastToNPC()->GetNPCTypeID();
+	// edits go straight to the database, later spawns of this type must not come from shared memory
+	zone->MarkNPCTypeReloaded(npcTypeID);
+
 	if (strcasecmp(sep->arg[1], "name") == 0) {
         c->Message(Chat::Yellow,"NPCID %u now has the name %s.", npcTypeID, sep->argplus[2]);
 		std::string query = StringFormat("UPDATE npc_types SET name = '%s' WHERE id = %i",  sep->argplus[2],npcTypeID);
@@ -11086,6 +11100,18 @@ void command_netstats(Client *c, const Seperator *sep)
 		c->Message(Chat::White, "Resent Fragments: %u (%.2f/sec)", stats.resent_fragments, stats.resent_fragments / sec_since_stats_reset);
 		c->Message(Chat::White, "Resent Non-Fragments: %u (%.2f/sec)", stats.resent_full, stats.resent_full / sec_since_stats_reset);
 		c->Message(Chat::White, "Dropped Datarate Packets: %u (%.2f/sec)", stats.dropped_datarate_packets, stats.dropped_datarate_packets / sec_since_stats_reset);
+		c->Message(Chat::White, "Combined Datagrams: %u (%.2f packets each)", stats.combined_datagrams,
+			stats.combined_datagrams > 0 ? static_cast<double>(stats.combined_packets) / static_cast<double>(stats.combined_datagrams) : 0.0);
+		c->Message(Chat::White, "Coalesced Acks: %u", stats.coalesced_acks);
+
+		if (encode_pool) {
+			auto pool_stats = encode_pool->GetStats();
+			c->Message(Chat::White, "--------------------------------------------------------------------");
+			c->Message(Chat::White, "Encode Threads: %u", static_cast<uint32>(encode_pool->GetThreadCount()));
+			c->Message(Chat::White, "Encode Tasks Queued: %u", static_cast<uint32>(pool_stats.queued));
+			c->Message(Chat::White, "Encode Tasks Completed: %llu (%llu stolen)", static_cast<unsigned long long>(pool_stats.completed), static_cast<unsigned long long>(pool_stats.stolen));
+			c->Message(Chat::White, "Encode Task Wait: %.3fms avg, %.3fms max", pool_stats.avg_wait_ms, pool_stats.max_wait_ms);
+		}
 
 		if (opts.daybreak_options.outgoing_data_rate > 0.0) {
 			c->Message(Chat::White, "Outgoing Link Saturation %.2f%% (%.2fkb/sec)", 100.0 * (1.0 - ((opts.daybreak_options.outgoing_data_rate - stats.datarate_remaining) / opts.daybreak_options.outgoing_data_rate)), opts.daybreak_options.outgoing_data_rate);
@@ -13445,8 +13471,12 @@ void command_hotfix(Client *c, const Seperator *sep)
 	}
 
 	c->Message(Chat::White, "Creating and applying hotfix");
+
+	// the rest runs back on the zone thread once shared_memory has finished
+	auto &loop = EQ::EventLoop::Get();
+	uint32 character_id = c->CharacterID();
 	std::thread t1(
-		[c, hotfix_name]() {
+		[&loop, character_id, hotfix_name]() {
 
 			std::string shared_memory_path;
 
@@ -13479,15 +13509,20 @@ void command_hotfix(Client *c, const Seperator *sep)
 				if (system(StringFormat("%s", shared_memory_path.c_str()).c_str())) {}
 			}
 #endif
-			database.SetVariable("hotfix_name", hotfix_name);
+			loop.Post(
+				[character_id, hotfix_name]() {
+					database.SetVariable("hotfix_name", hotfix_name);
 
-			ServerPacket pack(ServerOP_ChangeSharedMem, hotfix_name.length() + 1);
-			if (hotfix_name.length() > 0) {
-				strcpy((char *) pack.pBuffer, hotfix_name.c_str());
-			}
-			worldserver.SendPacket(&pack);
+					ServerPacket pack(ServerOP_ChangeSharedMem, hotfix_name.length() + 1);
+					if (hotfix_name.length() > 0) {
+						strcpy((char *) pack.pBuffer, hotfix_name.c_str());
+					}
+					worldserver.SendPacket(&pack);
 
-			if (c) { c->Message(Chat::White, "Hotfix applied"); }
+					auto c = entity_list.GetClientByCharID(character_id);
+					if (c) { c->Message(Chat::White, "Hotfix applied"); }
+				}
+			);
 		}
 	);
 
@@ -13506,7 +13541,9 @@ void command_load_shared_memory(Client *c, const Seperator *sep) {
 
 	hotfix_name = sep->arg[1];
 	c->Message(Chat::White, "Loading shared memory segment %s", hotfix_name.c_str());
-	std::thread t1([c,hotfix_name]() {
+	auto &loop = EQ::EventLoop::Get();
+	uint32 character_id = c->CharacterID();
+	std::thread t1([&loop, character_id, hotfix_name]() {
 #ifdef WIN32
 		if(hotfix_name.length() > 0) {
 			if(system(StringFormat("shared_memory -hotfix=%s", hotfix_name.c_str()).c_str()));
@@ -13521,7 +13558,10 @@ void command_load_shared_memory(Client *c, const Seperator *sep) {
 			if(system(StringFormat("./shared_memory").c_str()));
 		}
 #endif
-		c->Message(Chat::White, "Shared memory segment finished loading.");
+		loop.Post([character_id]() {
+			auto c = entity_list.GetClientByCharID(character_id);
+			if (c) { c->Message(Chat::White, "Shared memory segment finished loading."); }
+		});
 	});
 
 	t1.detach();
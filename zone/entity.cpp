@@ -21,6 +21,7 @@
 #include <stdarg.h>
 #include <string.h>
 #include <iostream>
+#include <boost/container/small_vector.hpp>
 
 #ifdef _WINDOWS
 #include <process.h>
@@ -348,6 +349,7 @@ void EntityList::AddClient(Client *client)
 	client->SetID(GetFreeID());
 	client_list.insert(std::pair<uint16, Client *>(client->GetID(), client));
 	mob_list.insert(std::pair<uint16, Mob *>(client->GetID(), client));
+	mob_positions.Add(client);
 }
 
 
@@ -488,9 +490,70 @@ void EntityList::CorpseProcess()
 	}
 }
 
+void EntityList::ProcessEntityTimers(bool zone_awake)
+{
+	// taken out of the member while dispatching so a nested call starts with an empty list
+	EntityTimerService::Expired expired;
+	expired.swap(expired_entity_timers);
+	expired.clear();
+	entity_timers.Process(Timer::GetCurrentTime(), expired);
+
+	for (auto &e : expired) {
+		NPC *npc = GetNPCByID(e.first);
+		if (!npc) {
+			continue;
+		}
+
+		// idle zones leave their npcs alone, look again once the zone may have woken up
+		if (!zone_awake && npc->GetWanderType() != 4 && npc->GetWanderType() != 6) {
+			entity_timers.Schedule(e.first, e.second, 1000);
+			continue;
+		}
+
+		npc->ProcessEntityTimer(e.second);
+	}
+
+	expired.clear();
+	expired_entity_timers.swap(expired);
+}
+
+void EntityList::ScheduleEntityTimer(uint16 entity_id, EntityTimer timer_id, uint32 delay)
+{
+	entity_timers.Schedule(entity_id, timer_id, delay);
+}
+
+void EntityList::CancelEntityTimer(uint16 entity_id, EntityTimer timer_id)
+{
+	entity_timers.Cancel(entity_id, timer_id);
+}
+
 void EntityList::MobProcess()
 {
 	bool mob_dead;
+	bool zone_awake = true;
+
+#ifdef IDLE_WHEN_EMPTY
+	static int old_client_count=0;
+	static Timer *mob_settle_timer = new Timer();
+
+	if (numclients == 0 && old_client_count > 0 &&
+		RuleI(Zone, SecondsBeforeIdle) > 0) {
+		// Start Timer to allow any mobs that chased chars from zone
+		// to return home.
+		mob_settle_timer->Start(RuleI(Zone, SecondsBeforeIdle) * 1000);
+	}
+
+	old_client_count = numclients;
+
+	// Disable settle timer if someone zones into empty zone
+	if (numclients > 0 || mob_settle_timer->Check()) {
+		mob_settle_timer->Disable();
+	}
+
+	zone_awake = zone->process_mobs_while_empty || numclients > 0 || mob_settle_timer->Enabled();
+#endif
+
+	ProcessEntityTimers(zone_awake);
 
 	auto it = mob_list.begin();
 	while (it != mob_list.end()) {
@@ -500,26 +563,7 @@ void EntityList::MobProcess()
 		size_t sz = mob_list.size();
 
 #ifdef IDLE_WHEN_EMPTY
-		static int old_client_count=0;
-		static Timer *mob_settle_timer = new Timer();
-
-		if (numclients == 0 && old_client_count > 0 &&
-			RuleI(Zone, SecondsBeforeIdle) > 0) {
-			// Start Timer to allow any mobs that chased chars from zone
-			// to return home.
-			mob_settle_timer->Start(RuleI(Zone, SecondsBeforeIdle) * 1000);
-		}
-
-		old_client_count = numclients;
-
-		// Disable settle timer if someone zones into empty zone
-		if (numclients > 0 || mob_settle_timer->Check()) {
-			mob_settle_timer->Disable();
-		}
-
-		if (zone->process_mobs_while_empty || numclients > 0 ||
-			mob->GetWanderType() == 4 || mob->GetWanderType() == 6 ||
-			mob_settle_timer->Enabled()) {
+		if (zone_awake || mob->GetWanderType() == 4 || mob->GetWanderType() == 6) {
 			// Normal processing, or assuring that spawns that should
 			// path and depop do that.  Otherwise all of these type mobs
 			// will be up and at starting positions, or waiting at the zoneline
@@ -715,6 +759,9 @@ void EntityList::AddNPC(NPC *npc, bool SendSpawnPacket, bool dontqueue)
 
 	npc_list.insert(std::pair<uint16, NPC *>(npc->GetID(), npc));
 	mob_list.insert(std::pair<uint16, Mob *>(npc->GetID(), npc));
+	mob_positions.Add(npc);
+
+	npc->ScheduleEntityTimers();
 
 	entity_list.ScanCloseMobs(npc->close_mobs, npc, true);
 
@@ -765,6 +812,7 @@ void EntityList::AddMerc(Merc *merc, bool SendSpawnPacket, bool dontqueue)
 
 		merc_list.insert(std::pair<uint16, Merc *>(merc->GetID(), merc));
 		mob_list.insert(std::pair<uint16, Mob *>(merc->GetID(), merc));
+		mob_positions.Add(merc);
 	}
 }
 
@@ -1654,23 +1702,17 @@ void EntityList::QueueCloseClients(
 
 	float distance_squared = distance * distance;
 
-	for (auto &e : GetCloseMobList(sender, distance)) {
-		Mob *mob = e.second;
-
-		if (!mob->IsClient()) {
-			continue;
-		}
-
+	mob_positions.ForEachInRange(glm::vec3(sender->GetPosition()), distance_squared, MobPositionTable::TypeClient, [&](Mob *mob) {
 		Client *client = mob->CastToClient();
 
 		if ((!ignore_sender || client != sender) && (client != skipped_mob)) {
 
 			if (DistanceSquared(client->GetPosition(), sender->GetPosition()) >= distance_squared) {
-				continue;
+				return;
 			}
 
 			if (!client->Connected()) {
-				continue;
+				return;
 			}
 
 			eqFilterMode client_filter = client->GetFilter(filter);
@@ -1683,7 +1725,7 @@ void EntityList::QueueCloseClients(
 				client->QueuePacket(app, is_ack_required, Client::CLIENT_CONNECTED);
 			}
 		}
-	}
+	});
 }
 
 //sender can be null
@@ -1869,17 +1911,7 @@ Spawn2 *EntityList::GetSpawnByID(uint32 id)
 	if (!zone || !zone->IsLoaded())
 		return nullptr;
 
-	LinkedListIterator<Spawn2 *> iterator(zone->spawn2_list);
-	iterator.Reset();
-	while(iterator.MoreElements())
-	{
-		if(iterator.GetData()->GetID() == id) {
-			return iterator.GetData();
-		}
-		iterator.Advance();
-	}
-
-	return nullptr;
+	return zone->spawn2_list.GetByID(id);
 }
 
 void EntityList::RemoveAllCorpsesByCharID(uint32 charid)
@@ -2456,6 +2488,8 @@ void EntityList::RemoveAllMobs()
 		free_ids.push(it->first);
 		it = mob_list.erase(it);
 	}
+
+	mob_positions.Clear();
 }
 
 void EntityList::RemoveAllClients()
@@ -2469,6 +2503,7 @@ void EntityList::RemoveAllNPCs()
 	// doesn't clear the data
 	npc_list.clear();
 	npc_limit_list.clear();
+	entity_timers.Clear();
 }
 
 void EntityList::RemoveAllMercs()
@@ -2592,6 +2627,7 @@ bool EntityList::RemoveMob(uint16 delete_id)
 		else if (client_list.count(delete_id)) {
 			entity_list.RemoveClient(delete_id);
 		}
+		mob_positions.Remove(it->second);
 		safe_delete(it->second);
 		if (!corpse_list.count(delete_id)) {
 			free_ids.push(it->first);
@@ -2615,6 +2651,7 @@ bool EntityList::RemoveMob(Mob *delete_mob)
 	auto it = mob_list.begin();
 	while (it != mob_list.end()) {
 		if (it->second == delete_mob) {
+			mob_positions.Remove(it->second);
 			safe_delete(it->second);
 			if (!corpse_list.count(it->first)) {
 				free_ids.push(it->first);
@@ -2638,6 +2675,7 @@ bool EntityList::RemoveNPC(uint16 delete_id)
 		NPC *npc = it->second;
 		RemoveProximity(delete_id);
 		npc_list.erase(it);
+		entity_timers.CancelAll(delete_id);
 
 		if (npc_limit_list.count(delete_id)) {
 			npc_limit_list.erase(delete_id);
@@ -2740,19 +2778,20 @@ void EntityList::ScanCloseMobs(
 
 	close_mobs.clear();
 
-	for (auto &e : mob_list) {
-		auto mob = e.second;
-
-		if (!mob->IsNPC() && !mob->IsClient()) {
-			continue;
-		}
-
-		if (mob->GetID() <= 0) {
-			continue;
-		}
+	// aggro ranges in the table are refreshed when a mob moves or runs its own scan
+	mob_positions.Update(scanning_mob);
+
+	mob_positions.ForEachInRange(
+		glm::vec3(scanning_mob->GetPosition()),
+		scan_range,
+		scan_range,
+		MobPositionTable::TypeClient | MobPositionTable::TypeNPC,
+		[&](Mob *mob) {
+			//dead mobs linger in the list with id 0 until they are removed
+			if (mob->GetID() <= 0) {
+				return;
+			}
 
-		float distance = DistanceSquared(scanning_mob->GetPosition(), mob->GetPosition());
-		if (distance <= scan_range || mob->GetAggroRange() >= scan_range) {
 			close_mobs.insert(std::pair<uint16, Mob *>(mob->GetID(), mob));
 
 			if (add_self_to_other_lists && scanning_mob->GetID() > 0) {
@@ -2770,7 +2809,7 @@ void EntityList::ScanCloseMobs(
 				}
 			}
 		}
-	}
+	);
 
 	LogAIScanClose(
 		"[{}] Scanning Close List | list_size [{}] moving [{}]",
@@ -3042,18 +3081,23 @@ void EntityList::SendTraders(Client *client)
 
 void EntityList::RemoveFromHateLists(Mob *mob, bool settoone)
 {
-	auto it = npc_list.begin();
-	while (it != npc_list.end()) {
-		if (it->second->CheckAggro(mob)) {
+	// only the npcs that have mob on their hate list, copied since removal updates the set
+	std::vector<Mob *> hate_list_owners(mob->hate_list_owners.begin(), mob->hate_list_owners.end());
+	for (auto owner : hate_list_owners) {
+		if (!owner->IsNPC()) {
+			continue;
+		}
+
+		NPC *npc = owner->CastToNPC();
+		if (npc->CheckAggro(mob)) {
 			if (!settoone) {
-				it->second->RemoveFromHateList(mob);
+				npc->RemoveFromHateList(mob);
 				if (mob->IsClient())
-					mob->CastToClient()->RemoveXTarget(it->second, false); // gotta do book keeping
+					mob->CastToClient()->RemoveXTarget(npc, false); // gotta do book keeping
 			} else {
-				it->second->SetHateAmountOnEnt(mob, 1);
+				npc->SetHateAmountOnEnt(mob, 1);
 			}
 		}
-		++it;
 	}
 }
 
@@ -3658,6 +3702,22 @@ void EntityList::AddProximity(NPC *proximity_for)
 	proximity_for->proximity = new NPCProximity; // deleted in NPC::~NPC
 }
 
+/**
+ * Re-indexes an NPC's proximity box, must be called after the bounds are (re)set
+ *
+ * @param proximity_for
+ */
+void EntityList::UpdateProximity(NPC *proximity_for)
+{
+	NPCProximity *l = proximity_for->proximity;
+	if (l == nullptr) {
+		proximity_grid.Remove(proximity_for);
+		return;
+	}
+
+	proximity_grid.Insert(proximity_for, l->min_x, l->max_x, l->min_y, l->max_y);
+}
+
 bool EntityList::RemoveProximity(uint16 delete_npc_id)
 {
 	auto it = std::find_if(proximity_list.begin(), proximity_list.end(),
@@ -3665,12 +3725,14 @@ bool EntityList::RemoveProximity(uint16 delete_npc_id)
 	if (it == proximity_list.end())
 		return false;
 
+	proximity_grid.Remove(*it);
 	proximity_list.erase(it);
 	return true;
 }
 
 void EntityList::RemoveAllLocalities()
 {
+	proximity_grid.Clear();
 	proximity_list.clear();
 }
 
@@ -3682,87 +3744,84 @@ struct quest_proximity_event {
 	int area_type;
 };
 
-void EntityList::ProcessMove(Client *c, const glm::vec3& location)
+// moves rarely cross more than a couple of boundaries, keep these off the heap
+typedef boost::container::small_vector<quest_proximity_event, 8> quest_proximity_events;
+
+static inline bool InProximityBox(const glm::vec3 &p, float min_x, float max_x, float min_y, float max_y, float min_z, float max_z)
 {
-	float last_x = c->ProximityX();
-	float last_y = c->ProximityY();
-	float last_z = c->ProximityZ();
+	return !(p.x < min_x || p.x > max_x ||
+			p.y < min_y || p.y > max_y ||
+			p.z < min_z || p.z > max_z);
+}
 
-	std::list<quest_proximity_event> events;
-	for (auto iter = proximity_list.begin(); iter != proximity_list.end(); ++iter) {
-		NPC *d = (*iter);
-		NPCProximity *l = d->proximity;
-		if (l == nullptr)
-			continue;
+void EntityList::ProcessMove(Client *c, const glm::vec3& location)
+{
+	glm::vec3 last_location(c->ProximityX(), c->ProximityY(), c->ProximityZ());
 
-		//check both bounding boxes, if either coords pairs
-		//cross a boundary, send the event.
-		bool old_in = true;
-		bool new_in = true;
-		if (last_x < l->min_x || last_x > l->max_x ||
-				last_y < l->min_y || last_y > l->max_y ||
-				last_z < l->min_z || last_z > l->max_z) {
-			old_in = false;
-		}
-		if (location.x < l->min_x || location.x > l->max_x ||
-				location.y < l->min_y || location.y > l->max_y ||
-				location.z < l->min_z || location.z > l->max_z) {
-			new_in = false;
-		}
+	quest_proximity_events events;
 
-		if (old_in && !new_in) {
-			quest_proximity_event evt;
-			evt.event_id = EVENT_EXIT;
-			evt.client = c;
-			evt.npc = d;
-			evt.area_id = 0;
-			evt.area_type = 0;
-			events.push_back(evt);
-		} else if (new_in && !old_in) {
-			quest_proximity_event evt;
-			evt.event_id = EVENT_ENTER;
-			evt.client = c;
-			evt.npc = d;
-			evt.area_id = 0;
-			evt.area_type = 0;
-			events.push_back(evt);
-		}
-	}
+	if (!proximity_grid.Empty()) {
+		boost::container::small_vector<NPC *, 16> candidates;
+		proximity_grid.Query(last_location, location, candidates);
 
-	for (auto iter = area_list.begin(); iter != area_list.end(); ++iter) {
-		Area& a = (*iter);
-		bool old_in = true;
-		bool new_in = true;
-		if (last_x < a.min_x || last_x > a.max_x ||
-				last_y < a.min_y || last_y > a.max_y ||
-				last_z < a.min_z || last_z > a.max_z) {
-			old_in = false;
-		}
+		for (NPC *d : candidates) {
+			NPCProximity *l = d->proximity;
+			if (l == nullptr)
+				continue;
 
-		if (location.x < a.min_x || location.x > a.max_x ||
-				location.y < a.min_y || location.y > a.max_y ||
-				location.z < a.min_z || location.z > a.max_z ) {
-			new_in = false;
+			//check both bounding boxes, if either coords pairs
+			//cross a boundary, send the event.
+			bool old_in = InProximityBox(last_location, l->min_x, l->max_x, l->min_y, l->max_y, l->min_z, l->max_z);
+			bool new_in = InProximityBox(location, l->min_x, l->max_x, l->min_y, l->max_y, l->min_z, l->max_z);
+
+			if (old_in && !new_in) {
+				quest_proximity_event evt;
+				evt.event_id = EVENT_EXIT;
+				evt.client = c;
+				evt.npc = d;
+				evt.area_id = 0;
+				evt.area_type = 0;
+				events.push_back(evt);
+			} else if (new_in && !old_in) {
+				quest_proximity_event evt;
+				evt.event_id = EVENT_ENTER;
+				evt.client = c;
+				evt.npc = d;
+				evt.area_id = 0;
+				evt.area_type = 0;
+				events.push_back(evt);
+			}
 		}
+	}
 
-		if (old_in && !new_in) {
-			//were in but are no longer.
-			quest_proximity_event evt;
-			evt.event_id = EVENT_LEAVE_AREA;
-			evt.client = c;
-			evt.npc = nullptr;
-			evt.area_id = a.id;
-			evt.area_type = a.type;
-			events.push_back(evt);
-		} else if (!old_in && new_in) {
-			//were not in but now are
-			quest_proximity_event evt;
-			evt.event_id = EVENT_ENTER_AREA;
-			evt.client = c;
-			evt.npc = nullptr;
-			evt.area_id = a.id;
-			evt.area_type = a.type;
-			events.push_back(evt);
+	if (!area_grid.Empty()) {
+		boost::container::small_vector<const Area *, 16> candidates;
+		area_grid.Query(last_location, location, candidates);
+
+		for (const Area *area : candidates) {
+			const Area& a = *area;
+			bool old_in = InProximityBox(last_location, a.min_x, a.max_x, a.min_y, a.max_y, a.min_z, a.max_z);
+			bool new_in = InProximityBox(location, a.min_x, a.max_x, a.min_y, a.max_y, a.min_z, a.max_z);
+
+			if (old_in && !new_in) {
+				//were in but are no longer.
+				quest_proximity_event evt;
+				evt.event_id = EVENT_LEAVE_AREA;
+				evt.client = c;
+				evt.npc = nullptr;
+				evt.area_id = a.id;
+				evt.area_type = a.type;
+				events.push_back(evt);
+			} else if (!old_in && new_in) {
+				//were not in but now are
+				quest_proximity_event evt;
+				evt.event_id = EVENT_ENTER_AREA;
+				evt.client = c;
+				evt.npc = nullptr;
+				evt.area_id = a.id;
+				evt.area_type = a.type;
+				events.push_back(evt);
+			}
 		}
 	}
 
@@ -3781,28 +3840,23 @@ void EntityList::ProcessMove(Client *c, const glm::vec3& location)
 }
 
 void EntityList::ProcessMove(NPC *n, float x, float y, float z) {
-	float last_x = n->GetX();
-	float last_y = n->GetY();
-	float last_z = n->GetZ();
+	if (area_grid.Empty()) {
+		return;
+	}
 
-	std::list<quest_proximity_event> events;
+	glm::vec3 last_location(n->GetX(), n->GetY(), n->GetZ());
+	glm::vec3 location(x, y, z);
 
-	for (auto iter = area_list.begin(); iter != area_list.end(); ++iter) {
+	quest_proximity_events events;
 
-		Area &a     = (*iter);
-		bool old_in = true;
-		bool new_in = true;
-		if (last_x < a.min_x || last_x > a.max_x ||
-			last_y < a.min_y || last_y > a.max_y ||
-			last_z < a.min_z || last_z > a.max_z) {
-			old_in = false;
-		}
+	boost::container::small_vector<const Area *, 16> candidates;
+	area_grid.Query(last_location, location, candidates);
 
-		if (x < a.min_x || x > a.max_x ||
-			y < a.min_y || y > a.max_y ||
-			z < a.min_z || z > a.max_z) {
-			new_in = false;
-		}
+	for (const Area *area : candidates) {
+
+		const Area &a = *area;
+		bool old_in   = InProximityBox(last_location, a.min_x, a.max_x, a.min_y, a.max_y, a.min_z, a.max_z);
+		bool new_in   = InProximityBox(location, a.min_x, a.max_x, a.min_y, a.max_y, a.min_z, a.max_z);
 
 		if (old_in && !new_in) {
 			//were in but are no longer.
@@ -3867,6 +3921,9 @@ void EntityList::AddArea(int id, int type, float min_x, float max_x, float min_y
 	}
 
 	area_list.push_back(a);
+
+	const Area &added = area_list.back();
+	area_grid.Insert(&added, added.min_x, added.max_x, added.min_y, added.max_y);
 }
 
 void EntityList::RemoveArea(int id)
@@ -3876,29 +3933,32 @@ void EntityList::RemoveArea(int id)
 	if (it == area_list.end())
 		return;
 
+	area_grid.Remove(&(*it));
 	area_list.erase(it);
 }
 
 void EntityList::ClearAreas()
 {
+	area_grid.Clear();
 	area_list.clear();
 }
 
 void EntityList::ProcessProximitySay(const char *Message, Client *c, uint8 language)
 {
-	if (!Message || !c)
+	if (!Message || !c || proximity_grid.Empty())
 		return;
 
-	auto iter = proximity_list.begin();
-	for (; iter != proximity_list.end(); ++iter) {
-		NPC *d = (*iter);
+	glm::vec3 location(c->GetX(), c->GetY(), c->GetZ());
+
+	boost::container::small_vector<NPC *, 16> candidates;
+	proximity_grid.Query(location, candidates);
+
+	for (NPC *d : candidates) {
 		NPCProximity *l = d->proximity;
 		if (l == nullptr || !l->say)
 			continue;
 
-		if (c->GetX() < l->min_x || c->GetX() > l->max_x
-				|| c->GetY() < l->min_y || c->GetY() > l->max_y
-				|| c->GetZ() < l->min_z || c->GetZ() > l->max_z)
+		if (!InProximityBox(location, l->min_x, l->max_x, l->min_y, l->max_y, l->min_z, l->max_z))
 			continue;
 
 		parse->EventNPC(EVENT_PROXIMITY_SAY, d, c, Message, language);
@@ -4801,14 +4861,7 @@ void EntityList::GetSpawnList(std::list<Spawn2*> &o_list)
 {
 	o_list.clear();
 	if(zone) {
-		LinkedListIterator<Spawn2*> iterator(zone->spawn2_list);
-		iterator.Reset();
-		while(iterator.MoreElements())
-		{
-			Spawn2 *ent = iterator.GetData();
-			o_list.push_back(ent);
-			iterator.Advance();
-		}
+		o_list.insert(o_list.end(), zone->spawn2_list.begin(), zone->spawn2_list.end());
 	}
 }
 
@@ -28,8 +28,11 @@
 #include "../common/eq_constants.h"
 
 #include "position.h"
+#include "proximity_grid.h"
+#include "mob_position_table.h"
 #include "zonedump.h"
 #include "common.h"
+#include "entity_timer_service.h"
 
 class Encounter;
 class Beacon;
@@ -249,6 +252,8 @@ public:
 	void	ObjectProcess();
 	void	CorpseProcess();
 	void	MobProcess();
+	void	ScheduleEntityTimer(uint16 entity_id, EntityTimer timer_id, uint32 delay);
+	void	CancelEntityTimer(uint16 entity_id, EntityTimer timer_id);
 	void	TrapProcess();
 	void	BeaconProcess();
 	void	EncounterProcess();
@@ -280,6 +285,7 @@ public:
 	void	AddBeacon(Beacon *beacon);
 	void	AddEncounter(Encounter *encounter);
 	void	AddProximity(NPC *proximity_for);
+	void	UpdateProximity(NPC *proximity_for);
 	void	Clear();
 	bool	RemoveMob(uint16 delete_id);
 	bool	RemoveMob(Mob* delete_mob);
@@ -519,6 +525,7 @@ public:
 	inline const std::unordered_map<uint16, Doors *> &GetDoorsList() { return door_list; }
 
 	std::unordered_map<uint16, Mob *> &GetCloseMobList(Mob *mob, float distance = 0);
+	inline void UpdateMobPosition(Mob *mob) { mob_positions.Update(mob); }
 
 	void	DepopAll(int NPCTypeID, bool StartSpawnTimer = true);
 
@@ -546,6 +553,7 @@ protected:
 private:
 	void	AddToSpawnQueue(uint16 entityid, NewSpawn_Struct** app);
 	void	CheckSpawnQueue();
+	void	ProcessEntityTimers(bool zone_awake);
 
 	//used for limiting spawns
 	class SpawnLimitRecord { public: uint32 spawngroup_id; uint32 npc_type; };
@@ -569,7 +577,12 @@ private:
 	std::list<Group *> group_list;
 	std::list<Raid *> raid_list;
 	std::list<Area> area_list;
+	ProximityGrid<NPC *> proximity_grid;
+	ProximityGrid<const Area *> area_grid;
+	MobPositionTable mob_positions; // mirrors mob_list
 	std::queue<uint16> free_ids;
+	EntityTimerService entity_timers; // npc timers, dispatched ahead of MobProcess
+	EntityTimerService::Expired expired_entity_timers; // kept between ticks for its capacity
 
 	Timer object_timer;
 	Timer door_timer;
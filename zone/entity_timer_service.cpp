@@ -0,0 +1,98 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2021 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "../common/timer.h"
+#include "entity_timer_service.h"
+
+void EntityTimerService::Schedule(uint16 entity_id, EntityTimer timer_id, uint32 delay)
+{
+	uint32 now = Timer::GetCurrentTime();
+	if (!m_started) {
+		m_current_tick = now / SlotMS;
+		m_started      = true;
+	}
+
+	Entry e;
+	e.due       = now + delay;
+	e.serial    = ++m_next_serial;
+	e.entity_id = entity_id;
+	e.timer_id  = timer_id;
+
+	m_serials[Key(entity_id, timer_id)] = e.serial;
+	m_slots[(e.due / SlotMS) % SlotCount].push_back(e);
+}
+
+void EntityTimerService::Cancel(uint16 entity_id, EntityTimer timer_id)
+{
+	m_serials.erase(Key(entity_id, timer_id));
+}
+
+void EntityTimerService::CancelAll(uint16 entity_id)
+{
+	for (uint8 i = 0; i < (uint8) EntityTimer::Max; ++i) {
+		Cancel(entity_id, (EntityTimer) i);
+	}
+}
+
+void EntityTimerService::Clear()
+{
+	for (auto &slot : m_slots) {
+		slot.clear();
+	}
+
+	m_serials.clear();
+}
+
+void EntityTimerService::Process(uint32 now, Expired &expired)
+{
+	if (!m_started) {
+		return;
+	}
+
+	uint32 target_tick = now / SlotMS;
+	uint32 ticks       = target_tick - m_current_tick + 1;
+	if (ticks > SlotCount) {
+		ticks = SlotCount; // fell behind a full turn, every slot gets visited once
+	}
+
+	for (uint32 i = 0; i < ticks; ++i) {
+		auto &slot = m_slots[(m_current_tick + i) % SlotCount];
+
+		size_t kept = 0;
+		for (size_t j = 0; j < slot.size(); ++j) {
+			const Entry &e   = slot[j];
+			auto        live = m_serials.find(Key(e.entity_id, e.timer_id));
+			if (live == m_serials.end() || live->second != e.serial) {
+				continue;
+			}
+
+			if ((int32) (e.due - now) <= 0) {
+				m_serials.erase(live);
+				expired.emplace_back(e.entity_id, e.timer_id);
+				continue;
+			}
+
+			slot[kept++] = e;
+		}
+
+		slot.resize(kept);
+	}
+
+	// the current slot is visited again next time, it can still hold entries due later in it
+	m_current_tick = target_tick;
+}
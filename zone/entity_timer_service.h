@@ -0,0 +1,81 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2021 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#ifndef EQEMU_ENTITY_TIMER_SERVICE_H
+#define EQEMU_ENTITY_TIMER_SERVICE_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../common/types.h"
+
+enum class EntityTimer : uint8 {
+	NPCTic = 0,
+	NPCCloseScan,
+	NPCCheckMoving,
+	NPCEnrage,
+	NPCAssist,
+	NPCAssistCap,
+	NPCQGlobalPurge,
+	Max
+};
+
+/**
+ * Hashed timing wheel of per entity timers
+ *
+ * Each slot covers SlotMS of time, so advancing only visits the slots between the last call and
+ * now. Entries due further out than one turn of the wheel stay in their slot until a later turn.
+ * Rescheduling or cancelling a timer bumps its serial, older entries for it are dropped as they
+ * are visited.
+ */
+class EntityTimerService {
+public:
+	static constexpr uint32 SlotMS    = 32;
+	static constexpr uint32 SlotCount = 256;
+
+	typedef std::vector<std::pair<uint16, EntityTimer>> Expired;
+
+	void Schedule(uint16 entity_id, EntityTimer timer_id, uint32 delay);
+	void Cancel(uint16 entity_id, EntityTimer timer_id);
+	void CancelAll(uint16 entity_id);
+	void Clear();
+
+	// appends every timer that is due at now, each of them is no longer scheduled
+	void Process(uint32 now, Expired &expired);
+
+private:
+	struct Entry {
+		uint32      due;
+		uint32      serial;
+		uint16      entity_id;
+		EntityTimer timer_id;
+	};
+
+	static uint32 Key(uint16 entity_id, EntityTimer timer_id)
+	{
+		return ((uint32) entity_id << 8) | (uint32) timer_id;
+	}
+
+	std::vector<Entry>                 m_slots[SlotCount];
+	std::unordered_map<uint32, uint32> m_serials; // live serial per entity/timer
+	uint32                             m_next_serial  = 0;
+	uint32                             m_current_tick = 0;
+	bool                               m_started      = false;
+};
+
+#endif //EQEMU_ENTITY_TIMER_SERVICE_H
@@ -32,6 +32,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <stdlib.h>
 #include <list>
+#include <unordered_map>
 
 extern Zone *zone;
 
@@ -42,6 +43,13 @@ HateList::HateList()
 
 HateList::~HateList()
 {
+	// the mobs still on the list must not point back at an owner that is going away
+	for (auto &e : list)
+	{
+		if (e->entity_on_hatelist)
+			e->entity_on_hatelist->hate_list_owners.erase(hate_owner);
+		delete e;
+	}
 }
 
 // added for frenzy support
@@ -59,23 +67,29 @@ void HateList::IsEntityInFrenzyMode()
 
 void HateList::WipeHateList()
 {
-	auto iterator = list.begin();
-
-	while (iterator != list.end())
+	// quest events below can add to the list again, keep going until it stays empty
+	while (!list.empty())
 	{
-		Mob* m = (*iterator)->entity_on_hatelist;
-		if (m)
+		std::vector<struct_HateList*> entries;
+		entries.swap(list);
+		list_index.clear();
+
+		for (auto &e : entries)
 		{
-			parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), m, "0", 0);
+			Mob* m = e->entity_on_hatelist;
+			if (m)
+			{
+				m->hate_list_owners.erase(hate_owner);
 
-			if (m->IsClient()) {
-				m->CastToClient()->DecrementAggroCount();
-				m->CastToClient()->RemoveXTarget(hate_owner, true);
+				parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), m, "0", 0);
+
+				if (m->IsClient()) {
+					m->CastToClient()->DecrementAggroCount();
+					m->CastToClient()->RemoveXTarget(hate_owner, true);
+				}
 			}
+			delete e;
 		}
-		delete (*iterator);
-		iterator = list.erase(iterator);
-
 	}
 }
 
@@ -88,14 +102,38 @@ bool HateList::IsEntOnHateList(Mob *mob)
 
 struct_HateList *HateList::Find(Mob *in_entity)
 {
-	auto iterator = list.begin();
-	while (iterator != list.end())
-	{
-		if ((*iterator)->entity_on_hatelist == in_entity)
-			return (*iterator);
-		++iterator;
-	}
-	return nullptr;
+	auto iterator = list_index.find(in_entity);
+	if (iterator == list_index.end())
+		return nullptr;
+
+	return list[iterator->second];
+}
+
+void HateList::Insert(struct_HateList *entry)
+{
+	list_index[entry->entity_on_hatelist] = list.size();
+	list.push_back(entry);
+
+	entry->entity_on_hatelist->hate_list_owners.insert(hate_owner);
+}
+
+// removes and frees the entry for in_entity, entries after it keep their order
+void HateList::Erase(Mob *in_entity)
+{
+	auto iterator = list_index.find(in_entity);
+	if (iterator == list_index.end())
+		return;
+
+	size_t index = iterator->second;
+	list_index.erase(iterator);
+
+	delete list[index];
+	list.erase(list.begin() + index);
+
+	for (size_t i = index; i < list.size(); ++i)
+		list_index[list[i]->entity_on_hatelist] = i;
+
+	in_entity->hate_list_owners.erase(hate_owner);
 }
 
 void HateList::SetHateAmountOnEnt(Mob* other, uint32 in_hate, uint32 in_damage)
@@ -118,6 +156,10 @@ Mob* HateList::GetDamageTopOnHateList(Mob* hater)
 	Raid* r = nullptr;
 	uint32 dmg_amt = 0;
 
+	// every member of a raid or group shares its total, work each one out once
+	std::unordered_map<Raid*, uint32> raid_damage;
+	std::unordered_map<Group*, uint32> group_damage;
+
 	auto iterator = list.begin();
 	while (iterator != list.end())
 	{
@@ -128,21 +170,30 @@ Mob* HateList::GetDamageTopOnHateList(Mob* hater)
 			r = entity_list.GetRaidByClient((*iterator)->entity_on_hatelist->CastToClient());
 		}
 
-		grp = entity_list.GetGroupByMob((*iterator)->entity_on_hatelist);
+		if (!r)
+			grp = entity_list.GetGroupByMob((*iterator)->entity_on_hatelist);
 
 		if ((*iterator)->entity_on_hatelist && r){
-			if (r->GetTotalRaidDamage(hater) >= dmg_amt)
+			auto total = raid_damage.find(r);
+			if (total == raid_damage.end())
+				total = raid_damage.emplace(r, r->GetTotalRaidDamage(hater)).first;
+
+			if (total->second >= dmg_amt)
 			{
 				current = (*iterator)->entity_on_hatelist;
-				dmg_amt = r->GetTotalRaidDamage(hater);
+				dmg_amt = total->second;
 			}
 		}
 		else if ((*iterator)->entity_on_hatelist != nullptr && grp != nullptr)
 		{
-			if (grp->GetTotalGroupDamage(hater) >= dmg_amt)
+			auto total = group_damage.find(grp);
+			if (total == group_damage.end())
+				total = group_damage.emplace(grp, grp->GetTotalGroupDamage(hater)).first;
+
+			if (total->second >= dmg_amt)
 			{
 				current = (*iterator)->entity_on_hatelist;
-				dmg_amt = grp->GetTotalGroupDamage(hater);
+				dmg_amt = total->second;
 			}
 		}
 		else if ((*iterator)->entity_on_hatelist != nullptr && (uint32)(*iterator)->hatelist_damage >= dmg_amt)
@@ -208,7 +259,7 @@ void HateList::AddEntToHateList(Mob *in_entity, int32 in_hate, int32 in_damage,
 		entity->is_entity_frenzy = in_is_entity_frenzied;
 		entity->oor_count = 0;
 		entity->last_modified = Timer::GetCurrentTime();
-		list.push_back(entity);
+		Insert(entity);
 		parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), in_entity, "1", 0);
 
 		if (in_entity->IsClient()) {
@@ -222,29 +273,17 @@ bool HateList::RemoveEntFromHateList(Mob *in_entity)
 	if (!in_entity)
 		return false;
 
-	bool is_found = false;
-	auto iterator = list.begin();
-
-	while (iterator != list.end())
-	{
-		if ((*iterator)->entity_on_hatelist == in_entity)
-		{
-			is_found = true;
+	if (!Find(in_entity))
+		return false;
 
-			if (in_entity && in_entity->IsClient())
-				in_entity->CastToClient()->DecrementAggroCount();
+	if (in_entity->IsClient())
+		in_entity->CastToClient()->DecrementAggroCount();
 
-			delete (*iterator);
-			iterator = list.erase(iterator);
+	Erase(in_entity);
 
-			if (in_entity)
-				parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), in_entity, "0", 0);
+	parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), in_entity, "0", 0);
 
-		}
-		else
-			++iterator;
-	}
-	return is_found;
+	return true;
 }
 
 void HateList::DoFactionHits(int32 npc_faction_level_id) {
@@ -746,42 +785,45 @@ void HateList::SpellCast(Mob *caster, uint32 spell_id, float range, Mob* ae_cent
 
 void HateList::RemoveStaleEntries(int time_ms, float dist)
 {
-	auto it = list.begin();
-
 	auto cur_time = Timer::GetCurrentTime();
 
 	auto dist2 = dist * dist;
 
-	while (it != list.end()) {
-		auto m = (*it)->entity_on_hatelist;
+	std::vector<Mob *> stale;
+	for (auto &e : list) {
+		auto m = e->entity_on_hatelist;
 		if (m) {
 			bool remove = false;
 
-			if (cur_time - (*it)->last_modified > time_ms)
+			if (cur_time - e->last_modified > time_ms)
 				remove = true;
 
 			if (!remove && DistanceSquaredNoZ(hate_owner->GetPosition(), m->GetPosition()) > dist2) {
-				(*it)->oor_count++;
-				if ((*it)->oor_count == 2)
+				e->oor_count++;
+				if (e->oor_count == 2)
 					remove = true;
-			} else if ((*it)->oor_count != 0) {
-				(*it)->oor_count = 0;
+			} else if (e->oor_count != 0) {
+				e->oor_count = 0;
 			}
 
-			if (remove) {
-				parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), m, "0", 0);
+			if (remove)
+				stale.push_back(m);
+		}
+	}
 
-				if (m->IsClient()) {
-					m->CastToClient()->DecrementAggroCount();
-					m->CastToClient()->RemoveXTarget(hate_owner, true);
-				}
+	// removed after the scan, the quest events can change the list
+	for (auto m : stale) {
+		if (!Find(m))
+			continue;
 
-				delete (*it);
-				it = list.erase(it);
-				continue;
-			}
+		parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), m, "0", 0);
+
+		if (m->IsClient()) {
+			m->CastToClient()->DecrementAggroCount();
+			m->CastToClient()->RemoveXTarget(hate_owner, true);
 		}
-		++it;
+
+		Erase(m);
 	}
 }
 
@@ -19,6 +19,10 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef HATELIST_H
 #define HATELIST_H
 
+#include <list>
+#include <unordered_map>
+#include <vector>
+
 class Client;
 class Group;
 class Mob;
@@ -59,7 +63,7 @@ public:
 
 	int32 GetEntHateAmount(Mob *ent, bool in_damage = false);
 
-	std::list<struct_HateList*>& GetHateList() { return list; }
+	std::vector<struct_HateList*>& GetHateList() { return list; }
 	std::list<struct_HateList*> GetHateListByDistance(int distance = 0);
 
 	void AddEntToHateList(Mob *ent, int32 in_hate = 0, int32 in_damage = 0, bool in_is_frenzied = false, bool add_to_hate_list_if_not_exist = true);
@@ -76,7 +80,11 @@ public:
 protected:
 	struct_HateList* Find(Mob *ent);
 private:
-	std::list<struct_HateList*> list;
+	void Insert(struct_HateList *entry);
+	void Erase(Mob *ent);
+
+	std::vector<struct_HateList*> list; // in the order entities were added
+	std::unordered_map<Mob*, size_t> list_index; // entity -> position in list
 	Mob *hate_owner;
 };
 
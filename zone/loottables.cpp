@@ -20,6 +20,7 @@
 #include "../common/loottable.h"
 #include "../common/misc_functions.h"
 #include "../common/data_verification.h"
+#include "../common/object_pool.h"
 
 #include "client.h"
 #include "entity.h"
@@ -38,6 +39,16 @@
 #define snprintf	_snprintf
 #endif
 
+void *ServerLootItem_Struct::operator new(size_t size)
+{
+	return EQ::ObjectPool<ServerLootItem_Struct>::Allocate(size);
+}
+
+void ServerLootItem_Struct::operator delete(void *ptr, size_t size)
+{
+	EQ::ObjectPool<ServerLootItem_Struct>::Free(ptr, size);
+}
+
 // Queries the loottable: adds item & coin to the npc
 void ZoneDatabase::AddLootTableToNPC(NPC* npc,uint32 loottable_id, ItemList* itemlist, uint32* copper, uint32* silver, uint32* gold, uint32* plat) {
 	const LootTable_Struct* lts = nullptr;
@@ -1683,18 +1683,10 @@ void lua_clear_areas() {
 
 void lua_remove_spawn_point(uint32 spawn2_id) {
 	if(zone) {
-		LinkedListIterator<Spawn2*> iter(zone->spawn2_list);
-		iter.Reset();
-
-		while(iter.MoreElements()) {
-			Spawn2* cur = iter.GetData();
-			if(cur->GetID() == spawn2_id) {
-				cur->ForceDespawn();
-				iter.RemoveCurrent(true);
-				return;
-			}
-
-			iter.Advance();
+		Spawn2 *cur = zone->spawn2_list.GetByID(spawn2_id);
+		if(cur) {
+			cur->ForceDespawn();
+			zone->spawn2_list.Remove(cur);
 		}
 	}
 }
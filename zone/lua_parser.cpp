@@ -283,20 +283,15 @@ int LuaParser::EventGlobalNPC(QuestEventID evt, NPC* npc, Mob *init, std::string
 	return _EventNPC("global_npc", evt, npc, init, data, extra_data, extra_pointers);
 }
 
-int LuaParser::_EventNPC(std::string package_name, QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+int LuaParser::_EventNPC(const std::string &package_name, QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
 						 std::vector<EQ::Any> *extra_pointers, luabind::adl::object *l_func) {
-	const char *sub_name = LuaEvents[evt];
-
 	int start = lua_gettop(L);
 
 	try {
-		int npop = 1;
 		if(l_func != nullptr) {
 			l_func->push(L);
 		} else {
-			lua_getfield(L, LUA_REGISTRYINDEX, package_name.c_str());
-			lua_getfield(L, -1, sub_name);
-			npop = 2;
+			PushEventHandler(package_name, evt);
 		}
 
 		lua_createtable(L, 0, 0);
@@ -321,11 +316,11 @@ int LuaParser::_EventNPC(std::string package_name, QuestEventID evt, NPC* npc, M
 
 		if(lua_isnumber(L, -1)) {
 			int ret = static_cast<int>(lua_tointeger(L, -1));
-			lua_pop(L, npop);
+			lua_pop(L, 1);
 			return ret;
 		}
 
-		lua_pop(L, npop);
+		lua_pop(L, 1);
 	} catch(std::exception &ex) {
 		std::string error = "Lua Exception: ";
 		error += std::string(ex.what());
@@ -378,19 +373,15 @@ int LuaParser::EventGlobalPlayer(QuestEventID evt, Client *client, std::string d
 	return _EventPlayer("global_player", evt, client, data, extra_data, extra_pointers);
 }
 
-int LuaParser::_EventPlayer(std::string package_name, QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+int LuaParser::_EventPlayer(const std::string &package_name, QuestEventID evt, Client *client, std::string data, uint32 extra_data,
 							std::vector<EQ::Any> *extra_pointers, luabind::adl::object *l_func) {
-	const char *sub_name = LuaEvents[evt];
 	int start = lua_gettop(L);
 
 	try {
-		int npop = 1;
 		if(l_func != nullptr) {
 			l_func->push(L);
 		} else {
-			lua_getfield(L, LUA_REGISTRYINDEX, package_name.c_str());
-			lua_getfield(L, -1, sub_name);
-			npop = 2;
+			PushEventHandler(package_name, evt);
 		}
 
 		lua_createtable(L, 0, 0);
@@ -414,11 +405,11 @@ int LuaParser::_EventPlayer(std::string package_name, QuestEventID evt, Client *
 
 		if(lua_isnumber(L, -1)) {
 			int ret = static_cast<int>(lua_tointeger(L, -1));
-			lua_pop(L, npop);
+			lua_pop(L, 1);
 			return ret;
 		}
 
-		lua_pop(L, npop);
+		lua_pop(L, 1);
 	} catch(std::exception &ex) {
 		std::string error = "Lua Exception: ";
 		error += std::string(ex.what());
@@ -455,19 +446,15 @@ int LuaParser::EventItem(QuestEventID evt, Client *client, EQ::ItemInstance *ite
 	return _EventItem(package_name, evt, client, item, mob, data, extra_data, extra_pointers);
 }
 
-int LuaParser::_EventItem(std::string package_name, QuestEventID evt, Client *client, EQ::ItemInstance *item, Mob *mob,
+int LuaParser::_EventItem(const std::string &package_name, QuestEventID evt, Client *client, EQ::ItemInstance *item, Mob *mob,
 						  std::string data, uint32 extra_data, std::vector<EQ::Any> *extra_pointers, luabind::adl::object *l_func) {
-	const char *sub_name = LuaEvents[evt];
-
 	int start = lua_gettop(L);
 
 	try {
-		int npop = 1;
 		if(l_func != nullptr) {
 			l_func->push(L);
 		} else {
-			lua_getfield(L, LUA_REGISTRYINDEX, package_name.c_str());
-			lua_getfield(L, -1, sub_name);
+			PushEventHandler(package_name, evt);
 		}
 
 		lua_createtable(L, 0, 0);
@@ -497,11 +484,11 @@ int LuaParser::_EventItem(std::string package_name, QuestEventID evt, Client *cl
 
 		if(lua_isnumber(L, -1)) {
 			int ret = static_cast<int>(lua_tointeger(L, -1));
-			lua_pop(L, npop);
+			lua_pop(L, 1);
 			return ret;
 		}
 
-		lua_pop(L, npop);
+		lua_pop(L, 1);
 	} catch(std::exception &ex) {
 		std::string error = "Lua Exception: ";
 		error += std::string(ex.what());
@@ -534,20 +521,15 @@ int LuaParser::EventSpell(QuestEventID evt, NPC* npc, Client *client, uint32 spe
 	return _EventSpell(package_name, evt, npc, client, spell_id, extra_data, extra_pointers);
 }
 
-int LuaParser::_EventSpell(std::string package_name, QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
+int LuaParser::_EventSpell(const std::string &package_name, QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
 						   std::vector<EQ::Any> *extra_pointers, luabind::adl::object *l_func) {
-	const char *sub_name = LuaEvents[evt];
-
 	int start = lua_gettop(L);
 
 	try {
-		int npop = 1;
 		if(l_func != nullptr) {
 			l_func->push(L);
 		} else {
-			lua_getfield(L, LUA_REGISTRYINDEX, package_name.c_str());
-			lua_getfield(L, -1, sub_name);
-			npop = 2;
+			PushEventHandler(package_name, evt);
 		}
 
 		lua_createtable(L, 0, 0);
@@ -578,11 +560,11 @@ int LuaParser::_EventSpell(std::string package_name, QuestEventID evt, NPC* npc,
 
 		if(lua_isnumber(L, -1)) {
 			int ret = static_cast<int>(lua_tointeger(L, -1));
-			lua_pop(L, npop);
+			lua_pop(L, 1);
 			return ret;
 		}
 
-		lua_pop(L, npop);
+		lua_pop(L, 1);
 	} catch(std::exception &ex) {
 		std::string error = "Lua Exception: ";
 		error += std::string(ex.what());
@@ -614,15 +596,12 @@ int LuaParser::EventEncounter(QuestEventID evt, std::string encounter_name, std:
 	return _EventEncounter(package_name, evt, encounter_name, data, extra_data, extra_pointers);
 }
 
-int LuaParser::_EventEncounter(std::string package_name, QuestEventID evt, std::string encounter_name, std::string data, uint32 extra_data,
+int LuaParser::_EventEncounter(const std::string &package_name, QuestEventID evt, std::string encounter_name, std::string data, uint32 extra_data,
 							   std::vector<EQ::Any> *extra_pointers) {
-	const char *sub_name = LuaEvents[evt];
-
 	int start = lua_gettop(L);
 
 	try {
-		lua_getfield(L, LUA_REGISTRYINDEX, package_name.c_str());
-		lua_getfield(L, -1, sub_name);
+		PushEventHandler(package_name, evt);
 
 		lua_createtable(L, 0, 0);
 		lua_pushstring(L, encounter_name.c_str());
@@ -644,11 +623,11 @@ int LuaParser::_EventEncounter(std::string package_name, QuestEventID evt, std::
 
 		if(lua_isnumber(L, -1)) {
 			int ret = static_cast<int>(lua_tointeger(L, -1));
-			lua_pop(L, 2);
+			lua_pop(L, 1);
 			return ret;
 		}
 
-		lua_pop(L, 2);
+		lua_pop(L, 1);
 	} catch(std::exception &ex) {
 		std::string error = "Lua Exception: ";
 		error += std::string(ex.what());
@@ -673,8 +652,7 @@ bool LuaParser::HasQuestSub(uint32 npc_id, QuestEventID evt) {
 
 	std::string package_name = "npc_" + std::to_string(npc_id);
 
-	const char *subname = LuaEvents[evt];
-	return HasFunction(subname, package_name);
+	return HasEventHandler(package_name, evt);
 }
 
 bool LuaParser::HasGlobalQuestSub(QuestEventID evt) {
@@ -683,8 +661,7 @@ bool LuaParser::HasGlobalQuestSub(QuestEventID evt) {
 		return false;
 	}
 
-	const char *subname = LuaEvents[evt];
-	return HasFunction(subname, "global_npc");
+	return HasEventHandler("global_npc", evt);
 }
 
 bool LuaParser::PlayerHasQuestSub(QuestEventID evt) {
@@ -693,8 +670,7 @@ bool LuaParser::PlayerHasQuestSub(QuestEventID evt) {
 		return false;
 	}
 
-	const char *subname = LuaEvents[evt];
-	return HasFunction(subname, "player");
+	return HasEventHandler("player", evt);
 }
 
 bool LuaParser::GlobalPlayerHasQuestSub(QuestEventID evt) {
@@ -703,8 +679,7 @@ bool LuaParser::GlobalPlayerHasQuestSub(QuestEventID evt) {
 		return false;
 	}
 
-	const char *subname = LuaEvents[evt];
-	return HasFunction(subname, "global_player");
+	return HasEventHandler("global_player", evt);
 }
 
 bool LuaParser::SpellHasQuestSub(uint32 spell_id, QuestEventID evt) {
@@ -715,8 +690,7 @@ bool LuaParser::SpellHasQuestSub(uint32 spell_id, QuestEventID evt) {
 
 	std::string package_name = "spell_" + std::to_string(spell_id);
 
-	const char *subname = LuaEvents[evt];
-	return HasFunction(subname, package_name);
+	return HasEventHandler(package_name, evt);
 }
 
 bool LuaParser::ItemHasQuestSub(EQ::ItemInstance *itm, QuestEventID evt) {
@@ -731,8 +705,7 @@ bool LuaParser::ItemHasQuestSub(EQ::ItemInstance *itm, QuestEventID evt) {
 	std::string package_name = "item_";
 	package_name += std::to_string(itm->GetID());
 
-	const char *subname = LuaEvents[evt];
-	return HasFunction(subname, package_name);
+	return HasEventHandler(package_name, evt);
 }
 
 bool LuaParser::EncounterHasQuestSub(std::string encounter_name, QuestEventID evt) {
@@ -743,8 +716,7 @@ bool LuaParser::EncounterHasQuestSub(std::string encounter_name, QuestEventID ev
 
 	std::string package_name = "encounter_" + encounter_name;
 
-	const char *subname = LuaEvents[evt];
-	return HasFunction(subname, package_name);
+	return HasEventHandler(package_name, evt);
 }
 
 void LuaParser::LoadNPCScript(std::string filename, int npc_id) {
@@ -1034,7 +1006,7 @@ void LuaParser::LoadScript(std::string filename, std::string package_name) {
 		lua_pop(L, 1);
 	}
 	else {
-		loaded_[package_name] = true;
+		LoadEventHandlers(package_name);
 	}
 
 	auto end = lua_gettop(L);
@@ -1044,6 +1016,48 @@ void LuaParser::LoadScript(std::string filename, std::string package_name) {
 	}
 }
 
+/*
+ * Takes a reference to every event sub the script defined, so dispatch and the HasQuestSub checks
+ * don't have to look the package and sub up by name each time
+ */
+void LuaParser::LoadEventHandlers(const std::string &package_name) {
+	LuaPackage &package = loaded_[package_name];
+
+	lua_getfield(L, LUA_REGISTRYINDEX, package_name.c_str());
+	for(int i = 0; i < _LargestEventID; ++i) {
+		package.handlers[i] = LUA_NOREF;
+
+		lua_getfield(L, -1, LuaEvents[i]);
+		if(lua_isfunction(L, -1)) {
+			package.handlers[i] = luaL_ref(L, LUA_REGISTRYINDEX);
+			package.has_handler.set(i);
+		} else {
+			lua_pop(L, 1);
+		}
+	}
+	lua_pop(L, 1);
+}
+
+bool LuaParser::HasEventHandler(const std::string &package_name, QuestEventID evt) {
+	auto iter = loaded_.find(package_name);
+	if(iter == loaded_.end()) {
+		return false;
+	}
+
+	return iter->second.has_handler.test(evt);
+}
+
+// pushes nil when the package has no sub for evt, same as looking up a missing field
+void LuaParser::PushEventHandler(const std::string &package_name, QuestEventID evt) {
+	auto iter = loaded_.find(package_name);
+	if(iter == loaded_.end()) {
+		lua_pushnil(L);
+		return;
+	}
+
+	lua_rawgeti(L, LUA_REGISTRYINDEX, iter->second.handlers[evt]);
+}
+
 bool LuaParser::HasFunction(std::string subname, std::string package_name) {
 	//std::transform(subname.begin(), subname.end(), subname.begin(), ::tolower);
 
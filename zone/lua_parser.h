@@ -7,6 +7,8 @@
 #include <string>
 #include <list>
 #include <map>
+#include <bitset>
+#include <unordered_map>
 #include <exception>
 
 #include "zone_config.h"
@@ -106,23 +108,32 @@ private:
 	LuaParser(const LuaParser&);
 	LuaParser& operator=(const LuaParser&);
 
-	int _EventNPC(std::string package_name, QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+	int _EventNPC(const std::string &package_name, QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
 		std::vector<EQ::Any> *extra_pointers, luabind::adl::object *l_func = nullptr);
-	int _EventPlayer(std::string package_name, QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+	int _EventPlayer(const std::string &package_name, QuestEventID evt, Client *client, std::string data, uint32 extra_data,
 		std::vector<EQ::Any> *extra_pointers, luabind::adl::object *l_func = nullptr);
-	int _EventItem(std::string package_name, QuestEventID evt, Client *client, EQ::ItemInstance *item, Mob *mob, std::string data,
+	int _EventItem(const std::string &package_name, QuestEventID evt, Client *client, EQ::ItemInstance *item, Mob *mob, std::string data,
 		uint32 extra_data, std::vector<EQ::Any> *extra_pointers, luabind::adl::object *l_func = nullptr);
-	int _EventSpell(std::string package_name, QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
+	int _EventSpell(const std::string &package_name, QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
 		std::vector<EQ::Any> *extra_pointers, luabind::adl::object *l_func = nullptr);
-	int _EventEncounter(std::string package_name, QuestEventID evt, std::string encounter_name, std::string data, uint32 extra_data,
+	int _EventEncounter(const std::string &package_name, QuestEventID evt, std::string encounter_name, std::string data, uint32 extra_data,
 		std::vector<EQ::Any> *extra_pointers);
 
 	void LoadScript(std::string filename, std::string package_name);
+	void LoadEventHandlers(const std::string &package_name);
+	bool HasEventHandler(const std::string &package_name, QuestEventID evt);
+	void PushEventHandler(const std::string &package_name, QuestEventID evt);
 	void MapFunctions(lua_State *L);
 	QuestEventID ConvertLuaEvent(QuestEventID evt);
 
+	// event subs of a loaded script, referenced in the registry when the script loads
+	struct LuaPackage {
+		std::bitset<_LargestEventID> has_handler;
+		int handlers[_LargestEventID];
+	};
+
 	std::map<std::string, std::string> vars_;
-	std::map<std::string, bool> loaded_;
+	std::unordered_map<std::string, LuaPackage> loaded_;
 	std::vector<LuaMod> mods_;
 	lua_State *L;
 
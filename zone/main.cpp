@@ -28,6 +28,8 @@
 #include "../common/opcodemgr.h"
 #include "../common/guilds.h"
 #include "../common/eq_stream_ident.h"
+#include "../common/eq_stream_proxy.h"
+#include "../common/event/task_scheduler.h"
 #include "../common/patches/patches.h"
 #include "../common/rulesys.h"
 #include "../common/profanity_manager.h"
@@ -106,6 +108,7 @@ const SPDat_Spell_Struct* spells;
 int32 SPDAT_RECORDS = -1;
 const ZoneConfig *Config;
 double frame_time = 0.0;
+EQ::Event::TaskScheduler *encode_pool = nullptr;
 
 void Shutdown();
 void UpdateWindowTitle(char* iNewTitle);
@@ -312,6 +315,10 @@ int main(int argc, char** argv) {
 		LogError("Loading npcs faction lists failed!");
 		return 1;
 	}
+	LogInfo("Loading npc types");
+	if (!content_db.LoadNPCTypes(hotfix_name)) {
+		LogError("Loading npc types failed, npc types will be loaded from the database");
+	}
 	LogInfo("Loading loot tables");
 	if (!database.LoadLoot(hotfix_name)) {
 		LogError("Loading loot failed!");
@@ -468,6 +475,12 @@ int main(int argc, char** argv) {
 	std::chrono::time_point<std::chrono::system_clock> frame_prev = std::chrono::system_clock::now();
 	std::unique_ptr<EQ::Net::WebsocketServer> ws_server;
 
+	//packets queued for clients during the tick get encoded together on these at the end of it
+	if (RuleI(Network, EncodeThreads) > 0) {
+		encode_pool = new EQ::Event::TaskScheduler(RuleI(Network, EncodeThreads));
+		LogInfo("Encoding client packets on [{}] threads", RuleI(Network, EncodeThreads));
+	}
+
 	auto loop_fn = [&](EQ::Timer* t) {
 		//Advance the timer to our current point in time
 		Timer::SetCurrentTime();
@@ -501,6 +514,8 @@ int main(int argc, char** argv) {
 			opts.daybreak_options.resend_delay_min = RuleI(Network, ResendDelayMinMS);
 			opts.daybreak_options.resend_delay_max = RuleI(Network, ResendDelayMaxMS);
 			opts.daybreak_options.outgoing_data_rate = RuleR(Network, ClientDataRate);
+			opts.daybreak_options.adaptive_combine = RuleB(Network, AdaptiveCombine);
+			opts.io_thread = RuleB(Network, DedicatedIOThread);
 			eqsm = std::make_unique<EQ::Net::EQStreamManager>(opts);
 			eqsf_open = true;
 
@@ -533,6 +548,10 @@ int main(int argc, char** argv) {
 			}
 		}
 
+		if (encode_pool) {
+			EQStreamProxy::BeginDeferredEncode();
+		}
+
 		if (is_zone_loaded) {
 			{
 				entity_list.GroupProcess();
@@ -560,6 +579,10 @@ int main(int argc, char** argv) {
 			}
 		}
 
+		if (encode_pool) {
+			EQStreamProxy::EndDeferredEncode(*encode_pool);
+		}
+
 		if (InterserverTimer.Check()) {
 			InterserverTimer.Start();
 			database.ping();
@@ -589,6 +612,7 @@ int main(int argc, char** argv) {
 	//Fix for Linux world server problem.
 	safe_delete(task_manager);
 	safe_delete(npc_scale_manager);
+	safe_delete(encode_pool);
 	command_deinit();
 #ifdef BOTS
 	bot_command_deinit();
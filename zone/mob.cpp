@@ -1733,10 +1733,15 @@ void Mob::ShowBuffList(Client* client) {
 	}
 }
 
+void Mob::UpdatePositionTable() {
+	entity_list.UpdateMobPosition(this);
+}
+
 void Mob::GMMove(float x, float y, float z, float heading, bool SendUpdate) {
 	m_Position.x = x;
 	m_Position.y = y;
 	m_Position.z = z;
+	UpdatePositionTable();
 	SetHeading(heading);
 	mMovementManager->SendCommandToClients(this, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeAny);
 
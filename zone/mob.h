@@ -29,6 +29,7 @@
 #include "../common/light_source.h"
 #include "../common/emu_constants.h"
 #include <set>
+#include <unordered_set>
 #include <vector>
 #include <memory>
 
@@ -172,6 +173,7 @@ public:
 	void DisplayInfo(Mob *mob);
 
 	std::unordered_map<uint16, Mob *> close_mobs;
+	std::unordered_set<Mob *>         hate_list_owners; // mobs with this mob on their hate list
 	Timer                             mob_close_scan_timer;
 	Timer                             mob_check_moving_timer;
 
@@ -564,7 +566,8 @@ public:
 	uint32 GetNPCTypeID() const { return npctype_id; }
 	void SetNPCTypeID(uint32 npctypeid) { npctype_id = npctypeid; }
 	inline const glm::vec4& GetPosition() const { return m_Position; }
-	inline void SetPosition(const float x, const float y, const float z) { m_Position.x = x; m_Position.y = y; m_Position.z = z; }
+	inline void SetPosition(const float x, const float y, const float z) { m_Position.x = x; m_Position.y = y; m_Position.z = z; UpdatePositionTable(); }
+	void UpdatePositionTable(); // call after writing m_Position directly
 	inline const float GetX() const { return m_Position.x; }
 	inline const float GetY() const { return m_Position.y; }
 	inline const float GetZ() const { return m_Position.z; }
@@ -656,10 +659,10 @@ public:
 	void ClearFeignMemory();
 	bool IsOnFeignMemory(Client *attacker) const;
 	void PrintHateListToClient(Client *who) { hate_list.PrintHateListToClient(who); }
-	std::list<struct_HateList*>& GetHateList() { return hate_list.GetHateList(); }
+	std::vector<struct_HateList*>& GetHateList() { return hate_list.GetHateList(); }
 	std::list<struct_HateList*> GetHateListByDistance(int distance = 0) { return hate_list.GetHateListByDistance(distance); }
 	bool CheckLosFN(Mob* other);
-	bool CheckLosFN(float posX, float posY, float posZ, float mobSize);
+	bool CheckLosFN(float posX, float posY, float posZ, float mobSize, uint16 target_id = 0);
 	static bool CheckLosFN(glm::vec3 posWatcher, float sizeWatcher, glm::vec3 posTarget, float sizeTarget);
 	inline void SetLastLosState(bool value) { last_los_check = value; }
 	inline bool CheckLastLosState() const { return last_los_check; }
@@ -1826,20 +1826,7 @@ void NPC::AI_DoMovement() {
 
 void NPC::AI_SetupNextWaypoint() {
 	int32 spawn_id = this->GetSpawnPointID();
-	LinkedListIterator<Spawn2*> iterator(zone->spawn2_list);
-	iterator.Reset();
-	Spawn2 *found_spawn = nullptr;
-
-	while (iterator.MoreElements())
-	{
-		Spawn2* cur = iterator.GetData();
-		iterator.Advance();
-		if (cur->GetID() == spawn_id)
-		{
-			found_spawn = cur;
-			break;
-		}
-	}
+	Spawn2 *found_spawn = zone->spawn2_list.GetByID(spawn_id);
 
 	if (wandertype == GridOneWayRepop && cur_wp == CastToNPC()->GetMaxWp()) {
 		CastToNPC()->Depop(true); //depop and restart spawn timer
@@ -1910,6 +1897,7 @@ void Mob::AI_Event_Engaged(Mob *attacker, bool yell_for_help)
 				CastToNPC()->AIYellForHelp(this, attacker);
 				if (NPCAssistCap() > 0 && !assist_cap_timer.Enabled()) {
 					assist_cap_timer.Start(RuleI(Combat, NPCAssistCapTimer));
+					CastToNPC()->ScheduleEntityTimer(EntityTimer::NPCAssistCap);
 				}
 			}
 		}
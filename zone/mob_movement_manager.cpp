@@ -907,8 +907,11 @@ void MobMovementManager::SendCommandToClients(
 		}
 	}
 	else {
+		//compared squared, no sqrt per client
 		float short_range = RuleR(Pathing, ShortMovementUpdateRange);
 		float long_range  = zone->GetNpcPositionUpdateDistance();
+		short_range *= short_range;
+		long_range *= long_range;
 
 		for (auto &c : _impl->Clients) {
 			if (single_client && c != single_client) {
@@ -919,7 +922,7 @@ void MobMovementManager::SendCommandToClients(
 				continue;
 			}
 
-			float distance = c->CalculateDistance(mob->GetX(), mob->GetY(), mob->GetZ());
+			float distance = DistanceSquared(c->GetPosition(), mob->GetPosition());
 
 			bool match = false;
 			if (range & ClientRangeClose) {
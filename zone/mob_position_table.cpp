@@ -0,0 +1,102 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2021 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "mob_position_table.h"
+#include "mob.h"
+
+constexpr size_t MobPositionTable::BlockSize;
+
+void MobPositionTable::Add(Mob *mob)
+{
+	if (m_rows.count(mob)) {
+		Update(mob);
+		return;
+	}
+
+	uint8 type = TypeOther;
+	if (mob->IsClient()) {
+		type = TypeClient;
+	}
+	else if (mob->IsNPC()) {
+		type = TypeNPC;
+	}
+
+	m_rows[mob] = m_mobs.size();
+	m_x.push_back(0.0f);
+	m_y.push_back(0.0f);
+	m_z.push_back(0.0f);
+	m_aggro_range.push_back(0.0f);
+	m_types.push_back(type);
+	m_mobs.push_back(mob);
+
+	Update(mob);
+}
+
+void MobPositionTable::Remove(const Mob *mob)
+{
+	auto iter = m_rows.find(mob);
+	if (iter == m_rows.end()) {
+		return;
+	}
+
+	size_t row  = iter->second;
+	size_t last = m_mobs.size() - 1;
+	m_rows.erase(iter);
+
+	if (row != last) {
+		m_x[row]           = m_x[last];
+		m_y[row]           = m_y[last];
+		m_z[row]           = m_z[last];
+		m_aggro_range[row] = m_aggro_range[last];
+		m_types[row]       = m_types[last];
+		m_mobs[row]        = m_mobs[last];
+		m_rows[m_mobs[row]] = row;
+	}
+
+	m_x.pop_back();
+	m_y.pop_back();
+	m_z.pop_back();
+	m_aggro_range.pop_back();
+	m_types.pop_back();
+	m_mobs.pop_back();
+}
+
+void MobPositionTable::Update(Mob *mob)
+{
+	auto iter = m_rows.find(mob);
+	if (iter == m_rows.end()) {
+		return;
+	}
+
+	size_t row = iter->second;
+	m_x[row]           = mob->GetX();
+	m_y[row]           = mob->GetY();
+	m_z[row]           = mob->GetZ();
+	m_aggro_range[row] = mob->GetAggroRange();
+}
+
+void MobPositionTable::Clear()
+{
+	m_x.clear();
+	m_y.clear();
+	m_z.clear();
+	m_aggro_range.clear();
+	m_types.clear();
+	m_mobs.clear();
+	m_rows.clear();
+}
@@ -0,0 +1,103 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2021 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#ifndef EQEMU_MOB_POSITION_TABLE_H
+#define EQEMU_MOB_POSITION_TABLE_H
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include <glm/vec3.hpp>
+
+#include "../common/types.h"
+
+class Mob;
+
+/**
+ * Positions of every mob in the entity list, one flat array per coordinate
+ *
+ * Zone wide range sweeps read these arrays instead of pulling a whole Mob into cache per
+ * entity, and the distance loop is kept simple enough for the compiler to vectorize. The
+ * entity list adds and removes rows alongside mob_list and Mob::UpdatePositionTable keeps a
+ * row in step with m_Position. Rows are unordered, removing one moves the last row into it.
+ * Rows belong to the Mob rather than its entity id, which drops to 0 on death while the mob
+ * stays listed under the old one.
+ */
+class MobPositionTable {
+public:
+	enum : uint8 {
+		TypeClient = 0x01,
+		TypeNPC    = 0x02,
+		TypeOther  = 0x04
+	};
+
+	void Add(Mob *mob);
+	void Remove(const Mob *mob);
+	void Update(Mob *mob);
+	void Clear();
+
+	size_t Size() const { return m_mobs.size(); }
+
+	// calls fn(Mob *) for each mob of the given types within range, fn must not add or remove mobs
+	template<typename Fn>
+	void ForEachInRange(const glm::vec3 &center, float range_squared, uint8 type_mask, Fn fn) const
+	{
+		ForEachInRange(center, range_squared, std::numeric_limits<float>::infinity(), type_mask, fn);
+	}
+
+	// as above, also taking mobs anywhere in the zone whose aggro range is at least min_aggro_range
+	template<typename Fn>
+	void ForEachInRange(const glm::vec3 &center, float range_squared, float min_aggro_range, uint8 type_mask, Fn fn) const
+	{
+		uint8 hits[BlockSize];
+
+		for (size_t start = 0; start < m_mobs.size(); start += BlockSize) {
+			size_t      count  = std::min(BlockSize, m_mobs.size() - start);
+			const float *x     = &m_x[start];
+			const float *y     = &m_y[start];
+			const float *z     = &m_z[start];
+			const float *aggro = &m_aggro_range[start];
+
+			for (size_t i = 0; i < count; ++i) {
+				float dx = x[i] - center.x;
+				float dy = y[i] - center.y;
+				float dz = z[i] - center.z;
+				hits[i] = (dx * dx + dy * dy + dz * dz <= range_squared) | (aggro[i] >= min_aggro_range);
+			}
+
+			for (size_t i = 0; i < count; ++i) {
+				if (hits[i] && (m_types[start + i] & type_mask)) {
+					fn(m_mobs[start + i]);
+				}
+			}
+		}
+	}
+
+private:
+	static constexpr size_t BlockSize = 256;
+
+	std::vector<float>                      m_x;
+	std::vector<float>                      m_y;
+	std::vector<float>                      m_z;
+	std::vector<float>                      m_aggro_range;
+	std::vector<uint8>                      m_types;
+	std::vector<Mob *>                      m_mobs;
+	std::unordered_map<const Mob *, size_t> m_rows;
+};
+
+#endif
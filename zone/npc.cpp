@@ -711,147 +711,263 @@ void NPC::RemoveCash() {
 	platinum = 0;
 }
 
-bool NPC::Process()
+void NPC::ScheduleEntityTimers()
 {
-	if (p_depop)
-	{
-		Mob* owner = entity_list.GetMob(this->ownerid);
-		if (owner != 0)
-		{
-			//if(GetBodyType() != BT_SwarmPet)
-			// owner->SetPetID(0);
-			this->ownerid = 0;
-			this->petid = 0;
-		}
-		return false;
+	ScheduleEntityTimer(EntityTimer::NPCTic);
+	ScheduleEntityTimer(EntityTimer::NPCCloseScan);
+	ScheduleEntityTimer(EntityTimer::NPCCheckMoving);
+	ScheduleEntityTimer(EntityTimer::NPCEnrage);
+	ScheduleEntityTimer(EntityTimer::NPCAssist);
+	ScheduleEntityTimer(EntityTimer::NPCAssistCap);
+	ScheduleEntityTimer(EntityTimer::NPCQGlobalPurge);
+}
+
+Timer *NPC::GetEntityTimer(EntityTimer timer_id)
+{
+	switch (timer_id) {
+		case EntityTimer::NPCTic:
+			return &tic_timer;
+		case EntityTimer::NPCCloseScan:
+			return &mob_close_scan_timer;
+		case EntityTimer::NPCCheckMoving:
+			return &mob_check_moving_timer;
+		case EntityTimer::NPCEnrage:
+			return &enraged_timer;
+		case EntityTimer::NPCAssist:
+			return &assist_timer;
+		case EntityTimer::NPCAssistCap:
+			return &assist_cap_timer;
+		case EntityTimer::NPCQGlobalPurge:
+			return &qglobal_purge_timer;
+		default:
+			return nullptr;
 	}
+}
 
-	if (IsStunned() && stunned_timer.Check()) {
-		Mob::UnStun();
-		this->spun_timer.Disable();
+/**
+ * Hands the timer to the entity timer service for when it will next be due, the Timer itself
+ * stays authoritative so a disabled timer simply drops out of the service
+ *
+ * @param timer_id
+ */
+void NPC::ScheduleEntityTimer(EntityTimer timer_id)
+{
+	Timer *timer = GetEntityTimer(timer_id);
+	if (!timer || !timer->Enabled()) {
+		entity_list.CancelEntityTimer(GetID(), timer_id);
+		return;
 	}
 
-	SpellProcess();
+	// Timer::Check fires once strictly past its duration
+	entity_list.ScheduleEntityTimer(GetID(), timer_id, timer->GetRemainingTime() + 1);
+}
+
+void NPC::ProcessEntityTimer(EntityTimer timer_id)
+{
+	Timer *timer = GetEntityTimer(timer_id);
+	if (!timer) {
+		return;
+	}
 
-	if (mob_close_scan_timer.Check()) {
-		entity_list.ScanCloseMobs(close_mobs, this, IsMoving());
+	// these used to sit behind the depop, mez and stun early outs in Process, leave them due until those clear
+	bool held = timer_id >= EntityTimer::NPCEnrage && (p_depop || IsMezzed() || IsStunned());
+	if (held) {
+		entity_list.ScheduleEntityTimer(GetID(), timer_id, EntityTimerService::SlotMS);
+		return;
 	}
 
+	if (timer->Check()) {
+		switch (timer_id) {
+			case EntityTimer::NPCTic:
+				if (!p_depop) {
+					ProcessTic();
+				}
+				break;
+			case EntityTimer::NPCCloseScan:
+				entity_list.ScanCloseMobs(close_mobs, this, IsMoving());
+				break;
+			case EntityTimer::NPCCheckMoving:
+				CheckCloseScanTimer();
+				break;
+			case EntityTimer::NPCEnrage:
+				ProcessEnrage();
+
+				/* Don't keep running the check every second if we don't have enrage */
+				if (!GetSpecialAbility(SPECATK_ENRAGE)) {
+					enraged_timer.Disable();
+				}
+				break;
+			case EntityTimer::NPCAssistCap:
+				if (NPCAssistCap() > 0) {
+					DelAssistCap();
+				}
+				else {
+					assist_cap_timer.Disable();
+				}
+				break;
+			case EntityTimer::NPCAssist:
+				if (IsEngaged() && !Charmed() && !HasAssistAggro() && NPCAssistCap() < RuleI(Combat, NPCAssistCap)) {
+					AIYellForHelp(this, GetTarget());
+					if (NPCAssistCap() > 0 && !assist_cap_timer.Enabled()) {
+						assist_cap_timer.Start(RuleI(Combat, NPCAssistCapTimer));
+						ScheduleEntityTimer(EntityTimer::NPCAssistCap);
+					}
+				}
+				break;
+			case EntityTimer::NPCQGlobalPurge:
+				if (qGlobals) {
+					qGlobals->PurgeExpiredGlobals();
+				}
+				break;
+			default:
+				break;
+		}
+	}
+
+	ScheduleEntityTimer(timer_id);
+}
+
+void NPC::CheckCloseScanTimer()
+{
 	const uint16 npc_mob_close_scan_timer_moving = 6000;
 	const uint16 npc_mob_close_scan_timer_idle   = 60000;
 
-	if (mob_check_moving_timer.Check()) {
-		if (moving) {
-			if (mob_close_scan_timer.GetRemainingTime() > npc_mob_close_scan_timer_moving) {
-				LogAIScanCloseDetail("NPC [{}] Restarting with moving timer", GetCleanName());
-				mob_close_scan_timer.Disable();
-				mob_close_scan_timer.Start(npc_mob_close_scan_timer_moving);
-				mob_close_scan_timer.Trigger();
-			}
-		}
-		else if (mob_close_scan_timer.GetDuration() == npc_mob_close_scan_timer_moving) {
-			LogAIScanCloseDetail("NPC [{}] Restarting with idle timer", GetCleanName());
+	if (moving) {
+		if (mob_close_scan_timer.GetRemainingTime() > npc_mob_close_scan_timer_moving) {
+			LogAIScanCloseDetail("NPC [{}] Restarting with moving timer", GetCleanName());
 			mob_close_scan_timer.Disable();
-			mob_close_scan_timer.Start(npc_mob_close_scan_timer_idle);
+			mob_close_scan_timer.Start(npc_mob_close_scan_timer_moving);
+			mob_close_scan_timer.Trigger();
+			ScheduleEntityTimer(EntityTimer::NPCCloseScan);
 		}
 	}
+	else if (mob_close_scan_timer.GetDuration() == npc_mob_close_scan_timer_moving) {
+		LogAIScanCloseDetail("NPC [{}] Restarting with idle timer", GetCleanName());
+		mob_close_scan_timer.Disable();
+		mob_close_scan_timer.Start(npc_mob_close_scan_timer_idle);
+		ScheduleEntityTimer(EntityTimer::NPCCloseScan);
+	}
+}
 
-	if (tic_timer.Check()) {
-		parse->EventNPC(EVENT_TICK, this, nullptr, "", 0);
-		BuffProcess();
+void NPC::ProcessTic()
+{
+	parse->EventNPC(EVENT_TICK, this, nullptr, "", 0);
+	BuffProcess();
 
-		if (currently_fleeing) {
-			ProcessFlee();
-		}
+	if (currently_fleeing) {
+		ProcessFlee();
+	}
 
-		uint32 npc_sitting_regen_bonus = 0;
-		uint32 pet_regen_bonus         = 0;
-		uint32 npc_regen               = 0;
-		int32  npc_hp_regen            = GetNPCHPRegen();
+	uint32 npc_sitting_regen_bonus = 0;
+	uint32 pet_regen_bonus         = 0;
+	uint32 npc_regen               = 0;
+	int32  npc_hp_regen            = GetNPCHPRegen();
 
-		if (GetAppearance() == eaSitting) {
-			npc_sitting_regen_bonus += 3;
-		}
+	if (GetAppearance() == eaSitting) {
+		npc_sitting_regen_bonus += 3;
+	}
 
-		int32 ooc_regen_calc = 0;
-		if (ooc_regen > 0) { //should pull from Mob class
-			ooc_regen_calc += GetMaxHP() * ooc_regen / 100;
-		}
+	int32 ooc_regen_calc = 0;
+	if (ooc_regen > 0) { //should pull from Mob class
+		ooc_regen_calc += GetMaxHP() * ooc_regen / 100;
+	}
 
-		/**
-		 * Use max value between two values
-		 */
-		npc_regen = std::max(npc_hp_regen, ooc_regen_calc);
+	/**
+	 * Use max value between two values
+	 */
+	npc_regen = std::max(npc_hp_regen, ooc_regen_calc);
 
-		if ((GetHP() < GetMaxHP()) && !IsPet()) {
-			if (!IsEngaged()) {
-				SetHP(GetHP() + npc_regen + npc_sitting_regen_bonus);
+	if ((GetHP() < GetMaxHP()) && !IsPet()) {
+		if (!IsEngaged()) {
+			SetHP(GetHP() + npc_regen + npc_sitting_regen_bonus);
+		}
+		else {
+			SetHP(GetHP() + npc_hp_regen);
+		}
+	}
+	else if (GetHP() < GetMaxHP() && GetOwnerID() != 0) {
+		if (!IsEngaged()) {
+			if (ooc_regen > 0) {
+				pet_regen_bonus = std::max(ooc_regen_calc, npc_hp_regen);
 			}
 			else {
-				SetHP(GetHP() + npc_hp_regen);
+				pet_regen_bonus = npc_hp_regen + (GetLevel() / 5);
 			}
+
+			SetHP(GetHP() + npc_sitting_regen_bonus + pet_regen_bonus);
+		}
+		else {
+			SetHP(GetHP() + npc_hp_regen);
 		}
-		else if (GetHP() < GetMaxHP() && GetOwnerID() != 0) {
-			if (!IsEngaged()) {
-				if (ooc_regen > 0) {
-					pet_regen_bonus = std::max(ooc_regen_calc, npc_hp_regen);
-				}
-				else {
-					pet_regen_bonus = npc_hp_regen + (GetLevel() / 5);
-				}
 
-				SetHP(GetHP() + npc_sitting_regen_bonus + pet_regen_bonus);
-			}
-			else {
-				SetHP(GetHP() + npc_hp_regen);
+	}
+	else {
+		SetHP(GetHP() + npc_hp_regen + npc_sitting_regen_bonus);
+	}
+
+	if (GetMana() < GetMaxMana()) {
+		if (RuleB(NPC, UseMeditateBasedManaRegen)) {
+			int32 npc_idle_mana_regen_bonus = 2;
+			uint16 meditate_skill = GetSkill(EQ::skills::SkillMeditate);
+			if (!IsEngaged() && meditate_skill > 0) {
+				uint8 clevel = GetLevel();
+				npc_idle_mana_regen_bonus =
+					(((meditate_skill / 10) +
+					(clevel - (clevel / 4))) / 4) + 4;
 			}
-
+			SetMana(GetMana() + mana_regen + npc_idle_mana_regen_bonus);
 		}
 		else {
-			SetHP(GetHP() + npc_hp_regen + npc_sitting_regen_bonus);
-		}
-
-		if (GetMana() < GetMaxMana()) {
-			if (RuleB(NPC, UseMeditateBasedManaRegen)) {
-				int32 npc_idle_mana_regen_bonus = 2;
-				uint16 meditate_skill = GetSkill(EQ::skills::SkillMeditate);
-				if (!IsEngaged() && meditate_skill > 0) {
-					uint8 clevel = GetLevel();
-					npc_idle_mana_regen_bonus =
-						(((meditate_skill / 10) +
-						(clevel - (clevel / 4))) / 4) + 4;
+			SetMana(GetMana() + mana_regen + npc_sitting_regen_bonus);
+		}
+	}
+
+	SendHPUpdate();
+
+	if (zone->adv_data && !p_depop) {
+		ServerZoneAdventureDataReply_Struct *ds = (ServerZoneAdventureDataReply_Struct *) zone->adv_data;
+		if (ds->type == Adventure_Rescue && ds->data_id == GetNPCTypeID()) {
+			Mob *o = GetOwner();
+			if (o && o->IsClient()) {
+				float x_diff = ds->dest_x - GetX();
+				float y_diff = ds->dest_y - GetY();
+				float z_diff = ds->dest_z - GetZ();
+				float dist   = ((x_diff * x_diff) + (y_diff * y_diff) + (z_diff * z_diff));
+				if (dist < RuleR(Adventure, DistanceForRescueComplete)) {
+					zone->DoAdventureCountIncrease();
+					Say(
+						"You don't know what this means to me. Thank you so much for finding and saving me from"
+						" this wretched place. I'll find my way from here."
+					);
+					Depop();
 				}
-				SetMana(GetMana() + mana_regen + npc_idle_mana_regen_bonus);
-			}
-			else {
-				SetMana(GetMana() + mana_regen + npc_sitting_regen_bonus);
 			}
 		}
+	}
+}
 
-		SendHPUpdate();
-
-		if (zone->adv_data && !p_depop) {
-			ServerZoneAdventureDataReply_Struct *ds = (ServerZoneAdventureDataReply_Struct *) zone->adv_data;
-			if (ds->type == Adventure_Rescue && ds->data_id == GetNPCTypeID()) {
-				Mob *o = GetOwner();
-				if (o && o->IsClient()) {
-					float x_diff = ds->dest_x - GetX();
-					float y_diff = ds->dest_y - GetY();
-					float z_diff = ds->dest_z - GetZ();
-					float dist   = ((x_diff * x_diff) + (y_diff * y_diff) + (z_diff * z_diff));
-					if (dist < RuleR(Adventure, DistanceForRescueComplete)) {
-						zone->DoAdventureCountIncrease();
-						Say(
-							"You don't know what this means to me. Thank you so much for finding and saving me from"
-							" this wretched place. I'll find my way from here."
-						);
-						Depop();
-					}
-				}
-			}
+bool NPC::Process()
+{
+	if (p_depop)
+	{
+		Mob* owner = entity_list.GetMob(this->ownerid);
+		if (owner != 0)
+		{
+			//if(GetBodyType() != BT_SwarmPet)
+			// owner->SetPetID(0);
+			this->ownerid = 0;
+			this->petid = 0;
 		}
+		return false;
+	}
+
+	if (IsStunned() && stunned_timer.Check()) {
+		Mob::UnStun();
+		this->spun_timer.Disable();
 	}
 
+	SpellProcess();
+
 	/**
 	 * Send HP updates when engaged
 	 */
@@ -897,38 +1013,6 @@ bool NPC::Process()
 		return true;
 	}
 
-	if (enraged_timer.Check()){
-		ProcessEnrage();
-
-		/* Don't keep running the check every second if we don't have enrage */
-		if (!GetSpecialAbility(SPECATK_ENRAGE)) {
-			enraged_timer.Disable();
-		}
-	}
-
-	//Handle assists...
-	if (assist_cap_timer.Check()) {
-		if (NPCAssistCap() > 0)
-			DelAssistCap();
-		else
-			assist_cap_timer.Disable();
-	}
-
-	if (assist_timer.Check() && IsEngaged() && !Charmed() && !HasAssistAggro() &&
-	    NPCAssistCap() < RuleI(Combat, NPCAssistCap)) {
-		AIYellForHelp(this, GetTarget());
-		if (NPCAssistCap() > 0 && !assist_cap_timer.Enabled())
-			assist_cap_timer.Start(RuleI(Combat, NPCAssistCapTimer));
-	}
-
-	if(qGlobals)
-	{
-		if(qglobal_purge_timer.Check())
-		{
-			qGlobals->PurgeExpiredGlobals();
-		}
-	}
-
 	AI_Process();
 
 	return true;
@@ -130,6 +130,9 @@ public:
 	virtual bool IsNPC() const { return true; }
 
 	virtual bool Process();
+	void			ProcessEntityTimer(EntityTimer timer_id);
+	void			ScheduleEntityTimer(EntityTimer timer_id);
+	void			ScheduleEntityTimers();
 	virtual void	AI_Init();
 	virtual void	AI_Start(uint32 iMoveDelay = 0);
 	virtual void	AI_Stop();
@@ -370,6 +373,8 @@ public:
 	inline bool WillAggroNPCs() const { return(npc_aggro); }
 
 	inline void GiveNPCTypeData(NPCType *ours) { NPCTypedata_ours = ours; }
+	inline const NPCType *GetNPCTypeData() const { return NPCTypedata; }
+	inline void SetNPCTypeData(const NPCType *npc_type_data) { NPCTypedata = npc_type_data; }
 	inline const uint32 GetNPCSpellsID()	const { return npc_spells_id; }
 	inline const uint32 GetNPCSpellsEffectsID()	const { return npc_spells_effects_id; }
 
@@ -643,6 +648,10 @@ protected:
 
 
 private:
+	Timer *GetEntityTimer(EntityTimer timer_id);
+	void   CheckCloseScanTimer();
+	void   ProcessTic();
+
 	uint32 loottable_id;
 	bool   skip_global_loot;
 	bool   skip_auto_scale;
@@ -0,0 +1,236 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2021 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#ifndef EQEMU_PROXIMITY_GRID_H
+#define EQEMU_PROXIMITY_GRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+#include <glm/vec3.hpp>
+
+#include "../common/types.h"
+
+/**
+ * Coarse 2D bucket index over axis aligned boxes (quest proximities, script areas)
+ *
+ * A box is registered in every x/y cell it overlaps, so a point query only has to look at the
+ * boxes sharing its cell. Boxes that would cover more than MaxCellsPerEntry cells are kept in an
+ * unbucketed list that every query returns. Queries return candidates only, callers still do the
+ * exact 3D containment test.
+ *
+ * Candidates come back in the order their values were first inserted, the same order the entity
+ * list walked its proximity and area lists in, so quest events fire in a repeatable order.
+ */
+template<typename T>
+class ProximityGrid {
+public:
+	static constexpr float CellSize         = 250.0f;
+	static constexpr int   MaxCellsPerEntry = 64;
+
+	/**
+	 * (Re)registers a value's box, a value that is already registered keeps its place in query order
+	 */
+	void Insert(T value, float min_x, float max_x, float min_y, float max_y)
+	{
+		auto   existing = m_entries.find(value);
+		uint64 sequence = existing != m_entries.end() ? existing->second.sequence : ++m_next_sequence;
+		Remove(value);
+
+		// an inverted box can never contain a point, nothing to index
+		if (min_x > max_x || min_y > max_y) {
+			return;
+		}
+
+		int cell_min_x = CellCoord(min_x);
+		int cell_max_x = CellCoord(max_x);
+		int cell_min_y = CellCoord(min_y);
+		int cell_max_y = CellCoord(max_y);
+
+		int64 cell_count = (int64) (cell_max_x - cell_min_x + 1) * (int64) (cell_max_y - cell_min_y + 1);
+		auto  &entry     = m_entries[value];
+		entry.sequence = sequence;
+		if (cell_count > MaxCellsPerEntry) {
+			InsertSlot(m_unbucketed, Slot{sequence, value});
+			return;
+		}
+
+		entry.cells.reserve((size_t) cell_count);
+		for (int cx = cell_min_x; cx <= cell_max_x; ++cx) {
+			for (int cy = cell_min_y; cy <= cell_max_y; ++cy) {
+				uint64 key = CellKey(cx, cy);
+				InsertSlot(m_cells[key], Slot{sequence, value});
+				entry.cells.push_back(key);
+			}
+		}
+	}
+
+	void Remove(T value)
+	{
+		auto entry = m_entries.find(value);
+		if (entry == m_entries.end()) {
+			return;
+		}
+
+		if (entry->second.cells.empty()) {
+			EraseSlot(m_unbucketed, entry->second.sequence);
+		}
+
+		for (auto key : entry->second.cells) {
+			auto cell = m_cells.find(key);
+			if (cell == m_cells.end()) {
+				continue;
+			}
+
+			EraseSlot(cell->second, entry->second.sequence);
+			if (cell->second.empty()) {
+				m_cells.erase(cell);
+			}
+		}
+
+		m_entries.erase(entry);
+	}
+
+	void Clear()
+	{
+		m_cells.clear();
+		m_entries.clear();
+		m_unbucketed.clear();
+	}
+
+	bool Empty() const { return m_entries.empty(); }
+
+	/**
+	 * Appends every value whose box may contain either point, without duplicates
+	 */
+	template<typename Container>
+	void Query(const glm::vec3 &a, const glm::vec3 &b, Container &out) const
+	{
+		uint64 key_a = CellKey(CellCoord(a.x), CellCoord(a.y));
+		uint64 key_b = CellKey(CellCoord(b.x), CellCoord(b.y));
+
+		AppendMerged(FindCell(key_a), key_b != key_a ? FindCell(key_b) : nullptr, out);
+	}
+
+	template<typename Container>
+	void Query(const glm::vec3 &a, Container &out) const
+	{
+		AppendMerged(FindCell(CellKey(CellCoord(a.x), CellCoord(a.y))), nullptr, out);
+	}
+
+private:
+	// every slot list is kept ordered by sequence
+	struct Slot {
+		uint64 sequence;
+		T      value;
+	};
+
+	struct Entry {
+		uint64              sequence;
+		std::vector<uint64> cells; // empty when unbucketed
+	};
+
+	// positions such as FLT_MAX (used to clear client proximities) are clamped to the edge cells
+	static int CellCoord(float v)
+	{
+		const float limit = 1.0e8f;
+		if (!(v > -limit)) {
+			v = -limit;
+		}
+		else if (v > limit) {
+			v = limit;
+		}
+
+		return static_cast<int>(std::floor(v / CellSize));
+	}
+
+	static uint64 CellKey(int cx, int cy)
+	{
+		return ((uint64) (uint32) cx << 32) | (uint64) (uint32) cy;
+	}
+
+	const std::vector<Slot> *FindCell(uint64 key) const
+	{
+		auto cell = m_cells.find(key);
+		return cell != m_cells.end() ? &cell->second : nullptr;
+	}
+
+	/**
+	 * Merges the unbucketed list with up to two cells by sequence, a box registered in both cells
+	 * shares its sequence across them and is only appended once
+	 */
+	template<typename Container>
+	void AppendMerged(const std::vector<Slot> *cell_a, const std::vector<Slot> *cell_b, Container &out) const
+	{
+		const std::vector<Slot> *lists[3]     = {&m_unbucketed, cell_a, cell_b};
+		size_t                  positions[3]  = {0, 0, 0};
+		uint64                  last_sequence = 0; // sequences start at 1
+
+		for (;;) {
+			int next = -1;
+			for (int i = 0; i < 3; ++i) {
+				if (!lists[i] || positions[i] >= lists[i]->size()) {
+					continue;
+				}
+
+				if (next < 0 || (*lists[i])[positions[i]].sequence < (*lists[next])[positions[next]].sequence) {
+					next = i;
+				}
+			}
+
+			if (next < 0) {
+				return;
+			}
+
+			const Slot &slot = (*lists[next])[positions[next]++];
+			if (slot.sequence != last_sequence) {
+				out.push_back(slot.value);
+				last_sequence = slot.sequence;
+			}
+		}
+	}
+
+	static void InsertSlot(std::vector<Slot> &slots, const Slot &slot)
+	{
+		auto it = std::upper_bound(
+			slots.begin(), slots.end(), slot.sequence, [](uint64 sequence, const Slot &s) {
+				return sequence < s.sequence;
+			}
+		);
+		slots.insert(it, slot);
+	}
+
+	static void EraseSlot(std::vector<Slot> &slots, uint64 sequence)
+	{
+		auto it = std::lower_bound(
+			slots.begin(), slots.end(), sequence, [](const Slot &s, uint64 sequence) {
+				return s.sequence < sequence;
+			}
+		);
+		if (it != slots.end() && it->sequence == sequence) {
+			slots.erase(it);
+		}
+	}
+
+	std::unordered_map<uint64, std::vector<Slot>> m_cells;
+	std::unordered_map<T, Entry>                  m_entries; // value -> its sequence and the cells it is registered in
+	std::vector<Slot>                             m_unbucketed;
+	uint64                                        m_next_sequence = 0;
+};
+
+#endif //EQEMU_PROXIMITY_GRID_H
@@ -20,6 +20,8 @@
 #include "../common/global_define.h"
 #include "../common/misc_functions.h"
 #include "../common/features.h"
+#include "../common/string_util.h"
+#include "../common/util/directory.h"
 
 #include "quest_parser_collection.h"
 #include "quest_interface.h"
@@ -82,11 +84,72 @@ void QuestParserCollection::ReloadQuests(bool reset_timers) {
 	_spell_quest_status.clear();
 	_item_quest_status.clear();
 	_encounter_quest_status.clear();
+	_quest_files.clear();
 	auto iter = _load_precedence.begin();
 	while(iter != _load_precedence.end()) {
 		(*iter)->ReloadQuests();
 		++iter;
 	}
+
+	if(zone && zone->IsLoaded()) {
+		PreloadQuests();
+	}
+}
+
+void QuestParserCollection::PreloadQuests() {
+	if(!RuleB(Zone, PreloadQuests) || !zone) {
+		return;
+	}
+
+	std::string filename;
+	if(_global_npc_quest_status == QuestUnloaded) {
+		QuestInterface *qi = GetQIByGlobalNPCQuest(filename);
+		if(qi) {
+			qi->LoadGlobalNPCScript(filename);
+			_global_npc_quest_status = qi->GetIdentifier();
+		}
+	}
+
+	if(_player_quest_status == QuestUnloaded) {
+		QuestInterface *qi = GetQIByPlayerQuest(filename);
+		if(qi) {
+			_player_quest_status = qi->GetIdentifier();
+			qi->LoadPlayerScript(filename);
+		}
+	}
+
+	if(_global_player_quest_status == QuestUnloaded) {
+		QuestInterface *qi = GetQIByGlobalPlayerQuest(filename);
+		if(qi) {
+			_global_player_quest_status = qi->GetIdentifier();
+			qi->LoadGlobalPlayerScript(filename);
+		}
+	}
+
+	//every npc type that can spawn here, so the first event on each does not have to load its script
+	std::set<uint32> npc_types;
+	zone->spawn_group_list.GetNPCTypes(npc_types);
+	if(RuleB(Zone, UseZoneController)) {
+		npc_types.insert(ZONE_CONTROLLER_NPC_ID);
+	}
+
+	uint32 loaded = 0;
+	for(auto npcid : npc_types) {
+		if(_npc_quest_status.find(npcid) != _npc_quest_status.end()) {
+			continue;
+		}
+
+		QuestInterface *qi = GetQIByNPCQuest(npcid, filename);
+		if(qi) {
+			_npc_quest_status[npcid] = qi->GetIdentifier();
+			qi->LoadNPCScript(filename, npcid);
+			++loaded;
+		} else {
+			_npc_quest_status[npcid] = QuestFailedToLoad;
+		}
+	}
+
+	LogQuests("Preloaded quest scripts for [{}] of [{}] NPC types", loaded, npc_types.size());
 }
 
 void QuestParserCollection::RemoveEncounter(const std::string name) {
@@ -470,31 +533,79 @@ int QuestParserCollection::EventEncounter(QuestEventID evt, std::string encounte
 	return 0;
 }
 
-QuestInterface *QuestParserCollection::GetQIByNPCQuest(uint32 npcid, std::string &filename) {
-	//first look for /quests/zone/npcid.ext (precedence)
-	filename = Config->QuestDir;
-	filename += zone->GetShortName();
-	filename += "/";
-	filename += itoa(npcid);
-	std::string tmp;
-	FILE *f = nullptr;
+//file systems on windows and macOS ignore case by default, where opening a script found it whatever its case
+#if defined(_WINDOWS) || defined(__APPLE__)
+static std::string QuestFileKey(std::string name) {
+	ToLowerString(name);
+	return name;
+}
+#else
+static const std::string &QuestFileKey(const std::string &name) {
+	return name;
+}
+#endif
 
+const std::unordered_set<std::string> &QuestParserCollection::GetQuestDirectoryFiles(const std::string &dir) {
+	auto iter = _quest_files.find(dir);
+	if(iter != _quest_files.end()) {
+		return iter->second;
+	}
+
+	std::vector<std::string> files;
+	EQ::Directory d(dir);
+	d.GetFiles(files);
+
+	auto &entry = _quest_files[dir];
+	for(auto &f : files) {
+		entry.insert(QuestFileKey(f));
+	}
+	return entry;
+}
+
+QuestInterface *QuestParserCollection::GetQIByFile(const std::string &path, std::string &filename) {
+	auto pos = path.find_last_of('/');
+	std::string dir = pos == std::string::npos ? std::string(".") : path.substr(0, pos);
+	std::string name = pos == std::string::npos ? path : path.substr(pos + 1);
+
+	auto &files = GetQuestDirectoryFiles(dir);
+	if(files.empty()) {
+		return nullptr;
+	}
+
+	std::string tmp;
 	auto iter = _load_precedence.begin();
 	while(iter != _load_precedence.end()) {
-		tmp = filename;
 		auto ext = _extensions.find((*iter)->GetIdentifier());
+		tmp = name;
 		tmp += ".";
 		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
+		if(files.count(QuestFileKey(tmp))) {
+			filename = path;
+			filename += ".";
+			filename += ext->second;
 			return (*iter);
 		}
 
 		++iter;
 	}
 
+	return nullptr;
+}
+
+QuestInterface *QuestParserCollection::GetQIByNPCQuest(uint32 npcid, std::string &filename) {
+	//first look for /quests/zone/npcid.ext (precedence)
+	std::string zone_dir = Config->QuestDir;
+	zone_dir += zone->GetShortName();
+	zone_dir += "/";
+	std::string global_dir = Config->QuestDir;
+	global_dir += QUEST_GLOBAL_DIRECTORY;
+	global_dir += "/";
+
+	QuestInterface *qi = GetQIByFile(zone_dir + itoa(npcid), filename);
+	if(qi) {
+		return qi;
+	}
+
 	//second look for /quests/zone/npcname.ext (precedence)
 	const NPCType *npc_type = content_db.LoadNPCTypesData(npcid);
 	if (!npc_type && npcid != ZONE_CONTROLLER_NPC_ID) {
@@ -515,112 +626,31 @@ QuestInterface *QuestParserCollection::GetQIByNPCQuest(uint32 npcid, std::string
 		}
 	}
 
-	filename = Config->QuestDir;
-	filename += zone->GetShortName();
-	filename += "/";
-	filename += npc_name;
-
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
+	qi = GetQIByFile(zone_dir + npc_name, filename);
+	if(qi) {
+		return qi;
 	}
 
 	//third look for /quests/global/npcid.ext (precedence)
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/";
-	filename += itoa(npcid);
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
+	qi = GetQIByFile(global_dir + itoa(npcid), filename);
+	if(qi) {
+		return qi;
 	}
 
 	//fourth look for /quests/global/npcname.ext (precedence)
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/";
-	filename += npc_name;
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
+	qi = GetQIByFile(global_dir + npc_name, filename);
+	if(qi) {
+		return qi;
 	}
 
 	//fifth look for /quests/zone/default.ext (precedence)
-	filename = Config->QuestDir;
-	filename += zone->GetShortName();
-	filename += "/";
-	filename += "default";
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
+	qi = GetQIByFile(zone_dir + "default", filename);
+	if(qi) {
+		return qi;
 	}
 
 	//last look for /quests/global/default.ext (precedence)
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/";
-	filename += "default";
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
-	}
-
-	return nullptr;
+	return GetQIByFile(global_dir + "default", filename);
 }
 
 QuestInterface *QuestParserCollection::GetQIByPlayerQuest(std::string &filename) {
@@ -628,367 +658,120 @@ QuestInterface *QuestParserCollection::GetQIByPlayerQuest(std::string &filename)
 		return nullptr;
 
 	//first look for /quests/zone/player_v[instance_version].ext (precedence)
-	filename = Config->QuestDir;
-	filename += zone->GetShortName();
-	filename += "/";
-	filename += "player_v";
-	filename += itoa(zone->GetInstanceVersion());
-	std::string tmp;
-	FILE *f = nullptr;
+	std::string zone_dir = Config->QuestDir;
+	zone_dir += zone->GetShortName();
+	zone_dir += "/";
 
-	auto iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
+	QuestInterface *qi = GetQIByFile(zone_dir + "player_v" + itoa(zone->GetInstanceVersion()), filename);
+	if(qi) {
+		return qi;
 	}
 
 	//second look for /quests/zone/player.ext (precedence)
-	filename = Config->QuestDir;
-	filename += zone->GetShortName();
-	filename += "/";
-	filename += "player";
-
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
+	qi = GetQIByFile(zone_dir + "player", filename);
+	if(qi) {
+		return qi;
 	}
 
 	//third look for /quests/global/player.ext (precedence)
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/";
-	filename += "player";
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
-	}
-
-	return nullptr;
+	std::string global_dir = Config->QuestDir;
+	global_dir += QUEST_GLOBAL_DIRECTORY;
+	global_dir += "/";
+	return GetQIByFile(global_dir + "player", filename);
 }
 
 QuestInterface *QuestParserCollection::GetQIByGlobalNPCQuest(std::string &filename) {
 	// simply look for /quests/global/global_npc.ext
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/";
-	filename += "global_npc";
-	std::string tmp;
-	FILE *f = nullptr;
-
-	
-
-	auto iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
-	}
-
-	return nullptr;
+	std::string global_dir = Config->QuestDir;
+	global_dir += QUEST_GLOBAL_DIRECTORY;
+	global_dir += "/";
+	return GetQIByFile(global_dir + "global_npc", filename);
 }
 
 QuestInterface *QuestParserCollection::GetQIByGlobalPlayerQuest(std::string &filename) {
 	//first look for /quests/global/player.ext (precedence)
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/";
-	filename += "global_player";
-	std::string tmp;
-	FILE *f = nullptr;
-
-	auto iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
-	}
-
-	return nullptr;
+	std::string global_dir = Config->QuestDir;
+	global_dir += QUEST_GLOBAL_DIRECTORY;
+	global_dir += "/";
+	return GetQIByFile(global_dir + "global_player", filename);
 }
 
 QuestInterface *QuestParserCollection::GetQIBySpellQuest(uint32 spell_id, std::string &filename) {
 	//first look for /quests/zone/spells/spell_id.ext (precedence)
-	filename = Config->QuestDir;
-	filename += zone->GetShortName();
-	filename += "/spells/";
-	filename += itoa(spell_id);
-	std::string tmp;
-	FILE *f = nullptr;
-
-	auto iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
+	std::string zone_dir = Config->QuestDir;
+	zone_dir += zone->GetShortName();
+	zone_dir += "/spells/";
+	std::string global_dir = Config->QuestDir;
+	global_dir += QUEST_GLOBAL_DIRECTORY;
+	global_dir += "/spells/";
 
-		++iter;
+	QuestInterface *qi = GetQIByFile(zone_dir + itoa(spell_id), filename);
+	if(qi) {
+		return qi;
 	}
 
 	//second look for /quests/global/spells/spell_id.ext (precedence)
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/spells/";
-	filename += itoa(spell_id);
-
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
+	qi = GetQIByFile(global_dir + itoa(spell_id), filename);
+	if(qi) {
+		return qi;
 	}
 
 	//third look for /quests/zone/spells/default.ext (precedence)
-	filename = Config->QuestDir;
-	filename += zone->GetShortName();
-	filename += "/spells/default";
-
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
+	qi = GetQIByFile(zone_dir + "default", filename);
+	if(qi) {
+		return qi;
 	}
 
 	//last look for /quests/global/spells/default.ext (precedence)
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/spells/default";
-
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
-	}
-
-	return nullptr;
+	return GetQIByFile(global_dir + "default", filename);
 }
 
 QuestInterface *QuestParserCollection::GetQIByItemQuest(std::string item_script, std::string &filename) {
 	//first look for /quests/zone/items/item_script.ext (precedence)
-	filename = Config->QuestDir;
-	filename += zone->GetShortName();
-	filename += "/items/";
-	filename += item_script;
-	std::string tmp;
-	FILE *f = nullptr;
-
-	auto iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
+	std::string zone_dir = Config->QuestDir;
+	zone_dir += zone->GetShortName();
+	zone_dir += "/items/";
+	std::string global_dir = Config->QuestDir;
+	global_dir += QUEST_GLOBAL_DIRECTORY;
+	global_dir += "/items/";
 
-		++iter;
+	QuestInterface *qi = GetQIByFile(zone_dir + item_script, filename);
+	if(qi) {
+		return qi;
 	}
-	
-	//second look for /quests/global/items/item_script.ext (precedence)
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/items/";
-	filename += item_script;
 
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
+	//second look for /quests/global/items/item_script.ext (precedence)
+	qi = GetQIByFile(global_dir + item_script, filename);
+	if(qi) {
+		return qi;
 	}
 
 	//third look for /quests/zone/items/default.ext (precedence)
-	filename = Config->QuestDir;
-	filename += zone->GetShortName();
-	filename += "/items/default";
-
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
+	qi = GetQIByFile(zone_dir + "default", filename);
+	if(qi) {
+		return qi;
 	}
 
 	//last look for /quests/global/items/default.ext (precedence)
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/items/default";
-
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
-	}
-
-	return nullptr;
+	return GetQIByFile(global_dir + "default", filename);
 }
 
 QuestInterface *QuestParserCollection::GetQIByEncounterQuest(std::string encounter_name, std::string &filename) {
 	//first look for /quests/zone/encounters/encounter_name.ext (precedence)
-	filename = Config->QuestDir;
-	filename += zone->GetShortName();
-	filename += "/encounters/";
-	filename += encounter_name;
-	std::string tmp;
-	FILE *f = nullptr;
-
-	auto iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
+	std::string zone_dir = Config->QuestDir;
+	zone_dir += zone->GetShortName();
+	zone_dir += "/encounters/";
 
-		++iter;
+	QuestInterface *qi = GetQIByFile(zone_dir + encounter_name, filename);
+	if(qi) {
+		return qi;
 	}
-	
-	//second look for /quests/global/encounters/encounter_name.ext (precedence)
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/encounters/";
-	filename += encounter_name;
 
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
-	}
-
-	return nullptr;
+	//second look for /quests/global/encounters/encounter_name.ext (precedence)
+	std::string global_dir = Config->QuestDir;
+	global_dir += QUEST_GLOBAL_DIRECTORY;
+	global_dir += "/encounters/";
+	return GetQIByFile(global_dir + encounter_name, filename);
 }
 
 void QuestParserCollection::GetErrors(std::list<std::string> &err) {
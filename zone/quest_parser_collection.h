@@ -38,6 +38,8 @@
 
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 #define QuestFailedToLoad 0xFFFFFFFF
 #define QuestUnloaded 0x00
@@ -65,6 +67,7 @@ public:
 	void AddVar(std::string name, std::string val);
 	void Init();
 	void ReloadQuests(bool reset_timers = true);
+	void PreloadQuests();
 	void RemoveEncounter(const std::string name);
 
 	bool HasQuestSub(uint32 npcid, QuestEventID evt);
@@ -117,6 +120,8 @@ private:
 	int EventPlayerLocal(QuestEventID evt, Client *client, std::string data, uint32 extra_data,	std::vector<EQ::Any> *extra_pointers);
 	int EventPlayerGlobal(QuestEventID evt, Client *client, std::string data, uint32 extra_data, std::vector<EQ::Any> *extra_pointers);
 
+	const std::unordered_set<std::string> &GetQuestDirectoryFiles(const std::string &dir);
+	QuestInterface *GetQIByFile(const std::string &path, std::string &filename);
 	QuestInterface *GetQIByNPCQuest(uint32 npcid, std::string &filename);
 	QuestInterface *GetQIByGlobalNPCQuest(std::string &filename);
 	QuestInterface *GetQIByPlayerQuest(std::string &filename);
@@ -138,6 +143,9 @@ private:
 	std::map<uint32, std::string> _extensions;
 	std::list<QuestInterface*> _load_precedence;
 
+	//file names in each quest directory looked up so far, dropped on reload
+	std::unordered_map<std::string, std::unordered_set<std::string>> _quest_files;
+
 	//0x00 = Unloaded
 	//0xFFFFFFFF = Failed to Load
 	std::map<uint32, uint32> _npc_quest_status;
@@ -237,18 +237,7 @@ Mob* QuestManager::unique_spawn(int npc_type, int grid, int unused, const glm::v
 
 Mob *QuestManager::spawn_from_spawn2(uint32 spawn2_id)
 {
-	LinkedListIterator<Spawn2 *> iterator(zone->spawn2_list);
-	iterator.Reset();
-	Spawn2 *found_spawn = nullptr;
-
-	while (iterator.MoreElements()) {
-		Spawn2 *cur = iterator.GetData();
-		iterator.Advance();
-		if (cur->GetID() == spawn2_id) {
-			found_spawn = cur;
-			break;
-		}
-	}
+	Spawn2 *found_spawn = zone->spawn2_list.GetByID(spawn2_id);
 
 	if (found_spawn) {
 		SpawnGroup *spawn_group = zone->spawn_group_list.GetSpawnGroup(found_spawn->SpawnGroupID());
@@ -1790,6 +1779,8 @@ void QuestManager::set_proximity(float minx, float maxx, float miny, float maxy,
 	owner->CastToNPC()->proximity->max_z         = maxz;
 	owner->CastToNPC()->proximity->say           = bSay;
 	owner->CastToNPC()->proximity->proximity_set = true;
+
+	entity_list.UpdateProximity(owner->CastToNPC());
 }
 
 void QuestManager::clear_proximity() {
@@ -2450,15 +2441,12 @@ void QuestManager::clearspawntimers() {
         return;
 
 	//TODO: Dec 19, 2008, replace with code updated for current spawn timers.
-    LinkedListIterator<Spawn2*> iterator(zone->spawn2_list);
-	iterator.Reset();
-	while (iterator.MoreElements()) {
+	for (auto spawn : zone->spawn2_list) {
 		std::string query = StringFormat("DELETE FROM respawn_times "
                                         "WHERE id = %lu AND instance_id = %lu",
-                                        (unsigned long)iterator.GetData()->GetID(),
+                                        (unsigned long)spawn->GetID(),
                                         (unsigned long)zone->GetInstanceID());
         auto results = database.QueryDatabase(query);
-		iterator.Advance();
 	}
 }
 
@@ -2679,20 +2667,14 @@ void QuestManager::UpdateSpawnTimer(uint32 id, uint32 newTime)
 	bool found = false;
 
 	database.UpdateRespawnTime(id, 0, (newTime/1000));
-	LinkedListIterator<Spawn2*> iterator(zone->spawn2_list);
-	iterator.Reset();
-	while (iterator.MoreElements())
+	Spawn2 *spawn = zone->spawn2_list.GetByID(id);
+	if (spawn)
 	{
-		if(iterator.GetData()->GetID() == id)
+		if(!spawn->NPCPointerValid())
 		{
-			if(!iterator.GetData()->NPCPointerValid())
-			{
-				iterator.GetData()->SetTimer(newTime);
-			}
-			found = true;
-			break;
+			spawn->SetTimer(newTime);
 		}
-		iterator.Advance();
+		found = true;
 	}
 
 	if(!found)
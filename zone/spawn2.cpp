@@ -28,6 +28,8 @@
 #include "zonedb.h"
 #include "zone_store.h"
 
+#include <algorithm>
+
 extern EntityList entity_list;
 extern Zone* zone;
 
@@ -71,7 +73,7 @@ Spawn2::Spawn2(uint32 in_spawn2_id, uint32 spawngroup_id,
 	float in_x, float in_y, float in_z, float in_heading,
 	uint32 respawn, uint32 variance, uint32 timeleft, uint32 grid,
 	uint16 in_cond_id, int16 in_min_value, bool in_enabled, EmuAppearance anim)
-: timer(100000), killcount(0)
+: timer(100000), killcount(0), listed(false), schedule_serial(0)
 {
 	spawn2_id = in_spawn2_id;
 	spawngroup_id_ = spawngroup_id;
@@ -311,6 +313,12 @@ bool Spawn2::Process() {
 	return true;
 }
 
+void Spawn2::Enable()
+{
+	enabled = true;
+	ScheduleProcess();
+}
+
 void Spawn2::Disable()
 {
 	if(npcthis)
@@ -318,6 +326,20 @@ void Spawn2::Disable()
 		npcthis->Depop();
 	}
 	enabled = false;
+	ScheduleProcess();
+}
+
+void Spawn2::SetTimer(uint32 duration)
+{
+	timer.Start(duration);
+	ScheduleProcess();
+}
+
+void Spawn2::ScheduleProcess()
+{
+	if (zone) {
+		zone->spawn2_list.Schedule(this);
+	}
 }
 
 void Spawn2::LoadGrid(int start_wp) {
@@ -340,11 +362,13 @@ void Spawn2::LoadGrid(int start_wp) {
 void Spawn2::Reset() {
 	timer.Start(resetTimer());
 	npcthis = nullptr;
+	ScheduleProcess();
 	LogSpawns("Spawn2 [{}]: Spawn reset, repop in [{}] ms", spawn2_id, timer.GetRemainingTime());
 }
 
 void Spawn2::Depop() {
 	timer.Disable();
+	ScheduleProcess();
 	LogSpawns("Spawn2 [{}]: Spawn reset, repop disabled", spawn2_id);
 	npcthis = nullptr;
 }
@@ -358,6 +382,7 @@ void Spawn2::Repop(uint32 delay) {
 		timer.Start(delay);
 	}
 	npcthis = nullptr;
+	ScheduleProcess();
 }
 
 void Spawn2::ForceDespawn()
@@ -401,6 +426,7 @@ void Spawn2::ForceDespawn()
 
 	LogSpawns("Spawn2 [{}]: Spawn group [{}] set despawn timer to [{}] ms", spawn2_id, spawngroup_id_, cur);
 	timer.Start(cur);
+	ScheduleProcess();
 }
 
 //resets our spawn as if we just died
@@ -410,6 +436,7 @@ void Spawn2::DeathReset(bool realdeath)
 	uint32 cur = resetTimer();
 	//set our timer to our reset local
 	timer.Start(cur);
+	ScheduleProcess();
 
 	//zero out our NPC since he is now gone
 	npcthis = nullptr;
@@ -425,7 +452,7 @@ void Spawn2::DeathReset(bool realdeath)
 	}
 }
 
-bool ZoneDatabase::PopulateZoneSpawnListClose(uint32 zoneid, LinkedList<Spawn2*> &spawn2_list, int16 version, const glm::vec4& client_position, uint32 repop_distance)
+bool ZoneDatabase::PopulateZoneSpawnListClose(uint32 zoneid, Spawn2List &spawn2_list, int16 version, const glm::vec4& client_position, uint32 repop_distance)
 {
 	std::unordered_map<uint32, uint32> spawn_times;
 
@@ -531,7 +558,7 @@ bool ZoneDatabase::PopulateZoneSpawnListClose(uint32 zoneid, LinkedList<Spawn2*>
 	return true;
 }
 
-bool ZoneDatabase::PopulateZoneSpawnList(uint32 zoneid, LinkedList<Spawn2*> &spawn2_list, int16 version, uint32 repopdelay) {
+bool ZoneDatabase::PopulateZoneSpawnList(uint32 zoneid, Spawn2List &spawn2_list, int16 version, uint32 repopdelay) {
 
 	std::unordered_map<uint32, uint32> spawn_times;
 
@@ -629,7 +656,7 @@ bool ZoneDatabase::PopulateZoneSpawnList(uint32 zoneid, LinkedList<Spawn2*> &spa
 }
 
 
-Spawn2* ZoneDatabase::LoadSpawn2(LinkedList<Spawn2*> &spawn2_list, uint32 spawn2id, uint32 timeleft) {
+Spawn2* ZoneDatabase::LoadSpawn2(Spawn2List &spawn2_list, uint32 spawn2id, uint32 timeleft) {
 
 	std::string query = StringFormat("SELECT id, spawngroupID, x, y, z, heading, "
                                     "respawntime, variance, pathgrid, _condition, "
@@ -677,27 +704,13 @@ bool ZoneDatabase::CreateSpawn2(Client *client, uint32 spawngroup, const char* z
 }
 
 uint32 Zone::CountSpawn2() {
-	LinkedListIterator<Spawn2*> iterator(spawn2_list);
-	uint32 count = 0;
-
-	iterator.Reset();
-	while(iterator.MoreElements())
-	{
-		count++;
-		iterator.Advance();
-	}
-	return count;
+	return spawn2_list.Count();
 }
 
 void Zone::Despawn(uint32 spawn2ID) {
-	LinkedListIterator<Spawn2*> iterator(spawn2_list);
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		Spawn2 *cur = iterator.GetData();
+	for (auto cur : spawn2_list) {
 		if(spawn2ID == cur->spawn2_id)
 			cur->ForceDespawn();
-		iterator.Advance();
 	}
 }
 
@@ -763,14 +776,143 @@ void Spawn2::SpawnConditionChanged(const SpawnCondition &c, int16 old_value) {
 void Zone::SpawnConditionChanged(const SpawnCondition &c, int16 old_value) {
 	LogSpawns("Zone notified that spawn condition [{}] has changed from [{}] to [{}]. Notifying all spawn points", c.condition_id, old_value, c.value);
 
-	LinkedListIterator<Spawn2*> iterator(spawn2_list);
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		Spawn2 *cur = iterator.GetData();
+	for (auto cur : spawn2_list) {
 		if(cur->GetSpawnCondition() == c.condition_id)
 			cur->SpawnConditionChanged(c, old_value);
-		iterator.Advance();
+	}
+}
+
+Spawn2List::~Spawn2List()
+{
+	Clear();
+}
+
+void Spawn2List::Insert(Spawn2 *spawn)
+{
+	m_positions[spawn] = m_spawns.size();
+	m_spawns.push_back(spawn);
+	m_by_id.emplace(spawn->GetID(), spawn);
+	spawn->listed = true;
+	Schedule(spawn);
+}
+
+void Spawn2List::Remove(Spawn2 *spawn)
+{
+	auto position = m_positions.find(spawn);
+	if (position == m_positions.end()) {
+		return;
+	}
+
+	size_t index = position->second;
+	m_positions.erase(position);
+	if (index != m_spawns.size() - 1) {
+		m_spawns[index]              = m_spawns.back();
+		m_positions[m_spawns[index]] = index;
+	}
+	m_spawns.pop_back();
+
+	auto range = m_by_id.equal_range(spawn->GetID());
+	for (auto it = range.first; it != range.second; ++it) {
+		if (it->second == spawn) {
+			m_by_id.erase(it);
+			break;
+		}
+	}
+
+	m_events.erase(
+		std::remove_if(
+			m_events.begin(), m_events.end(), [spawn](const Event &e) {
+				return e.spawn == spawn;
+			}
+		),
+		m_events.end()
+	);
+	std::make_heap(m_events.begin(), m_events.end(), EventLater());
+
+	safe_delete(spawn);
+}
+
+void Spawn2List::Clear()
+{
+	m_events.clear();
+	m_positions.clear();
+	m_by_id.clear();
+
+	// swap out first, deleting a spawn can depop its npc which may look the list up again
+	std::vector<Spawn2 *> spawns;
+	spawns.swap(m_spawns);
+	for (auto spawn : spawns) {
+		safe_delete(spawn);
+	}
+}
+
+Spawn2 *Spawn2List::GetByID(uint32 spawn2_id) const
+{
+	auto it = m_by_id.find(spawn2_id);
+	if (it == m_by_id.end()) {
+		return nullptr;
+	}
+
+	return it->second;
+}
+
+/**
+ * Queues the spawn for when its timer comes due, replacing any earlier entry
+ *
+ * @param spawn
+ */
+void Spawn2List::Schedule(Spawn2 *spawn)
+{
+	if (!spawn->listed) {
+		return; // Insert schedules it
+	}
+
+	spawn->schedule_serial = ++m_next_serial;
+	if (!spawn->Enabled() || !spawn->timer.Enabled()) {
+		return;
+	}
+
+	Event e;
+	e.due    = Timer::GetCurrentTime() + spawn->timer.GetRemainingTime() + 1; // Timer::Check fires once strictly past due
+	e.serial = spawn->schedule_serial;
+	e.spawn  = spawn;
+	m_events.push_back(e);
+	std::push_heap(m_events.begin(), m_events.end(), EventLater());
+}
+
+void Spawn2List::Process()
+{
+	uint32 now          = Timer::GetCurrentTime();
+	uint32 first_serial = m_next_serial;
+
+	// entries queued while we run (a spawn repopping immediately) wait for the next tick
+	std::vector<Event> deferred;
+	while (!m_events.empty() && (int32) (m_events.front().due - now) <= 0) {
+		std::pop_heap(m_events.begin(), m_events.end(), EventLater());
+		Event e = m_events.back();
+		m_events.pop_back();
+
+		if (e.serial != e.spawn->schedule_serial) {
+			continue;
+		}
+
+		if ((int32) (e.serial - first_serial) > 0) {
+			deferred.push_back(e);
+			continue;
+		}
+
+		if (!e.spawn->Process()) {
+			Remove(e.spawn);
+			continue;
+		}
+
+		// still waiting (its npc is up, spawn limits, ...), Process re-checks it next tick
+		Schedule(e.spawn);
+	}
+
+	for (auto &e : deferred) {
+		m_events.push_back(e);
+		std::push_heap(m_events.begin(), m_events.end(), EventLater());
 	}
 }
 
@@ -21,6 +21,9 @@
 #include "../common/timer.h"
 #include "npc.h"
 
+#include <unordered_map>
+#include <vector>
+
 #define SC_AlwaysEnabled 0
 
 class SpawnCondition;
@@ -37,7 +40,7 @@ public:
 	~Spawn2();
 
 	void	LoadGrid(int start_wp = 0);
-	void	Enable() { enabled = true; }
+	void	Enable();
 	void	Disable();
 	bool	Enabled() { return enabled; }
 	bool	Process();
@@ -66,12 +69,15 @@ public:
 	bool	NPCPointerValid() { return (npcthis!=nullptr); }
 	void	SetNPCPointer(NPC* n) { npcthis = n; }
 	void	SetNPCPointerNull() { npcthis = nullptr; }
-	void	SetTimer(uint32 duration) { timer.Start(duration); }
+	void	SetTimer(uint32 duration);
 	uint32  GetKillCount() { return killcount; }
 protected:
 	friend class Zone;
+	friend class Spawn2List;
 	Timer	timer;
 private:
+	void	ScheduleProcess();
+
 	uint32	spawn2_id;
 	uint32	respawn_;
 	uint32	resetTimer();
@@ -92,6 +98,49 @@ private:
 	EmuAppearance anim;
 	bool IsDespawned;
 	uint32  killcount;
+	bool	listed;           //owned by a Spawn2List
+	uint32	schedule_serial;  //latest Spawn2List event for this spawn, older ones are stale
+};
+
+/**
+ * The zone's spawn points, stored contiguously with an index by spawn2 id, plus a min-heap of when
+ * each one next needs Spawn2::Process. A spawn tick only touches the points whose timer has come due; disabled points
+ * and points with a stopped timer are not queued until one of the Spawn2 calls restarts them.
+ */
+class Spawn2List {
+public:
+	typedef std::vector<Spawn2 *>::const_iterator const_iterator;
+
+	~Spawn2List();
+
+	const_iterator begin() const { return m_spawns.begin(); }
+	const_iterator end() const { return m_spawns.end(); }
+	size_t Count() const { return m_spawns.size(); }
+
+	void	Insert(Spawn2 *spawn); //takes ownership
+	void	Remove(Spawn2 *spawn); //deletes the spawn
+	void	Clear();
+	Spawn2	*GetByID(uint32 spawn2_id) const;
+
+	void	Schedule(Spawn2 *spawn);
+	void	Process();
+
+private:
+	struct Event {
+		uint32 due;
+		uint32 serial;
+		Spawn2 *spawn;
+	};
+
+	struct EventLater {
+		bool operator()(const Event &a, const Event &b) const { return (int32) (a.due - b.due) > 0; }
+	};
+
+	std::vector<Spawn2 *>                     m_spawns;
+	std::unordered_map<Spawn2 *, size_t>      m_positions;
+	std::unordered_multimap<uint32, Spawn2 *> m_by_id; //quest created spawns can share an id
+	std::vector<Event>                        m_events;
+	uint32                                    m_next_serial = 0;
 };
 
 class SpawnCondition {
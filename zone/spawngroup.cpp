@@ -112,6 +112,13 @@ uint32 SpawnGroup::GetNPCType(uint16 in_filter)
 	return npcType;
 }
 
+void SpawnGroup::GetNPCTypes(std::set<uint32> &npc_types) const
+{
+	for (auto &it : list_) {
+		npc_types.insert(it->NPCType);
+	}
+}
+
 void SpawnGroup::AddSpawnEntry(std::unique_ptr<SpawnEntry> &newEntry)
 {
 	list_.push_back(std::move(newEntry));
@@ -145,6 +152,13 @@ SpawnGroup *SpawnGroupList::GetSpawnGroup(uint32 in_id)
 	return (m_spawn_groups[in_id].get());
 }
 
+void SpawnGroupList::GetNPCTypes(std::set<uint32> &npc_types) const
+{
+	for (auto &it : m_spawn_groups) {
+		it.second->GetNPCTypes(npc_types);
+	}
+}
+
 bool SpawnGroupList::RemoveSpawnGroup(uint32 in_id)
 {
 	if (m_spawn_groups.count(in_id) != 1) {
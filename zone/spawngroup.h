@@ -23,6 +23,7 @@
 #include <map>
 #include <list>
 #include <memory>
+#include <set>
 
 class SpawnEntry {
 public:
@@ -56,6 +57,7 @@ public:
 
 	~SpawnGroup();
 	uint32 GetNPCType(uint16 condition_value_filter=1);
+	void GetNPCTypes(std::set<uint32> &npc_types) const;
 	void AddSpawnEntry(std::unique_ptr<SpawnEntry> &newEntry);
 	uint32 id;
 	bool wp_spawns;			// if true, spawn NPCs at a random waypoint location (if spawnpoint has a grid) instead of the spawnpoint's loc
@@ -78,6 +80,7 @@ public:
 
 	void AddSpawnGroup(std::unique_ptr<SpawnGroup> &new_group);
 	SpawnGroup *GetSpawnGroup(uint32 id);
+	void GetNPCTypes(std::set<uint32> &npc_types) const;
 	bool RemoveSpawnGroup(uint32 in_id);
 	void ClearSpawnGroups();
 	void ReloadSpawnGroups();
@@ -4877,6 +4877,7 @@ void Mob::Spin() {
 			m_Position.x = x;
 			m_Position.y = y;
 			m_Position.z = z;
+			UpdatePositionTable();
 			mMovementManager->SendCommandToClients(this, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeAny);
 		}
 		else {
@@ -32,6 +32,18 @@ ClientTaskState::~ClientTaskState()
 {
 }
 
+// the activities of task_id within a goal's activity list, which is sorted by task id
+static inline std::pair<std::vector<TaskActivityReference>::const_iterator, std::vector<TaskActivityReference>::const_iterator>
+GoalActivitiesForTask(const std::vector<TaskActivityReference> &goal_activities, int task_id)
+{
+	return std::equal_range(
+		goal_activities.begin(),
+		goal_activities.end(),
+		TaskActivityReference{task_id, 0},
+		[](const TaskActivityReference &a, const TaskActivityReference &b) { return a.task_id < b.task_id; }
+	);
+}
+
 void ClientTaskState::SendTaskHistory(Client *client, int task_index)
 {
 
@@ -551,6 +563,12 @@ bool ClientTaskState::UpdateTasksByNPC(Client *client, int activity_type, int np
 		return false;
 	}
 
+	// Only activities of this type whose goal is this NPC can be updated
+	auto goal_activities = task_manager->GetGoalActivities(activity_type, npc_type_id);
+	if (goal_activities == nullptr) {
+		return false;
+	}
+
 	// loop over the union of tasks and quests
 	for (auto &active_task : m_active_tasks) {
 		auto current_task = &active_task;
@@ -558,13 +576,19 @@ bool ClientTaskState::UpdateTasksByNPC(Client *client, int activity_type, int np
 			continue;
 		}
 
+		auto task_activities = GoalActivitiesForTask(*goal_activities, current_task->task_id);
+		if (task_activities.first == task_activities.second) {
+			continue;
+		}
+
 		// Check if there are any active kill activities for this p_task_data
 		auto p_task_data = task_manager->m_task_data[current_task->task_id];
 		if (p_task_data == nullptr) {
 			return false;
 		}
 
-		for (int activity_id = 0; activity_id < p_task_data->activity_count; activity_id++) {
+		for (auto it = task_activities.first; it != task_activities.second; ++it) {
+			int                       activity_id     = it->activity_id;
 			ClientActivityInformation *client_activity = &current_task->activity[activity_id];
 			ActivityInformation       *activity_info   = &p_task_data->activity_information[activity_id];
 
@@ -572,10 +596,6 @@ bool ClientTaskState::UpdateTasksByNPC(Client *client, int activity_type, int np
 			if (client_activity->activity_state != ActivityActive) {
 				continue;
 			}
-			// We are only interested in Kill activities
-			if (activity_info->activity_type != activity_type) {
-				continue;
-			}
 			// Is there a zone restriction on the activity_information ?
 			if (!activity_info->CheckZone(zone->GetZoneID())) {
 				LogTasks(
@@ -588,27 +608,6 @@ bool ClientTaskState::UpdateTasksByNPC(Client *client, int activity_type, int np
 				);
 				continue;
 			}
-			// Is the activity_information to kill this type of NPC ?
-			switch (activity_info->goal_method) {
-				case METHODSINGLEID:
-					if (activity_info->goal_id != npc_type_id) {
-						continue;
-					}
-					break;
-
-				case METHODLIST:
-					if (!task_manager->m_goal_list_manager.IsInList(
-						activity_info->goal_id,
-						npc_type_id
-					)) {
-						continue;
-					}
-					break;
-
-				default:
-					// If METHODQUEST, don't updated the activity_information here
-					continue;
-			}
 			// We found an active p_task_data to kill this type of NPC, so increment the done count
 			LogTasksDetail("Calling increment done count ByNPC");
 			IncrementDoneCount(client, p_task_data, current_task->slot, activity_id);
@@ -735,6 +734,12 @@ void ClientTaskState::UpdateTasksForItem(Client *client, ActivityType activity_t
 		return;
 	}
 
+	// Only activities of this type whose goal is this item can be updated
+	auto goal_activities = task_manager->GetGoalActivities(activity_type, item_id);
+	if (goal_activities == nullptr) {
+		return;
+	}
+
 	// loop over the union of tasks and quests
 	for (auto &active_task : m_active_tasks) {
 		auto current_task = &active_task;
@@ -742,6 +747,11 @@ void ClientTaskState::UpdateTasksForItem(Client *client, ActivityType activity_t
 			continue;
 		}
 
+		auto task_activities = GoalActivitiesForTask(*goal_activities, current_task->task_id);
+		if (task_activities.first == task_activities.second) {
+			continue;
+		}
+
 		// Check if there are any active loot activities for this task
 
 		TaskInformation *p_task_data = task_manager->m_task_data[current_task->task_id];
@@ -749,7 +759,8 @@ void ClientTaskState::UpdateTasksForItem(Client *client, ActivityType activity_t
 			return;
 		}
 
-		for (int activity_id = 0; activity_id < p_task_data->activity_count; activity_id++) {
+		for (auto it = task_activities.first; it != task_activities.second; ++it) {
+			int                       activity_id     = it->activity_id;
 			ClientActivityInformation *client_activity = &current_task->activity[activity_id];
 			ActivityInformation       *activity_info   = &p_task_data->activity_information[activity_id];
 
@@ -757,10 +768,6 @@ void ClientTaskState::UpdateTasksForItem(Client *client, ActivityType activity_t
 			if (client_activity->activity_state != ActivityActive) {
 				continue;
 			}
-			// We are only interested in the ActivityType we were called with
-			if (activity_info->activity_type != (int) activity_type) {
-				continue;
-			}
 			// Is there a zone restriction on the activity_information ?
 			if (!activity_info->CheckZone(zone->GetZoneID())) {
 				LogTasks(
@@ -771,25 +778,6 @@ void ClientTaskState::UpdateTasksForItem(Client *client, ActivityType activity_t
 				);
 				continue;
 			}
-			// Is the activity_information related to this item ?
-			//
-			switch (activity_info->goal_method) {
-
-				case METHODSINGLEID:
-					if (activity_info->goal_id != item_id) { continue; }
-					break;
-
-				case METHODLIST:
-					if (!task_manager->m_goal_list_manager.IsInList(
-						activity_info->goal_id,
-						item_id
-					)) { continue; }
-					break;
-
-				default:
-					// If METHODQUEST, don't updated the activity_information here
-					continue;
-			}
 			// We found an active task related to this item, so increment the done count
 			LogTasksDetail("[UpdateTasksForItem] Calling increment done count ForItem");
 			IncrementDoneCount(client, p_task_data, current_task->slot, activity_id, count);
@@ -804,6 +792,12 @@ void ClientTaskState::UpdateTasksOnExplore(Client *client, int explore_id)
 		return;
 	}
 
+	// Only explore activities for this area id can be updated
+	auto goal_activities = task_manager->GetGoalActivities(ActivityExplore, explore_id);
+	if (goal_activities == nullptr) {
+		return;
+	}
+
 	// loop over the union of tasks and quests
 	for (auto &active_task : m_active_tasks) {
 		auto current_task = &active_task;
@@ -811,6 +805,11 @@ void ClientTaskState::UpdateTasksOnExplore(Client *client, int explore_id)
 			continue;
 		}
 
+		auto task_activities = GoalActivitiesForTask(*goal_activities, current_task->task_id);
+		if (task_activities.first == task_activities.second) {
+			continue;
+		}
+
 		// Check if there are any active explore activities for this task
 
 		TaskInformation *task_data = task_manager->m_task_data[current_task->task_id];
@@ -818,7 +817,8 @@ void ClientTaskState::UpdateTasksOnExplore(Client *client, int explore_id)
 			return;
 		}
 
-		for (int activity_id = 0; activity_id < task_data->activity_count; activity_id++) {
+		for (auto it = task_activities.first; it != task_activities.second; ++it) {
+			int                       activity_id     = it->activity_id;
 			ClientActivityInformation *client_activity = &current_task->activity[activity_id];
 			ActivityInformation       *activity_info   = &task_data->activity_information[activity_id];
 
@@ -826,10 +826,6 @@ void ClientTaskState::UpdateTasksOnExplore(Client *client, int explore_id)
 			if (client_activity->activity_state != ActivityActive) {
 				continue;
 			}
-			// We are only interested in explore activities
-			if (activity_info->activity_type != ActivityExplore) {
-				continue;
-			}
 			if (!activity_info->CheckZone(zone->GetZoneID())) {
 				LogTasks(
 					"[UpdateTasksOnExplore] character [{}] explore_id [{}] failed zone check",
@@ -838,28 +834,6 @@ void ClientTaskState::UpdateTasksOnExplore(Client *client, int explore_id)
 				);
 				continue;
 			}
-			// Is the activity_information to explore this area id ?
-			switch (activity_info->goal_method) {
-
-				case METHODSINGLEID:
-					if (activity_info->goal_id != explore_id) {
-						continue;
-					}
-					break;
-
-				case METHODLIST:
-					if (!task_manager->m_goal_list_manager.IsInList(
-						activity_info->goal_id,
-						explore_id
-					)) {
-						continue;
-					}
-					break;
-
-				default:
-					// If METHODQUEST, don't updated the activity_information here
-					continue;
-			}
 
 			// We found an active task to explore this area, so set done count to goal count
 			// (Only a goal count of 1 makes sense for explore activities?)
@@ -894,6 +868,12 @@ bool ClientTaskState::UpdateTasksOnDeliver(
 		return false;
 	}
 
+	// Only deliver and give cash activities naming this NPC can be updated
+	auto goal_activities = task_manager->GetGoalActivities(ActivityDeliver, npc_type_id);
+	if (goal_activities == nullptr) {
+		return false;
+	}
+
 	// loop over the union of tasks and quests
 	for (int i = 0; i < MAXACTIVEQUESTS + 1; i++) {
 		auto current_task = &m_active_tasks[i];
@@ -901,13 +881,19 @@ bool ClientTaskState::UpdateTasksOnDeliver(
 			continue;
 		}
 
+		auto task_activities = GoalActivitiesForTask(*goal_activities, current_task->task_id);
+		if (task_activities.first == task_activities.second) {
+			continue;
+		}
+
 		// Check if there are any active deliver activities for this task
 		TaskInformation *p_task_data = task_manager->m_task_data[current_task->task_id];
 		if (p_task_data == nullptr) {
 			return false;
 		}
 
-		for (int activity_id = 0; activity_id < p_task_data->activity_count; activity_id++) {
+		for (auto it = task_activities.first; it != task_activities.second; ++it) {
+			int                       activity_id     = it->activity_id;
 			ClientActivityInformation *client_activity = &current_task->activity[activity_id];
 			ActivityInformation       *activity_info   = &p_task_data->activity_information[activity_id];
 
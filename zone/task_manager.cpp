@@ -56,6 +56,8 @@ void TaskManager::ReloadGoalLists()
 	if (!m_goal_list_manager.LoadLists()) {
 		Log(Logs::Detail, Logs::Tasks, "TaskManager::LoadTasks LoadLists failed");
 	}
+
+	BuildGoalActivityIndex();
 }
 
 bool TaskManager::LoadTasks(int single_task)
@@ -252,9 +254,86 @@ bool TaskManager::LoadTasks(int single_task)
 
 	LogTasks("Loaded [{}] Task Activities", task_activities.size());
 
+	BuildGoalActivityIndex();
+
 	return true;
 }
 
+static inline uint64 GoalActivityKey(int activity_type, int goal_entry)
+{
+	return ((uint64) (uint32) activity_type << 32) | (uint32) goal_entry;
+}
+
+/**
+ * Files every kill, loot, explore and deliver style activity under the npc, item or area ids
+ * that complete it, so the update paths only look at tasks that can actually be credited
+ */
+void TaskManager::BuildGoalActivityIndex()
+{
+	m_goal_activities.clear();
+
+	for (int task_id = 0; task_id < MAXTASKS; task_id++) {
+		TaskInformation *task_data = m_task_data[task_id];
+		if (task_data == nullptr) {
+			continue;
+		}
+
+		for (int activity_id = 0; activity_id < task_data->activity_count; activity_id++) {
+			ActivityInformation *activity_info = &task_data->activity_information[activity_id];
+
+			switch (activity_info->activity_type) {
+				case ActivityDeliver:
+				case ActivityGiveCash:
+					m_goal_activities[GoalActivityKey(ActivityDeliver, activity_info->deliver_to_npc)].push_back(
+						{task_id, activity_id}
+					);
+					break;
+
+				case ActivityKill:
+				case ActivitySpeakWith:
+				case ActivityLoot:
+				case ActivityExplore:
+				case ActivityTradeSkill:
+				case ActivityFish:
+				case ActivityForage:
+					if (activity_info->goal_method == METHODSINGLEID) {
+						m_goal_activities[GoalActivityKey(activity_info->activity_type, activity_info->goal_id)].push_back(
+							{task_id, activity_id}
+						);
+					}
+					else if (activity_info->goal_method == METHODLIST) {
+						for (auto &entry : m_goal_list_manager.GetListContents(activity_info->goal_id)) {
+							m_goal_activities[GoalActivityKey(activity_info->activity_type, entry)].push_back(
+								{task_id, activity_id}
+							);
+						}
+					}
+					break;
+
+				default:
+					break;
+			}
+		}
+	}
+
+	for (auto &e : m_goal_activities) {
+		std::sort(e.second.begin(), e.second.end());
+		e.second.erase(std::unique(e.second.begin(), e.second.end()), e.second.end());
+	}
+
+	LogTasks("Indexed [{}] task activity goals", m_goal_activities.size());
+}
+
+const std::vector<TaskActivityReference> *TaskManager::GetGoalActivities(int activity_type, int goal_entry) const
+{
+	auto it = m_goal_activities.find(GoalActivityKey(activity_type, goal_entry));
+	if (it == m_goal_activities.end()) {
+		return nullptr;
+	}
+
+	return &it->second;
+}
+
 bool TaskManager::SaveClientState(Client *client, ClientTaskState *client_task_state)
 {
 	// I am saving the slot in the ActiveTasks table, because unless a Task is cancelled/completed, the client
@@ -10,6 +10,7 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <unordered_map>
 
 class Client;
 
@@ -74,6 +75,7 @@ public:
 	int LastTaskInSet(int task_set);
 	int NextTaskInSet(int task_set, int task_id);
 	bool IsTaskRepeatable(int task_id);
+	const std::vector<TaskActivityReference> *GetGoalActivities(int activity_type, int goal_entry) const;
 
 	friend class ClientTaskState;
 
@@ -83,6 +85,12 @@ private:
 	TaskProximityManager m_proximity_manager;
 	TaskInformation      *m_task_data[MAXTASKS]{};
 	std::vector<int>     m_task_sets[MAXTASKSETS];
+
+	// (activity type, goal entry) -> activities with that goal, sorted by task id then activity id.
+	// Deliver and GiveCash activities are both filed under ActivityDeliver by their deliver_to_npc
+	std::unordered_map<uint64, std::vector<TaskActivityReference>> m_goal_activities;
+
+	void BuildGoalActivityIndex();
 	void SendActiveTaskDescription(
 		Client *client,
 		int task_id,
@@ -140,6 +140,22 @@ struct ClientTaskInformation {
 	ClientActivityInformation activity[MAXACTIVITIESPERTASK];
 };
 
+// an activity whose goal names a given npc, item or explore id, see TaskManager::GetGoalActivities
+struct TaskActivityReference {
+	int task_id;
+	int activity_id;
+
+	inline bool operator<(const TaskActivityReference &rhs) const
+	{
+		return task_id < rhs.task_id || (task_id == rhs.task_id && activity_id < rhs.activity_id);
+	}
+
+	inline bool operator==(const TaskActivityReference &rhs) const
+	{
+		return task_id == rhs.task_id && activity_id == rhs.activity_id;
+	}
+};
+
 struct CompletedTaskInformation {
 	int  task_id;
 	int  completed_time;
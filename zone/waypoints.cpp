@@ -674,8 +674,10 @@ void Mob::SendTo(float new_x, float new_y, float new_z) {
 	m_Position.z = new_z;
 	LogAI("Sent To ({}, {}, {})", new_x, new_y, new_z);
 
-	if (flymode == GravityBehavior::Flying)
+	if (flymode == GravityBehavior::Flying) {
+		UpdatePositionTable();
 		return;
+	}
 
 	//fix up pathing Z, this shouldent be needed IF our waypoints
 	//are corrected instead
@@ -696,6 +698,8 @@ void Mob::SendTo(float new_x, float new_y, float new_z) {
 	}
 	else
 		m_Position.z += 0.1;
+
+	UpdatePositionTable();
 }
 
 void Mob::SendToFixZ(float new_x, float new_y, float new_z) {
@@ -722,6 +726,8 @@ void Mob::SendToFixZ(float new_x, float new_y, float new_z) {
 				m_Position.z = newz + 1;
 		}
 	}
+
+	UpdatePositionTable();
 }
 
 float Mob::GetFixedZ(const glm::vec3 &destination, int32 z_find_offset) {
@@ -789,6 +795,7 @@ void Mob::FixZ(int32 z_find_offset /*= 5*/, bool fix_client_z /*= false*/) {
 		}
 
 		m_Position.z = new_z;
+		UpdatePositionTable();
 	}
 	else {
 		if (RuleB(Map, MobZVisualDebug)) {
@@ -1529,19 +1529,10 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 		if (zone)
 		{
 			UpdateSpawnTimer_Struct *ust = (UpdateSpawnTimer_Struct*)pack->pBuffer;
-			LinkedListIterator<Spawn2*> iterator(zone->spawn2_list);
-			iterator.Reset();
-			while (iterator.MoreElements())
+			Spawn2 *found_spawn = zone->spawn2_list.GetByID(ust->id);
+			if (found_spawn && !found_spawn->NPCPointerValid())
 			{
-				if (iterator.GetData()->GetID() == ust->id)
-				{
-					if (!iterator.GetData()->NPCPointerValid())
-					{
-						iterator.GetData()->SetTimer(ust->duration);
-					}
-					break;
-				}
-				iterator.Advance();
+				found_spawn->SetTimer(ust->duration);
 			}
 		}
 		break;
@@ -1593,19 +1584,7 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 		if (zone)
 		{
 			ServerSpawnStatusChange_Struct *ssc = (ServerSpawnStatusChange_Struct*)pack->pBuffer;
-			LinkedListIterator<Spawn2*> iterator(zone->spawn2_list);
-			iterator.Reset();
-			Spawn2 *found_spawn = nullptr;
-			while (iterator.MoreElements())
-			{
-				Spawn2* cur = iterator.GetData();
-				if (cur->GetID() == ssc->id)
-				{
-					found_spawn = cur;
-					break;
-				}
-				iterator.Advance();
-			}
+			Spawn2 *found_spawn = zone->spawn2_list.GetByID(ssc->id);
 
 			if (found_spawn)
 			{
@@ -2856,6 +2835,15 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 			LogError("Loading npcs faction lists failed!");
 		}
 
+		LogInfo("Loading npc types");
+		if (zone) {
+			zone->DetachSharedNPCTypes();
+		}
+
+		if (!content_db.LoadNPCTypes(hotfix_name)) {
+			LogError("Loading npc types failed, npc types will be loaded from the database");
+		}
+
 		LogInfo("Loading loot tables");
 		if (!content_db.LoadLoot(hotfix_name)) {
 			LogError("Loading loot failed!");
@@ -17,6 +17,7 @@
 */
 
 #include <float.h>
+#include <future>
 #include <iostream>
 #include <math.h>
 #include <stdlib.h>
@@ -152,6 +153,7 @@ bool Zone::Bootup(uint32 iZoneID, uint32 iInstanceID, bool iStaticZone) {
 	LogInfo("---- Zone server [{}], listening on port:[{}] ----", zonename, ZoneConfig::get()->ZonePort);
 	LogInfo("Zone Bootup: [{}] ([{}]: [{}])", zonename, iZoneID, iInstanceID);
 	parse->Init();
+	parse->PreloadQuests();
 	UpdateWindowTitle(nullptr);
 	zone->GetTimeSync();
 
@@ -871,6 +873,13 @@ void Zone::Shutdown(bool quiet)
 		zone->merctable.erase(itr);
 	}
 
+	while (!zone->detached_npc_types.empty()) {
+		itr = zone->detached_npc_types.begin();
+		delete itr->second;
+		itr->second = nullptr;
+		zone->detached_npc_types.erase(itr);
+	}
+
 	zone->adventure_entry_list_flavor.clear();
 
 	std::map<uint32, LDoNTrapTemplate *>::iterator itr4;
@@ -941,6 +950,7 @@ Zone::Zone(uint32 in_zoneid, uint32 in_instanceid, const char* in_short_name)
 	spawn2_timer(1000),
 	hot_reload_timer(1000),
 	qglobal_purge_timer(30000),
+	los_cache_purge_timer(10000),
 	hotzone_timer(120000),
 	m_SafePoint(0.0f,0.0f,0.0f),
 	m_Graveyard(0.0f,0.0f,0.0f,0.0f)
@@ -953,6 +963,9 @@ Zone::Zone(uint32 in_zoneid, uint32 in_instanceid, const char* in_short_name)
 	watermap = nullptr;
 	pathing = nullptr;
 	qGlobals = nullptr;
+	m_los_cache_hits = 0;
+	m_los_cache_misses = 0;
+	npc_types_reloaded = false;
 	default_ruleset = 0;
 
 	is_zone_time_localized = false;
@@ -1090,31 +1103,20 @@ bool Zone::Init(bool iStaticZone) {
 		}
 	}
 
-	zone->zonemap  = Map::LoadMapFile(zone->map_name);
-	zone->watermap = WaterMap::LoadWaterMapfile(zone->map_name);
-	zone->pathing  = IPathfinder::Load(zone->map_name);
+	// map, water map and navmesh are pure file parsing, run them on worker threads while the
+	// spawn content is pulled from the database; both are joined before anything is spawned
+	std::string map_name = zone->map_name ? zone->map_name : "";
+	auto zonemap_task    = std::async(std::launch::async, [map_name]() { return Map::LoadMapFile(map_name); });
+	auto watermap_task   = std::async(std::launch::async, [map_name]() { return WaterMap::LoadWaterMapfile(map_name); });
+	auto pathing_task    = std::async(std::launch::async, [map_name]() { return IPathfinder::Load(map_name); });
 
-	LogInfo("Loading spawn conditions");
-	if(!spawn_conditions.LoadSpawnConditions(short_name, instanceid)) {
-		LogError("Loading spawn conditions failed, continuing without them");
-	}
+	bool spawn_content_loaded = LoadSpawnContent();
 
-	LogInfo("Loading static zone points");
-	if (!content_db.LoadStaticZonePoints(&zone_point_list, short_name, GetInstanceVersion())) {
-		LogError("Loading static zone points failed");
-		return false;
-	}
+	zone->zonemap  = zonemap_task.get();
+	zone->watermap = watermap_task.get();
+	zone->pathing  = pathing_task.get();
 
-	LogInfo("Loading spawn groups");
-	if (!content_db.LoadSpawnGroups(short_name, GetInstanceVersion(), &spawn_group_list)) {
-		LogError("Loading spawn groups failed");
-		return false;
-	}
-
-	LogInfo("Loading spawn2 points");
-	if (!content_db.PopulateZoneSpawnList(zoneid, spawn2_list, GetInstanceVersion()))
-	{
-		LogError("Loading spawn2 points failed");
+	if (!spawn_content_loaded) {
 		return false;
 	}
 
@@ -1203,6 +1205,40 @@ bool Zone::Init(bool iStaticZone) {
 	return true;
 }
 
+/**
+ * Database backed spawn data that does not depend on the zone's map assets
+ *
+ * @return
+ */
+bool Zone::LoadSpawnContent()
+{
+	LogInfo("Loading spawn conditions");
+	if(!spawn_conditions.LoadSpawnConditions(short_name, instanceid)) {
+		LogError("Loading spawn conditions failed, continuing without them");
+	}
+
+	LogInfo("Loading static zone points");
+	if (!content_db.LoadStaticZonePoints(&zone_point_list, short_name, GetInstanceVersion())) {
+		LogError("Loading static zone points failed");
+		return false;
+	}
+
+	LogInfo("Loading spawn groups");
+	if (!content_db.LoadSpawnGroups(short_name, GetInstanceVersion(), &spawn_group_list)) {
+		LogError("Loading spawn groups failed");
+		return false;
+	}
+
+	LogInfo("Loading spawn2 points");
+	if (!content_db.PopulateZoneSpawnList(zoneid, spawn2_list, GetInstanceVersion()))
+	{
+		LogError("Loading spawn2 points failed");
+		return false;
+	}
+
+	return true;
+}
+
 void Zone::ReloadStaticData() {
 	LogInfo("Reloading Zone Static Data");
 
@@ -1422,19 +1458,9 @@ bool Zone::Process() {
 
 	if (spawn2_timer.Check()) {
 
-		LinkedListIterator<Spawn2 *> iterator(spawn2_list);
-
 		EQ::InventoryProfile::CleanDirty();
 
-		iterator.Reset();
-		while (iterator.MoreElements()) {
-			if (iterator.GetData()->Process()) {
-				iterator.Advance();
-			}
-			else {
-				iterator.RemoveCurrent();
-			}
-		}
+		spawn2_list.Process();
 
 		if (adv_data && !did_adventure_actions) {
 			DoAdventureActions();
@@ -1469,12 +1495,8 @@ bool Zone::Process() {
 	if(initgrids_timer.Check()) {
 		//delayed grid loading stuff.
 		initgrids_timer.Disable();
-		LinkedListIterator<Spawn2*> iterator(spawn2_list);
-
-		iterator.Reset();
-		while (iterator.MoreElements()) {
-			iterator.GetData()->LoadGrid();
-			iterator.Advance();
+		for (auto spawn : spawn2_list) {
+			spawn->LoadGrid();
 		}
 	}
 
@@ -1584,6 +1606,19 @@ bool Zone::Process() {
 
 	if(hotzone_timer.Check()) { UpdateHotzone(); }
 
+	if (los_cache_purge_timer.Check()) {
+		//drop pairs nobody asked about since the last purge, entity ids get reused
+		uint32 now = Timer::GetCurrentTime();
+		for (auto iter = m_los_cache.begin(); iter != m_los_cache.end();) {
+			if (now - iter->second.last_used > los_cache_purge_timer.GetDuration()) {
+				iter = m_los_cache.erase(iter);
+			}
+			else {
+				++iter;
+			}
+		}
+	}
+
 	mMovementManager->Process();
 
 	return true;
@@ -1750,6 +1785,7 @@ bool Zone::Depop(bool StartSpawnTimer) {
 
 void Zone::ClearNPCTypeCache(int id) {
 	if (id <= 0) {
+		npc_types_reloaded = true;
 		auto iter = npctable.begin();
 		while (iter != npctable.end()) {
 			delete iter->second;
@@ -1759,6 +1795,7 @@ void Zone::ClearNPCTypeCache(int id) {
 		npctable.clear();
 	}
 	else {
+		reloaded_npc_types.insert((uint32)id);
 		auto iter = npctable.begin();
 		while (iter != npctable.end()) {
 			if (iter->first == (uint32)id) {
@@ -1772,18 +1809,41 @@ void Zone::ClearNPCTypeCache(int id) {
 	}
 }
 
+/**
+ * Moves every live npc whose type is served from the shared memory segment onto a private copy so
+ * the segment can be unmapped for a hotfix, then forgets which types were reloaded since the new
+ * segment is built from the current database
+ */
+void Zone::DetachSharedNPCTypes()
+{
+	for (auto &e : entity_list.GetNPCList()) {
+		NPC           *npc      = e.second;
+		const NPCType *npc_type = npc->GetNPCTypeData();
+		if (!content_db.IsSharedNPCType(npc_type)) {
+			continue;
+		}
+
+		auto iter = detached_npc_types.find(npc_type->npc_id);
+		if (iter == detached_npc_types.end()) {
+			auto copy = new NPCType;
+			memcpy(copy, npc_type, sizeof(NPCType));
+			iter = detached_npc_types.emplace(npc_type->npc_id, copy).first;
+		}
+
+		npc->SetNPCTypeData(iter->second);
+	}
+
+	npc_types_reloaded = false;
+	reloaded_npc_types.clear();
+}
+
 void Zone::Repop(uint32 delay)
 {
 	if (!Depop()) {
 		return;
 	}
 
-	LinkedListIterator<Spawn2 *> iterator(spawn2_list);
-
-	iterator.Reset();
-	while (iterator.MoreElements()) {
-		iterator.RemoveCurrent();
-	}
+	spawn2_list.Clear();
 
 	npc_scale_manager->LoadScaleData();
 
@@ -2038,41 +2098,33 @@ bool ZoneDatabase::LoadStaticZonePoints(LinkedList<ZonePoint *> *zone_point_list
 }
 
 void Zone::SpawnStatus(Mob* client) {
-	LinkedListIterator<Spawn2*> iterator(spawn2_list);
-
 	uint32 x = 0;
-	iterator.Reset();
-	while(iterator.MoreElements())
+	for (auto spawn : spawn2_list)
 	{
-		if (iterator.GetData()->timer.GetRemainingTime() == 0xFFFFFFFF)
-			client->Message(Chat::White, "  %d: %1.1f, %1.1f, %1.1f: disabled", iterator.GetData()->GetID(), iterator.GetData()->GetX(), iterator.GetData()->GetY(), iterator.GetData()->GetZ());
+		if (spawn->timer.GetRemainingTime() == 0xFFFFFFFF)
+			client->Message(Chat::White, "  %d: %1.1f, %1.1f, %1.1f: disabled", spawn->GetID(), spawn->GetX(), spawn->GetY(), spawn->GetZ());
 		else
-			client->Message(Chat::White, "  %d: %1.1f, %1.1f, %1.1f: %1.2f", iterator.GetData()->GetID(), iterator.GetData()->GetX(), iterator.GetData()->GetY(), iterator.GetData()->GetZ(), (float)iterator.GetData()->timer.GetRemainingTime() / 1000);
+			client->Message(Chat::White, "  %d: %1.1f, %1.1f, %1.1f: %1.2f", spawn->GetID(), spawn->GetX(), spawn->GetY(), spawn->GetZ(), (float)spawn->timer.GetRemainingTime() / 1000);
 
 		x++;
-		iterator.Advance();
 	}
 	client->Message(Chat::White, "%i spawns listed.", x);
 }
 
 void Zone::ShowEnabledSpawnStatus(Mob* client)
 {
-	LinkedListIterator<Spawn2*> iterator(spawn2_list);
 	int x = 0;
 	int iEnabledCount = 0;
 
-	iterator.Reset();
-
-	while(iterator.MoreElements())
+	for (auto spawn : spawn2_list)
 	{
-		if (iterator.GetData()->timer.GetRemainingTime() != 0xFFFFFFFF)
+		if (spawn->timer.GetRemainingTime() != 0xFFFFFFFF)
 		{
-			client->Message(Chat::White, "  %d: %1.1f, %1.1f, %1.1f: %1.2f", iterator.GetData()->GetID(), iterator.GetData()->GetX(), iterator.GetData()->GetY(), iterator.GetData()->GetZ(), (float)iterator.GetData()->timer.GetRemainingTime() / 1000);
+			client->Message(Chat::White, "  %d: %1.1f, %1.1f, %1.1f: %1.2f", spawn->GetID(), spawn->GetX(), spawn->GetY(), spawn->GetZ(), (float)spawn->timer.GetRemainingTime() / 1000);
 			iEnabledCount++;
 		}
 
 		x++;
-		iterator.Advance();
 	}
 
 	client->Message(Chat::White, "%i of %i spawns listed.", iEnabledCount, x);
@@ -2080,22 +2132,18 @@ void Zone::ShowEnabledSpawnStatus(Mob* client)
 
 void Zone::ShowDisabledSpawnStatus(Mob* client)
 {
-	LinkedListIterator<Spawn2*> iterator(spawn2_list);
 	int x = 0;
 	int iDisabledCount = 0;
 
-	iterator.Reset();
-
-	while(iterator.MoreElements())
+	for (auto spawn : spawn2_list)
 	{
-		if (iterator.GetData()->timer.GetRemainingTime() == 0xFFFFFFFF)
+		if (spawn->timer.GetRemainingTime() == 0xFFFFFFFF)
 		{
-			client->Message(Chat::White, "  %d: %1.1f, %1.1f, %1.1f: disabled", iterator.GetData()->GetID(), iterator.GetData()->GetX(), iterator.GetData()->GetY(), iterator.GetData()->GetZ());
+			client->Message(Chat::White, "  %d: %1.1f, %1.1f, %1.1f: disabled", spawn->GetID(), spawn->GetX(), spawn->GetY(), spawn->GetZ());
 			iDisabledCount++;
 		}
 
 		x++;
-		iterator.Advance();
 	}
 
 	client->Message(Chat::White, "%i of %i spawns listed.", iDisabledCount, x);
@@ -2103,20 +2151,17 @@ void Zone::ShowDisabledSpawnStatus(Mob* client)
 
 void Zone::ShowSpawnStatusByID(Mob* client, uint32 spawnid)
 {
-	LinkedListIterator<Spawn2*> iterator(spawn2_list);
 	int x = 0;
 	int iSpawnIDCount = 0;
 
-	iterator.Reset();
-
-	while(iterator.MoreElements())
+	for (auto spawn : spawn2_list)
 	{
-		if (iterator.GetData()->GetID() == spawnid)
+		if (spawn->GetID() == spawnid)
 		{
-			if (iterator.GetData()->timer.GetRemainingTime() == 0xFFFFFFFF)
-				client->Message(Chat::White, "  %d: %1.1f, %1.1f, %1.1f: disabled", iterator.GetData()->GetID(), iterator.GetData()->GetX(), iterator.GetData()->GetY(), iterator.GetData()->GetZ());
+			if (spawn->timer.GetRemainingTime() == 0xFFFFFFFF)
+				client->Message(Chat::White, "  %d: %1.1f, %1.1f, %1.1f: disabled", spawn->GetID(), spawn->GetX(), spawn->GetY(), spawn->GetZ());
 			else
-				client->Message(Chat::White, "  %d: %1.1f, %1.1f, %1.1f: %1.2f", iterator.GetData()->GetID(), iterator.GetData()->GetX(), iterator.GetData()->GetY(), iterator.GetData()->GetZ(), (float)iterator.GetData()->timer.GetRemainingTime() / 1000);
+				client->Message(Chat::White, "  %d: %1.1f, %1.1f, %1.1f: %1.2f", spawn->GetID(), spawn->GetX(), spawn->GetY(), spawn->GetZ(), (float)spawn->timer.GetRemainingTime() / 1000);
 
 			iSpawnIDCount++;
 
@@ -2124,7 +2169,6 @@ void Zone::ShowSpawnStatusByID(Mob* client, uint32 spawnid)
 		}
 
 		x++;
-		iterator.Advance();
 	}
 
 	if(iSpawnIDCount > 0)
@@ -2588,16 +2632,10 @@ void Zone::LoadTickItems()
 }
 
 uint32 Zone::GetSpawnKillCount(uint32 in_spawnid) {
-	LinkedListIterator<Spawn2*> iterator(spawn2_list);
-
-	iterator.Reset();
-	while(iterator.MoreElements())
+	Spawn2 *spawn = spawn2_list.GetByID(in_spawnid);
+	if (spawn)
 	{
-		if(iterator.GetData()->GetID() == in_spawnid)
-		{
-			return(iterator.GetData()->killcount);
-		}
-		iterator.Advance();
+		return(spawn->killcount);
 	}
 	return 0;
 }
@@ -2617,6 +2655,41 @@ void Zone::UpdateHotzone()
     is_hotzone = atoi(row[0]) == 0 ? false: true;
 }
 
+bool Zone::CheckLoS(uint16 watcher_id, uint16 target_id, const glm::vec3 &from, const glm::vec3 &to)
+{
+	if (!RuleB(Map, LosCache) || watcher_id == 0 || target_id == 0) {
+		return zonemap->CheckLoS(from, to);
+	}
+
+	uint32 key = (static_cast<uint32>(watcher_id) << 16) | target_id;
+	float granularity = RuleR(Map, LosCacheGranularity);
+
+	auto unmoved = [granularity](const glm::vec3 &a, const glm::vec3 &b) {
+		return std::abs(a.x - b.x) <= granularity && std::abs(a.y - b.y) <= granularity && std::abs(a.z - b.z) <= granularity;
+	};
+
+	auto iter = m_los_cache.find(key);
+	if (iter != m_los_cache.end()) {
+		auto &entry = iter->second;
+		if (unmoved(entry.from, from) && unmoved(entry.to, to)) {
+			entry.last_used = Timer::GetCurrentTime();
+			++m_los_cache_hits;
+			return entry.result;
+		}
+	}
+
+	++m_los_cache_misses;
+
+	LosCacheEntry entry;
+	entry.from = from;
+	entry.to = to;
+	entry.last_used = Timer::GetCurrentTime();
+	entry.result = zonemap->CheckLoS(from, to);
+	m_los_cache[key] = entry;
+
+	return entry.result;
+}
+
 void Zone::RequestUCSServerStatus() {
 	auto outapp = new ServerPacket(ServerOP_UCSServerStatusRequest, sizeof(UCSServerStatus_Struct));
 	auto ucsss = (UCSServerStatus_Struct*)outapp->pBuffer;
@@ -33,10 +33,13 @@
 #include "spawn2.h"
 #include "spawngroup.h"
 #include "aa_ability.h"
+#include "bazaar_index.h"
 #include "dynamiczone.h"
 #include "pathfinder_interface.h"
 #include "global_loot_manager.h"
 
+#include <set>
+
 struct ZonePoint {
 	float  x;
 	float  y;
@@ -133,6 +136,7 @@ public:
 	bool IsUCSServerAvailable() { return m_ucss_available; }
 	bool IsZone(uint32 zone_id, uint16 instance_id) const;
 	bool LoadGroundSpawns();
+	bool LoadSpawnContent();
 	bool LoadZoneCFG(const char *filename, uint16 instance_id);
 	bool LoadZoneObjects();
 	bool Process();
@@ -150,11 +154,18 @@ public:
 
 	ZonePoint *GetClosestZonePoint(const glm::vec3 &location, const char *to_name, Client *client, float max_distance = 40000.0f);
 
+	bool CheckLoS(uint16 watcher_id, uint16 target_id, const glm::vec3 &from, const glm::vec3 &to);
+
 	inline bool BuffTimersSuspended() const { return newzone_data.SuspendBuffs != 0; };
 	inline bool HasMap() { return zonemap != nullptr; }
+	inline uint64 GetLosCacheHits() const { return m_los_cache_hits; }
+	inline uint64 GetLosCacheMisses() const { return m_los_cache_misses; }
+	inline size_t GetLosCacheSize() const { return m_los_cache.size(); }
 	inline bool HasWaterMap() { return watermap != nullptr; }
 	inline bool InstantGrids() { return (!initgrids_timer.Enabled()); }
 	inline bool IsStaticZone() { return staticzone; }
+	inline bool IsNPCTypeReloaded(uint32 npc_type_id) const { return npc_types_reloaded || reloaded_npc_types.count(npc_type_id); }
+	inline void MarkNPCTypeReloaded(uint32 npc_type_id) { reloaded_npc_types.insert(npc_type_id); }
 	inline const bool IsInstancePersistent() const { return pers_instance; }
 	inline const char *GetFileName() { return file_name; }
 	inline const char *GetLongName() { return long_name; }
@@ -182,7 +193,7 @@ public:
 
 	IPathfinder                                   *pathing;
 	LinkedList<NPC_Emote_Struct *>                NPCEmoteList;
-	LinkedList<Spawn2 *>                          spawn2_list;
+	Spawn2List                                    spawn2_list;
 	LinkedList<ZonePoint *>                       zone_point_list;
 	std::vector<ZonePointsRepository::ZonePoints> virtual_zone_point_list;
 
@@ -197,6 +208,7 @@ public:
 	QGlobalCache *GetQGlobals() { return qGlobals; }
 	SpawnConditionManager          spawn_conditions;
 	SpawnGroupList                 spawn_group_list;
+	BazaarIndex                    bazaar_index;
 
 	std::list<AltCurrencyDefinition_Struct>               AlternateCurrencies;
 	std::list<InternalVeteranReward>                      VeteranRewards;
@@ -244,6 +256,7 @@ public:
 	void ChangeWeather();
 	void ClearBlockedSpells();
 	void ClearNPCTypeCache(int id);
+	void DetachSharedNPCTypes();
 	void CalculateNpcUpdateDistanceSpread();
 	void DelAggroMob() { aggroedmobs--; }
 	void DeleteQGlobal(std::string name, uint32 npcID, uint32 charID, uint32 zoneID);
@@ -370,6 +383,7 @@ private:
 	bool      staticzone;
 	bool      zone_has_current_time;
 	bool      quest_hot_reload_queued;
+	bool      npc_types_reloaded;
 	double    max_movement_update_range;
 	char      *long_name;
 	char      *map_name;
@@ -403,8 +417,28 @@ private:
 	Timer                               hotzone_timer;
 	Timer                               initgrids_timer;
 	Timer                               qglobal_purge_timer;
+	Timer                               los_cache_purge_timer;
 	ZoneSpellsBlocked                   *blocked_spells;
 
+	// last line of sight result per watcher/target pair, the map is static so a result holds
+	// for as long as neither eye point moves
+	struct LosCacheEntry {
+		glm::vec3 from;
+		glm::vec3 to;
+		uint32    last_used;
+		bool      result;
+	};
+
+	std::unordered_map<uint32, LosCacheEntry> m_los_cache;
+	uint64                                    m_los_cache_hits;
+	uint64                                    m_los_cache_misses;
+
+	// npc types edited or cleared from the cache since the shared memory segment was mapped, these
+	// skip the segment until a hotfix maps one built from the current database
+	std::set<uint32> reloaded_npc_types;
+
+	// copies of the types live npcs held in the previous segment, kept until the zone shuts down
+	std::map<uint32, NPCType *> detached_npc_types;
 };
 
 #endif
@@ -848,8 +848,13 @@ void ZoneDatabase::SaveTraderItem(uint32 CharID, uint32 ItemID, uint32 SerialNum
 	std::string query = StringFormat("REPLACE INTO trader VALUES(%i, %i, %i, %i, %i, %i)",
                                     CharID, ItemID, SerialNumber, Charges, ItemCost, Slot);
     auto results = QueryDatabase(query);
-    if (!results.Success())
+    if (!results.Success()) {
         LogDebug("[CLIENT] Failed to save trader item: [{}] for char_id: [{}], the error was: [{}]\n", ItemID, CharID, results.ErrorMessage().c_str());
+        return;
+    }
+
+    if (zone)
+        zone->bazaar_index.AddListing(CharID, ItemID, SerialNumber, Charges, ItemCost, Slot);
 
 }
 
@@ -859,8 +864,13 @@ void ZoneDatabase::UpdateTraderItemCharges(int CharID, uint32 SerialNumber, int3
 	std::string query = StringFormat("UPDATE trader SET charges = %i WHERE char_id = %i AND serialnumber = %i",
                                     Charges, CharID, SerialNumber);
     auto results = QueryDatabase(query);
-    if (!results.Success())
+    if (!results.Success()) {
 		LogDebug("[CLIENT] Failed to update charges for trader item: [{}] for char_id: [{}], the error was: [{}]\n", SerialNumber, CharID, results.ErrorMessage().c_str());
+		return;
+	}
+
+	if (zone)
+		zone->bazaar_index.UpdateCharges(CharID, SerialNumber, Charges);
 
 }
 
@@ -878,8 +888,13 @@ void ZoneDatabase::UpdateTraderItemPrice(int CharID, uint32 ItemID, uint32 Charg
 
         std::string query = StringFormat("DELETE FROM trader WHERE char_id = %i AND item_id = %i",CharID, ItemID);
         auto results = QueryDatabase(query);
-        if (!results.Success())
+        if (!results.Success()) {
 			LogDebug("[CLIENT] Failed to remove trader item(s): [{}] for char_id: [{}], the error was: [{}]\n", ItemID, CharID, results.ErrorMessage().c_str());
+			return;
+		}
+
+		if (zone)
+			zone->bazaar_index.RemoveItem(CharID, ItemID);
 
 		return;
 	}
@@ -889,8 +904,13 @@ void ZoneDatabase::UpdateTraderItemPrice(int CharID, uint32 ItemID, uint32 Charg
                                         "WHERE char_id = %i AND item_id = %i AND charges=%i",
                                         NewPrice, CharID, ItemID, Charges);
         auto results = QueryDatabase(query);
-        if (!results.Success())
+        if (!results.Success()) {
             LogDebug("[CLIENT] Failed to update price for trader item: [{}] for char_id: [{}], the error was: [{}]\n", ItemID, CharID, results.ErrorMessage().c_str());
+            return;
+        }
+
+        if (zone)
+            zone->bazaar_index.UpdatePrice(CharID, ItemID, Charges, true, NewPrice);
 
         return;
     }
@@ -899,8 +919,13 @@ void ZoneDatabase::UpdateTraderItemPrice(int CharID, uint32 ItemID, uint32 Charg
                                     "WHERE char_id = %i AND item_id = %i",
                                     NewPrice, CharID, ItemID);
     auto results = QueryDatabase(query);
-    if (!results.Success())
+    if (!results.Success()) {
             LogDebug("[CLIENT] Failed to update price for trader item: [{}] for char_id: [{}], the error was: [{}]\n", ItemID, CharID, results.ErrorMessage().c_str());
+            return;
+    }
+
+    if (zone)
+        zone->bazaar_index.UpdatePrice(CharID, ItemID, 0, false, NewPrice);
 }
 
 void ZoneDatabase::DeleteTraderItem(uint32 char_id){
@@ -910,6 +935,8 @@ void ZoneDatabase::DeleteTraderItem(uint32 char_id){
         auto results = QueryDatabase(query);
 		if (!results.Success())
 			LogDebug("[CLIENT] Failed to delete all trader items data, the error was: [{}]\n", results.ErrorMessage().c_str());
+		else if (zone)
+			zone->bazaar_index.Clear();
 
         return;
 	}
@@ -918,6 +945,8 @@ void ZoneDatabase::DeleteTraderItem(uint32 char_id){
 	auto results = QueryDatabase(query);
     if (!results.Success())
         LogDebug("[CLIENT] Failed to delete trader item data for char_id: [{}], the error was: [{}]\n", char_id, results.ErrorMessage().c_str());
+    else if (zone)
+        zone->bazaar_index.RemoveTrader(char_id);
 
 }
 void ZoneDatabase::DeleteTraderItem(uint32 CharID,uint16 SlotID) {
@@ -926,6 +955,8 @@ void ZoneDatabase::DeleteTraderItem(uint32 CharID,uint16 SlotID) {
 	auto results = QueryDatabase(query);
 	if (!results.Success())
 		LogDebug("[CLIENT] Failed to delete trader item data for char_id: [{}], the error was: [{}]\n",CharID, results.ErrorMessage().c_str());
+	else if (zone)
+		zone->bazaar_index.RemoveListing(CharID, (uint8) SlotID);
 }
 
 void ZoneDatabase::DeleteBuyLines(uint32 CharID) {
@@ -2349,6 +2380,18 @@ const NPCType *ZoneDatabase::LoadNPCTypesData(uint32 npc_type_id, bool bulk_load
 		return itr->second;
 	}
 
+	/* Served read-only from the shared memory segment when one is mapped, unless the type was reloaded since it was mapped */
+	if (npc_types_hash && RuleB(Zone, UseSharedMemoryNPCTypes) && !zone->IsNPCTypeReloaded(npc_type_id)) {
+		if (bulk_load) {
+			return nullptr;
+		}
+
+		npc = GetNPCType(npc_type_id);
+		if (npc) {
+			return npc;
+		}
+	}
+
 	std::string where_condition = "";
 
 	if (bulk_load) {
@@ -2364,125 +2407,7 @@ const NPCType *ZoneDatabase::LoadNPCTypesData(uint32 npc_type_id, bool bulk_load
 		where_condition = StringFormat("WHERE id = %u", npc_type_id);
 	}
 
-	std::string query = StringFormat(
-		"SELECT "
-		"npc_types.id, "
-		"npc_types.name, "
-		"npc_types.level, "
-		"npc_types.race, "
-		"npc_types.class, "
-		"npc_types.hp, "
-		"npc_types.mana, "
-		"npc_types.gender, "
-		"npc_types.texture, "
-		"npc_types.helmtexture, "
-		"npc_types.herosforgemodel, "
-		"npc_types.size, "
-		"npc_types.loottable_id, "
-		"npc_types.merchant_id, "
-		"npc_types.alt_currency_id, "
-		"npc_types.adventure_template_id, "
-		"npc_types.trap_template, "
-		"npc_types.attack_speed, "
-		"npc_types.STR, "
-		"npc_types.STA, "
-		"npc_types.DEX, "
-		"npc_types.AGI, "
-		"npc_types._INT, "
-		"npc_types.WIS, "
-		"npc_types.CHA, "
-		"npc_types.MR, "
-		"npc_types.CR, "
-		"npc_types.DR, "
-		"npc_types.FR, "
-		"npc_types.PR, "
-		"npc_types.Corrup, "
-		"npc_types.PhR, "
-		"npc_types.mindmg, "
-		"npc_types.maxdmg, "
-		"npc_types.attack_count, "
-		"npc_types.special_abilities, "
-		"npc_types.npc_spells_id, "
-		"npc_types.npc_spells_effects_id, "
-		"npc_types.d_melee_texture1, "
-		"npc_types.d_melee_texture2, "
-		"npc_types.ammo_idfile, "
-		"npc_types.prim_melee_type, "
-		"npc_types.sec_melee_type, "
-		"npc_types.ranged_type, "
-		"npc_types.runspeed, "
-		"npc_types.findable, "
-		"npc_types.trackable, "
-		"npc_types.hp_regen_rate, "
-		"npc_types.mana_regen_rate, "
-		"npc_types.aggroradius, "
-		"npc_types.assistradius, "
-		"npc_types.bodytype, "
-		"npc_types.npc_faction_id, "
-		"npc_types.face, "
-		"npc_types.luclin_hairstyle, "
-		"npc_types.luclin_haircolor, "
-		"npc_types.luclin_eyecolor, "
-		"npc_types.luclin_eyecolor2, "
-		"npc_types.luclin_beardcolor, "
-		"npc_types.luclin_beard, "
-		"npc_types.drakkin_heritage, "
-		"npc_types.drakkin_tattoo, "
-		"npc_types.drakkin_details, "
-		"npc_types.armortint_id, "
-		"npc_types.armortint_red, "
-		"npc_types.armortint_green, "
-		"npc_types.armortint_blue, "
-		"npc_types.see_invis, "
-		"npc_types.see_invis_undead, "
-		"npc_types.lastname, "
-		"npc_types.qglobal, "
-		"npc_types.AC, "
-		"npc_types.npc_aggro, "
-		"npc_types.spawn_limit, "
-		"npc_types.see_hide, "
-		"npc_types.see_improved_hide, "
-		"npc_types.ATK, "
-		"npc_types.Accuracy, "
-		"npc_types.Avoidance, "
-		"npc_types.slow_mitigation, "
-		"npc_types.maxlevel, "
-		"npc_types.scalerate, "
-		"npc_types.private_corpse, "
-		"npc_types.unique_spawn_by_name, "
-		"npc_types.underwater, "
-		"npc_types.emoteid, "
-		"npc_types.spellscale, "
-		"npc_types.healscale, "
-		"npc_types.no_target_hotkey, "
-		"npc_types.raid_target, "
-		"npc_types.attack_delay, "
-		"npc_types.light, "
-		"npc_types.armtexture, "
-		"npc_types.bracertexture, "
-		"npc_types.handtexture, "
-		"npc_types.legtexture, "
-		"npc_types.feettexture, "
-		"npc_types.ignore_despawn, "
-		"npc_types.show_name, "
-		"npc_types.untargetable, "
-		"npc_types.charm_ac, "
-		"npc_types.charm_min_dmg, "
-		"npc_types.charm_max_dmg, "
-		"npc_types.charm_attack_delay, "
-		"npc_types.charm_accuracy_rating, "
-		"npc_types.charm_avoidance_rating, "
-		"npc_types.charm_atk, "
-		"npc_types.skip_global_loot, "
-		"npc_types.rare_spawn, "
-		"npc_types.stuck_behavior, "
-		"npc_types.model, "
-		"npc_types.flymode, "
-		"npc_types.always_aggro, "
-		"npc_types.exp_mod "
-		"FROM npc_types %s",
-		where_condition.c_str()
-	);
+	std::string query = GetNPCTypesQuery(where_condition);
 
 	auto results = QueryDatabase(query);
 	if (!results.Success()) {
@@ -2494,197 +2419,7 @@ const NPCType *ZoneDatabase::LoadNPCTypesData(uint32 npc_type_id, bool bulk_load
 		temp_npctype_data = new NPCType;
 		memset(temp_npctype_data, 0, sizeof *temp_npctype_data);
 
-		temp_npctype_data->npc_id = atoi(row[0]);
-
-		strn0cpy(temp_npctype_data->name, row[1], 50);
-
-		temp_npctype_data->level              = atoi(row[2]);
-		temp_npctype_data->race               = atoi(row[3]);
-		temp_npctype_data->class_             = atoi(row[4]);
-		temp_npctype_data->max_hp             = atoi(row[5]);
-		temp_npctype_data->current_hp         = temp_npctype_data->max_hp;
-		temp_npctype_data->Mana               = atoi(row[6]);
-		temp_npctype_data->gender             = atoi(row[7]);
-		temp_npctype_data->texture            = atoi(row[8]);
-		temp_npctype_data->helmtexture        = atoi(row[9]);
-		temp_npctype_data->herosforgemodel    = atoul(row[10]);
-		temp_npctype_data->size               = atof(row[11]);
-		temp_npctype_data->loottable_id       = atoi(row[12]);
-		temp_npctype_data->merchanttype       = atoi(row[13]);
-		temp_npctype_data->alt_currency_type  = atoi(row[14]);
-		temp_npctype_data->adventure_template = atoi(row[15]);
-		temp_npctype_data->trap_template      = atoi(row[16]);
-		temp_npctype_data->attack_speed       = atof(row[17]);
-		temp_npctype_data->STR                = atoi(row[18]);
-		temp_npctype_data->STA                = atoi(row[19]);
-		temp_npctype_data->DEX                = atoi(row[20]);
-		temp_npctype_data->AGI                = atoi(row[21]);
-		temp_npctype_data->INT                = atoi(row[22]);
-		temp_npctype_data->WIS                = atoi(row[23]);
-		temp_npctype_data->CHA                = atoi(row[24]);
-		temp_npctype_data->MR                 = atoi(row[25]);
-		temp_npctype_data->CR                 = atoi(row[26]);
-		temp_npctype_data->DR                 = atoi(row[27]);
-		temp_npctype_data->FR                 = atoi(row[28]);
-		temp_npctype_data->PR                 = atoi(row[29]);
-		temp_npctype_data->Corrup             = atoi(row[30]);
-		temp_npctype_data->PhR                = atoi(row[31]);
-		temp_npctype_data->min_dmg            = atoi(row[32]);
-		temp_npctype_data->max_dmg            = atoi(row[33]);
-		temp_npctype_data->attack_count       = atoi(row[34]);
-
-		if (row[35] != nullptr) {
-			strn0cpy(temp_npctype_data->special_abilities, row[35], 512);
-		}
-		else {
-			temp_npctype_data->special_abilities[0] = '\0';
-		}
-
-		temp_npctype_data->npc_spells_id         = atoi(row[36]);
-		temp_npctype_data->npc_spells_effects_id = atoi(row[37]);
-		temp_npctype_data->d_melee_texture1      = atoi(row[38]);
-		temp_npctype_data->d_melee_texture2      = atoi(row[39]);
-		strn0cpy(temp_npctype_data->ammo_idfile, row[40], 30);
-		temp_npctype_data->prim_melee_type = atoi(row[41]);
-		temp_npctype_data->sec_melee_type  = atoi(row[42]);
-		temp_npctype_data->ranged_type     = atoi(row[43]);
-		temp_npctype_data->runspeed        = atof(row[44]);
-		temp_npctype_data->findable        = atoi(row[45]) == 0 ? false : true;
-		temp_npctype_data->trackable       = atoi(row[46]) == 0 ? false : true;
-		temp_npctype_data->hp_regen        = atoi(row[47]);
-		temp_npctype_data->mana_regen      = atoi(row[48]);
-
-		// set default value for aggroradius
-		temp_npctype_data->aggroradius = (int32) atoi(row[49]);
-		if (temp_npctype_data->aggroradius <= 0) {
-			temp_npctype_data->aggroradius = 70;
-		}
-
-		temp_npctype_data->assistradius = (int32) atoi(row[50]);
-		if (temp_npctype_data->assistradius <= 0) {
-			temp_npctype_data->assistradius = temp_npctype_data->aggroradius;
-		}
-
-		if (row[51] && strlen(row[51])) {
-			temp_npctype_data->bodytype = (uint8) atoi(row[51]);
-		}
-		else {
-			temp_npctype_data->bodytype = 0;
-		}
-
-		temp_npctype_data->npc_faction_id = atoi(row[52]);
-
-		temp_npctype_data->luclinface       = atoi(row[53]);
-		temp_npctype_data->hairstyle        = atoi(row[54]);
-		temp_npctype_data->haircolor        = atoi(row[55]);
-		temp_npctype_data->eyecolor1        = atoi(row[56]);
-		temp_npctype_data->eyecolor2        = atoi(row[57]);
-		temp_npctype_data->beardcolor       = atoi(row[58]);
-		temp_npctype_data->beard            = atoi(row[59]);
-		temp_npctype_data->drakkin_heritage = atoi(row[60]);
-		temp_npctype_data->drakkin_tattoo   = atoi(row[61]);
-		temp_npctype_data->drakkin_details  = atoi(row[62]);
-
-		uint32 armor_tint_id = atoi(row[63]);
-
-		temp_npctype_data->armor_tint.Head.Color = (atoi(row[64]) & 0xFF) << 16;
-		temp_npctype_data->armor_tint.Head.Color |= (atoi(row[65]) & 0xFF) << 8;
-		temp_npctype_data->armor_tint.Head.Color |= (atoi(row[66]) & 0xFF);
-		temp_npctype_data->armor_tint.Head.Color |= (temp_npctype_data->armor_tint.Head.Color) ? (0xFF << 24) : 0;
-
-		if (armor_tint_id != 0) {
-			std::string armortint_query   = StringFormat(
-				"SELECT red1h, grn1h, blu1h, "
-				"red2c, grn2c, blu2c, "
-				"red3a, grn3a, blu3a, "
-				"red4b, grn4b, blu4b, "
-				"red5g, grn5g, blu5g, "
-				"red6l, grn6l, blu6l, "
-				"red7f, grn7f, blu7f, "
-				"red8x, grn8x, blu8x, "
-				"red9x, grn9x, blu9x "
-				"FROM npc_types_tint WHERE id = %d",
-				armor_tint_id
-			);
-			auto        armortint_results = QueryDatabase(armortint_query);
-			if (!armortint_results.Success() || armortint_results.RowCount() == 0) {
-				armor_tint_id = 0;
-			}
-			else {
-				auto armorTint_row = armortint_results.begin();
-
-				for (int index = EQ::textures::textureBegin; index <= EQ::textures::LastTexture; index++) {
-					temp_npctype_data->armor_tint.Slot[index].Color = atoi(armorTint_row[index * 3]) << 16;
-					temp_npctype_data->armor_tint.Slot[index].Color |= atoi(armorTint_row[index * 3 + 1]) << 8;
-					temp_npctype_data->armor_tint.Slot[index].Color |= atoi(armorTint_row[index * 3 + 2]);
-					temp_npctype_data->armor_tint.Slot[index].Color |= (temp_npctype_data->armor_tint.Slot[index].Color)
-						? (0xFF << 24) : 0;
-				}
-			}
-		}
-		// Try loading npc_types tint fields if armor tint is 0 or query failed to get results
-		if (armor_tint_id == 0) {
-			for (int index = EQ::textures::armorChest; index < EQ::textures::materialCount; index++) {
-				temp_npctype_data->armor_tint.Slot[index].Color = temp_npctype_data->armor_tint.Slot[0].Color; // odd way to 'zero-out' the array...
-			}
-		}
-
-		temp_npctype_data->see_invis        = atoi(row[67]);
-		temp_npctype_data->see_invis_undead = atoi(row[68]) == 0 ? false : true;    // Set see_invis_undead flag
-
-		if (row[69] != nullptr) {
-			strn0cpy(temp_npctype_data->lastname, row[69], 32);
-		}
-
-		temp_npctype_data->qglobal              = atoi(row[70]) == 0 ? false : true;    // qglobal
-		temp_npctype_data->AC                   = atoi(row[71]);
-		temp_npctype_data->npc_aggro            = atoi(row[72]) == 0 ? false : true;
-		temp_npctype_data->spawn_limit          = atoi(row[73]);
-		temp_npctype_data->see_hide             = atoi(row[74]) == 0 ? false : true;
-		temp_npctype_data->see_improved_hide    = atoi(row[75]) == 0 ? false : true;
-		temp_npctype_data->ATK                  = atoi(row[76]);
-		temp_npctype_data->accuracy_rating      = atoi(row[77]);
-		temp_npctype_data->avoidance_rating     = atoi(row[78]);
-		temp_npctype_data->slow_mitigation      = atoi(row[79]);
-		temp_npctype_data->maxlevel             = atoi(row[80]);
-		temp_npctype_data->scalerate            = atoi(row[81]);
-		temp_npctype_data->private_corpse       = atoi(row[82]) == 1 ? true : false;
-		temp_npctype_data->unique_spawn_by_name = atoi(row[83]) == 1 ? true : false;
-		temp_npctype_data->underwater           = atoi(row[84]) == 1 ? true : false;
-		temp_npctype_data->emoteid              = atoi(row[85]);
-		temp_npctype_data->spellscale           = atoi(row[86]);
-		temp_npctype_data->healscale            = atoi(row[87]);
-		temp_npctype_data->no_target_hotkey     = atoi(row[88]) == 1 ? true : false;
-		temp_npctype_data->raid_target          = atoi(row[89]) == 0 ? false : true;
-		temp_npctype_data->attack_delay         = atoi(row[90]) * 100; // TODO: fix DB
-		temp_npctype_data->light                = (atoi(row[91]) & 0x0F);
-
-		temp_npctype_data->armtexture     = atoi(row[92]);
-		temp_npctype_data->bracertexture  = atoi(row[93]);
-		temp_npctype_data->handtexture    = atoi(row[94]);
-		temp_npctype_data->legtexture     = atoi(row[95]);
-		temp_npctype_data->feettexture    = atoi(row[96]);
-		temp_npctype_data->ignore_despawn = atoi(row[97]) == 1 ? true : false;
-		temp_npctype_data->show_name      = atoi(row[98]) != 0 ? true : false;
-		temp_npctype_data->untargetable   = atoi(row[99]) != 0 ? true : false;
-
-		temp_npctype_data->charm_ac               = atoi(row[100]);
-		temp_npctype_data->charm_min_dmg          = atoi(row[101]);
-		temp_npctype_data->charm_max_dmg          = atoi(row[102]);
-		temp_npctype_data->charm_attack_delay     = atoi(row[103]) * 100; // TODO: fix DB
-		temp_npctype_data->charm_accuracy_rating  = atoi(row[104]);
-		temp_npctype_data->charm_avoidance_rating = atoi(row[105]);
-		temp_npctype_data->charm_atk              = atoi(row[106]);
-
-		temp_npctype_data->skip_global_loot 	= atoi(row[107]) != 0;
-		temp_npctype_data->rare_spawn       	= atoi(row[108]) != 0;
-		temp_npctype_data->stuck_behavior   	= atoi(row[109]);
-		temp_npctype_data->use_model        	= atoi(row[110]);
-		temp_npctype_data->flymode          	= atoi(row[111]);
-		temp_npctype_data->always_aggro	        = atoi(row[112]);
-		temp_npctype_data->exp_mod              = atoi(row[113]);
-
-		temp_npctype_data->skip_auto_scale = false; // hardcoded here for now
+		LoadNPCTypeRow(row, temp_npctype_data);
 
 		// If NPC with duplicate NPC id already in table,
 		// free item we attempted to add.
@@ -21,6 +21,7 @@ class Merc;
 class NPC;
 class Petition;
 class Spawn2;
+class Spawn2List;
 class SpawnGroupList;
 class Trap;
 struct Door;
@@ -415,9 +416,9 @@ public:
 	/* Spawns and Spawn Points  */
 	bool		LoadSpawnGroups(const char* zone_name, uint16 version, SpawnGroupList* spawn_group_list);
 	bool		LoadSpawnGroupsByID(int spawn_group_id, SpawnGroupList* spawn_group_list);
-	bool		PopulateZoneSpawnList(uint32 zoneid, LinkedList<Spawn2*> &spawn2_list, int16 version, uint32 repopdelay = 0);
-	bool		PopulateZoneSpawnListClose(uint32 zoneid, LinkedList<Spawn2*> &spawn2_list, int16 version, const glm::vec4& client_position, uint32 repop_distance);
-	Spawn2*		LoadSpawn2(LinkedList<Spawn2*> &spawn2_list, uint32 spawn2id, uint32 timeleft);
+	bool		PopulateZoneSpawnList(uint32 zoneid, Spawn2List &spawn2_list, int16 version, uint32 repopdelay = 0);
+	bool		PopulateZoneSpawnListClose(uint32 zoneid, Spawn2List &spawn2_list, int16 version, const glm::vec4& client_position, uint32 repop_distance);
+	Spawn2*		LoadSpawn2(Spawn2List &spawn2_list, uint32 spawn2id, uint32 timeleft);
 	bool		CreateSpawn2(Client *c, uint32 spawngroup, const char* zone, const glm::vec4& position, uint32 respawn, uint32 variance, uint16 condition, int16 cond_value);
 	void		UpdateRespawnTime(uint32 id, uint16 instance_id,uint32 timeleft);
 	uint32		GetSpawnTimeLeft(uint32 id, uint16 instance_id);
@@ -423,6 +423,7 @@ void Client::DoZoneSuccess(ZoneChange_Struct *zc, uint16 zone_id, uint32 instanc
 	m_Position.y = dest_y;
 	m_Position.z = dest_z;
 	m_Position.w = dest_h; // Cripp: fix for zone heading
+	UpdatePositionTable();
 	m_pp.heading = dest_h;
 	m_pp.zone_id = zone_id;
 	m_pp.zoneInstance = instance_id;
@@ -708,6 +709,8 @@ void Client::ZonePC(uint32 zoneID, uint32 instance_id, float x, float y, float z
 			break;
 	}
 
+	UpdatePositionTable();
+
 	if (ReadyToZone)
 	{
 		//if client is looting, we need to send an end loot